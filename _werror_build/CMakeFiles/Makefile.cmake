@@ -0,0 +1,92 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/lib/x86_64-linux-gnu/cmake/fmt/fmt-config-version.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfig.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfigVersion.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets-release.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-config-version.cmake"
+  "/root/miniconda/share/cmake/nlohmann_json/nlohmann_jsonConfigVersion.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake.external/CLI11/FindCLI11.cmake"
+  "/root/repo/cmake.external/fmt/JoinPaths.cmake"
+  "/root/repo/cmake.external/nlohmann_json/Findnlohmann_json.cmake"
+  "/root/repo/cmake.external/zeus_expected/Findzeus_expected.cmake"
+  "/root/repo/external/CLI11/CMakeLists.txt"
+  "/root/repo/external/fmt/CMakeLists.txt"
+  "/root/repo/external/nlohmann_json/CMakeLists.txt"
+  "/root/repo/external/zeus_expected/CMakeLists.txt"
+  "/root/repo/src/linyaps_box/version.h.in"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tests/ll-box-st/CMakeLists.txt"
+  "/root/repo/tests/ll-box-ut/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/fmt/fmt-config-version.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "src/linyaps_box/version.h"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "external/nlohmann_json/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "external/CLI11/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "external/fmt/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "external/zeus_expected/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/ll-box-ut/ll-box-ut[1]_include.cmake"
+  "tests/ll-box-ut/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/ll-box-st/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/linyaps-box.dir/DependInfo.cmake"
+  "CMakeFiles/ll-box.dir/DependInfo.cmake"
+  "external/fmt/CMakeFiles/fmt.dir/DependInfo.cmake"
+  "external/fmt/CMakeFiles/fmt-c.dir/DependInfo.cmake"
+  "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/DependInfo.cmake"
+  )
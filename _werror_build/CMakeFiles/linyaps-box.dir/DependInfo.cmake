@@ -0,0 +1,96 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/linyaps_box/app.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/app.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/app.cpp.o.d"
+  "/root/repo/src/linyaps_box/cgroup_manager.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_manager.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_manager.cpp.o.d"
+  "/root/repo/src/linyaps_box/cgroup_stats.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_stats.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_stats.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/claim.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/claim.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/claim.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/create.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/create.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/create.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/events.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/events.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/events.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/exec.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/exec.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/exec.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/kill.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/kill.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/kill.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/list.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/list.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/list.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/options.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/options.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/options.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/pause.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pause.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pause.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/pool.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pool.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pool.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/resume.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/resume.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/resume.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/run.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/run.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/run.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/start.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/start.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/start.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/stats.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/stats.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/stats.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/supervisor.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/supervisor.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/supervisor.cpp.o.d"
+  "/root/repo/src/linyaps_box/command/update.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/update.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/update.cpp.o.d"
+  "/root/repo/src/linyaps_box/config.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config.cpp.o.d"
+  "/root/repo/src/linyaps_box/config/cache.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/cache.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/cache.cpp.o.d"
+  "/root/repo/src/linyaps_box/config/parser.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/parser.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/parser.cpp.o.d"
+  "/root/repo/src/linyaps_box/config/validate.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/validate.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/validate.cpp.o.d"
+  "/root/repo/src/linyaps_box/container.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container.cpp.o.d"
+  "/root/repo/src/linyaps_box/container_monitor.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_monitor.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_monitor.cpp.o.d"
+  "/root/repo/src/linyaps_box/container_ref.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_ref.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_ref.cpp.o.d"
+  "/root/repo/src/linyaps_box/container_status.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_status.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_status.cpp.o.d"
+  "/root/repo/src/linyaps_box/impl/cgroupfs_manager.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/cgroupfs_manager.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/cgroupfs_manager.cpp.o.d"
+  "/root/repo/src/linyaps_box/impl/disabled_cgroup_manager.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/disabled_cgroup_manager.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/disabled_cgroup_manager.cpp.o.d"
+  "/root/repo/src/linyaps_box/infra/rootfs.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/rootfs.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/rootfs.cpp.o.d"
+  "/root/repo/src/linyaps_box/infra/unix_socket.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/unix_socket.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/unix_socket.cpp.o.d"
+  "/root/repo/src/linyaps_box/interface.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/interface.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/interface.cpp.o.d"
+  "/root/repo/src/linyaps_box/io/epoll.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/epoll.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/epoll.cpp.o.d"
+  "/root/repo/src/linyaps_box/io/forwarder.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/forwarder.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/forwarder.cpp.o.d"
+  "/root/repo/src/linyaps_box/io/stream.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/stream.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/stream.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/formatter.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/formatter.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/formatter.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/logger.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/logger.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/logger.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/sink_factory.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sink_factory.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sink_factory.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/sinks/file_sink.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/file_sink.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/file_sink.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/sinks/stderr_sink.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/stderr_sink.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/stderr_sink.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/sinks/syslog_sink.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/syslog_sink.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/syslog_sink.cpp.o.d"
+  "/root/repo/src/linyaps_box/log/utils.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/utils.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/utils.cpp.o.d"
+  "/root/repo/src/linyaps_box/memory_reclaim.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/memory_reclaim.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/memory_reclaim.cpp.o.d"
+  "/root/repo/src/linyaps_box/os/fs.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/fs.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/fs.cpp.o.d"
+  "/root/repo/src/linyaps_box/os/io.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/io.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/io.cpp.o.d"
+  "/root/repo/src/linyaps_box/os/mount.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/mount.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/mount.cpp.o.d"
+  "/root/repo/src/linyaps_box/os/net.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/net.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/net.cpp.o.d"
+  "/root/repo/src/linyaps_box/os/process.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/process.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/process.cpp.o.d"
+  "/root/repo/src/linyaps_box/os/tty.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/tty.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/tty.cpp.o.d"
+  "/root/repo/src/linyaps_box/protocol/message.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message.cpp.o.d"
+  "/root/repo/src/linyaps_box/protocol/message_channel.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message_channel.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message_channel.cpp.o.d"
+  "/root/repo/src/linyaps_box/protocol/sync_socket_forwarder.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/sync_socket_forwarder.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/sync_socket_forwarder.cpp.o.d"
+  "/root/repo/src/linyaps_box/runtime.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/runtime.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/runtime.cpp.o.d"
+  "/root/repo/src/linyaps_box/security/privilege.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/privilege.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/privilege.cpp.o.d"
+  "/root/repo/src/linyaps_box/security/seccomp.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/seccomp.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/seccomp.cpp.o.d"
+  "/root/repo/src/linyaps_box/status_directory.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory.cpp.o.d"
+  "/root/repo/src/linyaps_box/status_directory_manager.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory_manager.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory_manager.cpp.o.d"
+  "/root/repo/src/linyaps_box/supervisor.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/supervisor.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/supervisor.cpp.o.d"
+  "/root/repo/src/linyaps_box/terminal.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/terminal.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/terminal.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/cgroups.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/cgroups.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/cgroups.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/close_range.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/close_range.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/close_range.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/epoll.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/epoll.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/epoll.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/file_describer.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/file_describer.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/file_describer.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/idmap.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/idmap.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/idmap.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/mempolicy.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mempolicy.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mempolicy.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/mman.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mman.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mman.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/platform.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/platform.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/platform.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/process_stat.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/process_stat.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/process_stat.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/ringbuffer.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/ringbuffer.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/ringbuffer.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/rusage.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/rusage.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/rusage.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/sched.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/sched.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/sched.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/semver.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/semver.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/semver.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/session.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/session.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/session.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/setns.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/setns.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/setns.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/signal.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/signal.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/signal.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/terminal.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/terminal.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/terminal.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/time.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/time.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/time.cpp.o.d"
+  "/root/repo/src/linyaps_box/utils/timing.cpp" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/timing.cpp.o" "gcc" "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/timing.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_werror_build/external/fmt/CMakeFiles/fmt.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,163 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/app.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/app.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_manager.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_manager.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_stats.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/cgroup_stats.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/claim.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/claim.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/create.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/create.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/events.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/events.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/exec.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/exec.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/kill.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/kill.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/list.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/list.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/options.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/options.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pause.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pause.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pool.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/pool.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/resume.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/resume.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/run.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/run.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/start.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/start.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/stats.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/stats.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/supervisor.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/supervisor.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/update.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/command/update.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/cache.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/cache.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/parser.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/parser.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/validate.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/config/validate.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_monitor.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_monitor.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_ref.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_ref.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_status.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/container_status.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/cgroupfs_manager.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/cgroupfs_manager.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/disabled_cgroup_manager.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/impl/disabled_cgroup_manager.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/rootfs.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/rootfs.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/unix_socket.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/infra/unix_socket.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/interface.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/interface.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/epoll.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/epoll.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/forwarder.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/forwarder.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/stream.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/io/stream.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/formatter.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/formatter.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/logger.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/logger.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sink_factory.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sink_factory.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/file_sink.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/file_sink.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/stderr_sink.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/stderr_sink.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/syslog_sink.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/sinks/syslog_sink.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/utils.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/log/utils.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/memory_reclaim.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/memory_reclaim.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/fs.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/fs.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/io.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/io.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/mount.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/mount.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/net.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/net.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/process.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/process.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/tty.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/os/tty.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message_channel.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/message_channel.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/sync_socket_forwarder.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/protocol/sync_socket_forwarder.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/runtime.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/runtime.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/privilege.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/privilege.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/seccomp.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/security/seccomp.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory_manager.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/status_directory_manager.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/supervisor.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/supervisor.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/terminal.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/terminal.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/cgroups.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/cgroups.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/close_range.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/close_range.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/epoll.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/epoll.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/file_describer.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/file_describer.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/idmap.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/idmap.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mempolicy.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mempolicy.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mman.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/mman.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/platform.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/platform.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/process_stat.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/process_stat.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/ringbuffer.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/ringbuffer.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/rusage.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/rusage.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/sched.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/sched.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/semver.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/semver.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/session.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/session.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/setns.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/setns.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/signal.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/signal.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/terminal.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/terminal.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/time.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/time.cpp.o.d"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/timing.cpp.o"
+  "CMakeFiles/linyaps-box.dir/src/linyaps_box/utils/timing.cpp.o.d"
+  "liblinyaps-box.a"
+  "liblinyaps-box.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/linyaps-box.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
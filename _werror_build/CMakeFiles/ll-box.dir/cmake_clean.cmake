@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ll-box.dir/app/ll-box/src/main.cpp.o"
+  "CMakeFiles/ll-box.dir/app/ll-box/src/main.cpp.o.d"
+  "ll-box"
+  "ll-box.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ll-box.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
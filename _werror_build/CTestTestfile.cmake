@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_werror_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("external/nlohmann_json")
+subdirs("external/CLI11")
+subdirs("external/fmt")
+subdirs("external/zeus_expected")
+subdirs("tests")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fmt-c.dir/src/fmt-c.cc.o"
+  "CMakeFiles/fmt-c.dir/src/fmt-c.cc.o.d"
+  "libfmt-c.a"
+  "libfmt-c.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fmt-c.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fmt.dir/src/format.cc.o"
+  "CMakeFiles/fmt.dir/src/format.cc.o.d"
+  "CMakeFiles/fmt.dir/src/os.cc.o"
+  "CMakeFiles/fmt.dir/src/os.cc.o.d"
+  "libfmtd.a"
+  "libfmtd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fmt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#define LINYAPS_BOX_VERSION "2.3.0-dev-d6f17ea"
@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/ll-box-ut/src/cgroup_stats_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/cgroup_stats_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/cgroup_stats_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/cgroupfs_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/cgroupfs_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/cgroupfs_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/config_cache_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/config_cache_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/config_cache_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/container_status_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/container_status_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/container_status_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/control_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/control_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/control_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/idmap_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/idmap_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/idmap_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/log_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/log_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/log_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/main.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/main.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/main.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/memory_reclaim_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/memory_reclaim_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/memory_reclaim_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/mempolicy_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/mempolicy_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/mempolicy_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/message_channel_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/message_channel_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/message_channel_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/oci_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/oci_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/oci_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/rusage_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/rusage_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/rusage_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/sched_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/sched_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/sched_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/seccomp_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/seccomp_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/seccomp_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/semver_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/semver_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/semver_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/span_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/span_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/span_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/start_request_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/start_request_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/start_request_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/supervisor_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/supervisor_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/supervisor_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/timing_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/timing_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/timing_test.cpp.o.d"
+  "/root/repo/tests/ll-box-ut/src/vfs_test.cpp" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/vfs_test.cpp.o" "gcc" "tests/ll-box-ut/CMakeFiles/ll-box-ut.dir/src/vfs_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_werror_build/CMakeFiles/linyaps-box.dir/DependInfo.cmake"
+  "/root/repo/_werror_build/external/fmt/CMakeFiles/fmt.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
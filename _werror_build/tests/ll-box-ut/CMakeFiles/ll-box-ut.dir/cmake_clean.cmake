@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ll-box-ut.dir/src/cgroup_stats_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/cgroup_stats_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/cgroupfs_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/cgroupfs_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/config_cache_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/config_cache_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/container_status_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/container_status_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/control_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/control_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/idmap_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/idmap_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/log_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/log_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/main.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/main.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/memory_reclaim_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/memory_reclaim_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/mempolicy_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/mempolicy_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/message_channel_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/message_channel_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/oci_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/oci_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/rusage_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/rusage_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/sched_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/sched_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/seccomp_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/seccomp_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/semver_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/semver_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/span_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/span_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/start_request_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/start_request_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/supervisor_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/supervisor_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/timing_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/timing_test.cpp.o.d"
+  "CMakeFiles/ll-box-ut.dir/src/vfs_test.cpp.o"
+  "CMakeFiles/ll-box-ut.dir/src/vfs_test.cpp.o.d"
+  "ll-box-ut"
+  "ll-box-ut.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ll-box-ut.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
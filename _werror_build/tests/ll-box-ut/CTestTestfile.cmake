@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/ll-box-ut
+# Build directory: /root/repo/_werror_build/tests/ll-box-ut
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut[1]_include.cmake")
@@ -0,0 +1,26 @@
+if(EXISTS "/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut")
+  if(NOT EXISTS "/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut[1]_tests.cmake" OR
+     NOT "/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut[1]_tests.cmake" IS_NEWER_THAN "/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut" OR
+     NOT "/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut[1]_tests.cmake" IS_NEWER_THAN "${CMAKE_CURRENT_LIST_FILE}")
+    include("/usr/share/cmake-3.25/Modules/GoogleTestAddTests.cmake")
+    gtest_discover_tests_impl(
+      TEST_EXECUTABLE [==[/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut]==]
+      TEST_EXECUTOR [==[]==]
+      TEST_WORKING_DIR [==[/root/repo/_werror_build/tests/ll-box-ut]==]
+      TEST_EXTRA_ARGS [==[]==]
+      TEST_PROPERTIES [==[LABELS;unit;ENVIRONMENT]==]
+      TEST_PREFIX [==[]==]
+      TEST_SUFFIX [==[]==]
+      TEST_FILTER [==[]==]
+      NO_PRETTY_TYPES [==[FALSE]==]
+      NO_PRETTY_VALUES [==[FALSE]==]
+      TEST_LIST [==[ll-box-ut_TESTS]==]
+      CTEST_FILE [==[/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut[1]_tests.cmake]==]
+      TEST_DISCOVERY_TIMEOUT [==[5]==]
+      TEST_XML_OUTPUT_DIR [==[]==]
+    )
+  endif()
+  include("/root/repo/_werror_build/tests/ll-box-ut/ll-box-ut[1]_tests.cmake")
+else()
+  add_test(ll-box-ut_NOT_BUILT ll-box-ut_NOT_BUILT)
+endif()
@@ -4,13 +4,25 @@
 
 #include "linyaps_box/app.h"
 
+#include "linyaps_box/command/claim.h"
+#include "linyaps_box/command/create.h"
+#include "linyaps_box/command/events.h"
 #include "linyaps_box/command/exec.h"
 #include "linyaps_box/command/kill.h"
 #include "linyaps_box/command/list.h"
+#include "linyaps_box/command/pause.h"
+#include "linyaps_box/command/pool.h"
+#include "linyaps_box/command/resume.h"
 #include "linyaps_box/command/run.h"
+#include "linyaps_box/command/start.h"
+#include "linyaps_box/command/stats.h"
+#include "linyaps_box/command/supervisor.h"
+#include "linyaps_box/command/update.h"
 #include "linyaps_box/log/logger.h"
 #include "linyaps_box/log/macro.h"
 #include "linyaps_box/log/sink_factory.h"
+#include "linyaps_box/utils/defer.h"
+#include "linyaps_box/utils/timing.h"
 #include "linyaps_box/utils/utils.h"
 
 #include <iostream>
@@ -72,6 +84,23 @@ auto main(int argc, char **argv) noexcept -> int
         return EXIT_FAILURE;
     }
 
+    if (opts.global.trace_file) {
+        utils::phase_recorder::instance().enable();
+    }
+
+    // the trace is most useful when something went wrong, so write it on every path
+    auto write_trace = utils::make_defer([&opts]() noexcept {
+        if (!opts.global.trace_file) {
+            return;
+        }
+
+        try {
+            utils::write_trace_events(*opts.global.trace_file, utils::phase_recorder::instance());
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_WARN("failed to write trace file: {}", e.what());
+        }
+    });
+
     try {
         return std::visit(utils::Overload{ [&opts](const command::list_options &list) -> int {
                                               return command::list(list, opts.global);
@@ -85,6 +114,37 @@ auto main(int argc, char **argv) noexcept -> int
                                            [&opts](const command::run_options &run) -> int {
                                                return command::run(run, opts.global);
                                            },
+                                           [&opts](const command::create_options &create) -> int {
+                                               return command::create(create, opts.global);
+                                           },
+                                           [&opts](const command::start_options &start) -> int {
+                                               return command::start(start, opts.global);
+                                           },
+                                           [&opts](const command::pool_options &pool) -> int {
+                                               return command::pool(pool, opts.global);
+                                           },
+                                           [&opts](const command::claim_options &claim) -> int {
+                                               return command::claim(claim, opts.global);
+                                           },
+                                           [&opts](const command::pause_options &pause) -> int {
+                                               return command::pause(pause, opts.global);
+                                           },
+                                           [&opts](const command::resume_options &resume) -> int {
+                                               return command::resume(resume, opts.global);
+                                           },
+                                           [&opts](const command::update_options &update) -> int {
+                                               return command::update(update, opts.global);
+                                           },
+                                           [&opts](const command::stats_options &stats) -> int {
+                                               return command::stats(stats, opts.global);
+                                           },
+                                           [&opts](const command::events_options &events) -> int {
+                                               return command::events(events, opts.global);
+                                           },
+                                           [&opts](const command::supervisor_options &supervisor)
+                                             -> int {
+                                               return command::supervisor(supervisor, opts.global);
+                                           },
                                            [](const std::monostate &) -> int {
                                                // just for exhausting variant
                                                return EXIT_SUCCESS;
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include "linyaps_box/config.h"
+
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -19,7 +22,7 @@ struct cgroup_options
     std::filesystem::path state_root;
     std::string id;
     pid_t pid;
-    // resources and so on...
+    std::optional<oci_config::linux_t::resources_t> resources;
 };
 
 struct cgroup_status
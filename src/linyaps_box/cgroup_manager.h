@@ -25,17 +25,27 @@ public:
 
     virtual auto create_cgroup(const cgroup_options &options) -> cgroup_status = 0;
 
-    virtual void precreate_cgroup(const cgroup_options &options, utils::file_descriptor &dirfd) = 0;
+    // Create the cgroup before the container process exists. dirfd is set to the
+    // cgroup directory, ready for clone3(2) with CLONE_INTO_CGROUP, if there is one.
+    virtual auto precreate_cgroup(const cgroup_options &options, utils::file_descriptor &dirfd)
+      -> cgroup_status = 0;
 
     virtual void destroy_cgroup(const cgroup_status &status) = 0;
 
-    // TODO: support update resource
-    // virtual void update_resource(const cgroup_status &status, ) = 0;
+    // Apply the settings present in resources, everything else is left untouched.
+    virtual void update_resource(const cgroup_status &status,
+                                 const oci_config::linux_t::resources_t &resources) = 0;
+
 protected:
     static void set_manager(cgroup_status &status, cgroup_manager_t type) noexcept
     {
         status.manager_ = type;
     }
+
+    static void set_path(cgroup_status &status, std::filesystem::path path) noexcept
+    {
+        status.path_ = std::move(path);
+    }
 };
 
 } // namespace linyaps_box
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/cgroup_stats.h"
+
+#include "linyaps_box/os/fs.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <system_error>
+
+#include <unistd.h>
+
+namespace linyaps_box {
+
+namespace {
+
+// cgroup values are integers, except the pressure averages
+auto to_number(std::string_view value) -> nlohmann::json
+{
+    std::uint64_t integer{ };
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), integer);
+    if (ec == std::errc{ } && ptr == value.data() + value.size()) {
+        return integer;
+    }
+
+    const std::string str{ value };
+    char *end{ nullptr };
+    const auto real = std::strtod(str.c_str(), &end);
+    if (end == str.c_str() + str.size()) {
+        return real;
+    }
+
+    return str;
+}
+
+template <typename Fn>
+void for_each_token(std::string_view line, Fn &&fn)
+{
+    while (!line.empty()) {
+        const auto begin = line.find_first_not_of(' ');
+        if (begin == std::string_view::npos) {
+            return;
+        }
+
+        line.remove_prefix(begin);
+        const auto end = std::min(line.find(' '), line.size());
+        fn(line.substr(0, end));
+        line.remove_prefix(end);
+    }
+}
+
+template <typename Fn>
+void for_each_line(std::string_view content, Fn &&fn)
+{
+    while (!content.empty()) {
+        const auto end = std::min(content.find('\n'), content.size());
+        if (end != 0) {
+            fn(content.substr(0, end));
+        }
+        content.remove_prefix(std::min(end + 1, content.size()));
+    }
+}
+
+void pread_all(const utils::file_descriptor &fd, std::string &buffer)
+{
+    constexpr std::size_t chunk = 4096;
+    std::size_t size{ 0 };
+    while (true) {
+        buffer.resize(size + chunk);
+        const auto n = ::pread(fd.get(), buffer.data() + size, chunk, static_cast<off_t>(size));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw std::system_error(errno, std::system_category(), "pread");
+        }
+
+        if (n == 0) {
+            break;
+        }
+
+        size += static_cast<std::size_t>(n);
+    }
+
+    buffer.resize(size);
+}
+
+} // namespace
+
+auto parse_flat_keyed(std::string_view content) -> nlohmann::json
+{
+    auto ret = nlohmann::json::object();
+    for_each_line(content, [&ret](std::string_view line) {
+        const auto sep = line.find(' ');
+        if (sep == std::string_view::npos) {
+            return;
+        }
+
+        ret[std::string{ line.substr(0, sep) }] = to_number(line.substr(sep + 1));
+    });
+
+    return ret;
+}
+
+auto parse_nested_keyed(std::string_view content) -> nlohmann::json
+{
+    auto ret = nlohmann::json::object();
+    for_each_line(content, [&ret](std::string_view line) {
+        nlohmann::json *entry{ nullptr };
+        for_each_token(line, [&ret, &entry](std::string_view token) {
+            if (entry == nullptr) {
+                entry = &(ret[std::string{ token }] = nlohmann::json::object());
+                return;
+            }
+
+            const auto eq = token.find('=');
+            if (eq == std::string_view::npos) {
+                return;
+            }
+
+            (*entry)[std::string{ token.substr(0, eq) }] = to_number(token.substr(eq + 1));
+        });
+    });
+
+    return ret;
+}
+
+cgroup_sampler::cgroup_sampler(const std::filesystem::path &cgroup)
+{
+    static constexpr std::tuple<const char *, std::string_view, format> known_files[] = {
+        { "cpu.stat", "/cpu", format::flat_keyed },
+        { "memory.current", "/memory/current", format::single_value },
+        { "memory.stat", "/memory/stat", format::flat_keyed },
+        { "io.stat", "/io", format::nested_keyed },
+        { "pids.current", "/pids/current", format::single_value },
+        { "cpu.pressure", "/pressure/cpu", format::nested_keyed },
+        { "memory.pressure", "/pressure/memory", format::nested_keyed },
+        { "io.pressure", "/pressure/io", format::nested_keyed },
+    };
+
+    auto dirfd = os::throw_if_error(
+      os::open(cgroup,
+               { os::sys::open_flag::cloexec | os::sys::open_flag::directory,
+                 os::sys::access_mode::read_only }),
+      "open " + cgroup.string());
+
+    for (const auto &[name, pointer, fmt] : known_files) {
+        auto fd = os::openat(dirfd,
+                             name,
+                             { os::sys::open_flag::cloexec, os::sys::access_mode::read_only });
+        if (!fd) {
+            continue;
+        }
+
+        files.push_back({ pointer, fmt, std::move(fd).value() });
+    }
+}
+
+auto cgroup_sampler::sample() -> nlohmann::json
+{
+    auto ret = nlohmann::json::object();
+    for (const auto &file : files) {
+        pread_all(file.fd, buffer);
+
+        const nlohmann::json::json_pointer pointer{ std::string{ file.pointer } };
+        switch (file.fmt) {
+        case format::single_value: {
+            std::string_view value{ buffer };
+            while (!value.empty() && value.back() == '\n') {
+                value.remove_suffix(1);
+            }
+            ret[pointer] = to_number(value);
+        } break;
+        case format::flat_keyed: {
+            ret[pointer] = parse_flat_keyed(buffer);
+        } break;
+        case format::nested_keyed: {
+            ret[pointer] = parse_nested_keyed(buffer);
+        } break;
+        }
+    }
+
+    return ret;
+}
+
+} // namespace linyaps_box
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/utils/file_describer.h"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linyaps_box {
+
+// "key value" lines, as in cpu.stat and memory.stat.
+[[nodiscard]] auto parse_flat_keyed(std::string_view content) -> nlohmann::json;
+
+// "name key=value key=value" lines, as in io.stat and the *.pressure files.
+[[nodiscard]] auto parse_nested_keyed(std::string_view content) -> nlohmann::json;
+
+// Samples the statistics of one cgroup v2 directory. The files are opened once and
+// re-read from offset 0 with pread(2) on every sample; files missing at creation,
+// e.g. of a controller that is not enabled, are left out of the result.
+class cgroup_sampler
+{
+public:
+    explicit cgroup_sampler(const std::filesystem::path &cgroup);
+
+    // Throws std::system_error once the cgroup is gone.
+    [[nodiscard]] auto sample() -> nlohmann::json;
+
+private:
+    enum class format : std::uint8_t { single_value, flat_keyed, nested_keyed };
+
+    struct stat_file
+    {
+        std::string_view pointer;
+        format fmt;
+        utils::file_descriptor fd;
+    };
+
+    std::vector<stat_file> files;
+    std::string buffer;
+};
+
+} // namespace linyaps_box
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/claim.h"
+
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/runtime.h"
+#include "linyaps_box/status_directory_manager.h"
+
+auto linyaps_box::command::claim(const claim_options &options, const global_options &global)
+  -> int
+{
+    start_container_option start_option;
+    start_option.args = options.args;
+    if (!options.envs.empty()) {
+        start_option.env = options.envs;
+    }
+    start_option.cwd = options.cwd;
+
+    status_directory_manager mgr(global.root);
+    runtime_t runtime(std::move(mgr));
+    auto containers = runtime.containers();
+
+    // Another claim or the idle TTL may take a member first, try the next one then.
+    for (const auto &status : runtime.idle_pool_members(options.pool)) {
+        auto it = containers.find(status.id);
+        if (it == containers.end()) {
+            continue;
+        }
+
+        try {
+            it->second.start(start_option);
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_DEBUG("Pool member {} is gone: {}", status.id, e.what());
+            continue;
+        }
+
+        fmt::println("{}", status.id);
+        return 0;
+    }
+
+    throw std::runtime_error(fmt::format("no idle container in pool {}", options.pool));
+}
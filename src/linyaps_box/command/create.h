@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/command/options.h"
+
+namespace linyaps_box::command {
+
+[[nodiscard]] auto create(const create_options &options, const global_options &global) -> int;
+
+} // namespace linyaps_box::command
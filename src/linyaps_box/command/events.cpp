@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/events.h"
+
+#include "linyaps_box/cgroup_stats.h"
+#include "linyaps_box/command/stats.h"
+#include "linyaps_box/io/epoll.h"
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/status_directory_manager.h"
+#include "linyaps_box/utils/time.h"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace linyaps_box::command {
+
+namespace {
+
+using samplers_t = std::map<std::string, cgroup_sampler>;
+
+// Only new containers are opened, the files of known ones stay open across ticks.
+void add_samplers(samplers_t &samplers,
+                  const std::vector<std::pair<std::string, std::filesystem::path>> &cgroups)
+{
+    for (const auto &[id, cgroup] : cgroups) {
+        if (samplers.find(id) != samplers.end()) {
+            continue;
+        }
+
+        try {
+            samplers.emplace(id, cgroup_sampler{ cgroup });
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_DEBUG("skip container {}: {}", id, e.what());
+        }
+    }
+}
+
+// Reports the containers whose status.json shows up under the state root, so
+// following all containers costs nothing per tick. A status directory is created
+// before status.json is renamed into it, each new directory is watched until then.
+class container_watch
+{
+public:
+    explicit container_watch(std::filesystem::path root)
+        : root(std::move(root))
+    {
+        auto ret = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (ret < 0) {
+            throw std::system_error(errno, std::system_category(), "inotify_init1");
+        }
+
+        notify_fd = utils::file_descriptor{ ret };
+        root_wd = ::inotify_add_watch(notify_fd.get(),
+                                      this->root.c_str(),
+                                      IN_CREATE | IN_MOVED_TO | IN_ONLYDIR);
+        if (root_wd < 0) {
+            throw std::system_error(errno, std::system_category(), "watch " + this->root.string());
+        }
+
+        // directories created before the watch, still waiting for their status
+        for (const auto &entry : std::filesystem::directory_iterator(this->root)) {
+            if (entry.is_directory()) {
+                std::ignore = watch_directory(entry.path().filename().string());
+            }
+        }
+    }
+
+    [[nodiscard]] auto fd() const -> const utils::file_descriptor & { return notify_fd; }
+
+    // IDs of the containers whose status appeared since the last call.
+    auto read() -> std::vector<std::string>
+    {
+        std::vector<std::string> ids;
+        alignas(struct inotify_event) std::array<char, 4096> buf{ };
+        while (true) {
+            auto len = ::read(notify_fd.get(), buf.data(), buf.size());
+            if (len <= 0) {
+                break;
+            }
+
+            for (auto offset = 0; offset < len;) {
+                const auto *event = reinterpret_cast<const struct inotify_event *>(&buf[offset]);
+                offset += static_cast<int>(sizeof(struct inotify_event) + event->len);
+                handle(*event, ids);
+            }
+        }
+
+        return ids;
+    }
+
+private:
+    auto handle(const struct inotify_event &event, std::vector<std::string> &ids) -> void
+    {
+        const std::string name = event.len != 0 ? event.name : "";
+        if (event.wd == root_wd) {
+            if ((event.mask & IN_ISDIR) != 0 && watch_directory(name)) {
+                ids.push_back(name);
+            }
+
+            return;
+        }
+
+        auto it = pending.find(event.wd);
+        if (it == pending.end()) {
+            return;
+        }
+
+        // the directory was removed before its status showed up
+        if ((event.mask & IN_IGNORED) != 0) {
+            pending.erase(it);
+            return;
+        }
+
+        if (name == "status.json") {
+            ids.push_back(it->second);
+            ::inotify_rm_watch(notify_fd.get(), event.wd);
+            pending.erase(it);
+        }
+    }
+
+    // true if the status is there already and the directory needs no watch
+    auto watch_directory(const std::string &id) -> bool
+    {
+        // IDs cannot start with '.', e.g. the shared config cache
+        if (id.empty() || id.front() == '.') {
+            return false;
+        }
+
+        const auto dir = root / id;
+        auto wd = ::inotify_add_watch(notify_fd.get(), dir.c_str(), IN_CREATE | IN_MOVED_TO);
+        if (wd >= 0) {
+            pending[wd] = id;
+        }
+
+        std::error_code ec;
+        if (!std::filesystem::exists(dir / "status.json", ec)) {
+            return false;
+        }
+
+        if (wd >= 0) {
+            ::inotify_rm_watch(notify_fd.get(), wd);
+            pending.erase(wd);
+        }
+
+        return true;
+    }
+
+    std::filesystem::path root;
+    utils::file_descriptor notify_fd;
+    int root_wd{ -1 };
+    // watched status directories without a status.json yet
+    std::unordered_map<int, std::string> pending;
+};
+
+// Containers without a cgroup and ones gone again are skipped.
+auto new_cgroups(const global_options &global, const std::vector<std::string> &ids)
+  -> std::vector<std::pair<std::string, std::filesystem::path>>
+{
+    status_directory_manager mgr(global.root);
+    std::vector<std::pair<std::string, std::filesystem::path>> ret;
+    for (const auto &id : ids) {
+        try {
+            auto dir = mgr.find(id);
+            if (!dir) {
+                continue;
+            }
+
+            auto status = dir->read();
+            if (!status.cgroup_path.empty()) {
+                ret.emplace_back(id, std::move(status.cgroup_path));
+            }
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_DEBUG("skip container {}: {}", id, e.what());
+        }
+    }
+
+    return ret;
+}
+
+void emit_samples(samplers_t &samplers)
+{
+    for (auto it = samplers.begin(); it != samplers.end();) {
+        nlohmann::json data;
+        try {
+            data = it->second.sample();
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_DEBUG("container {} is gone: {}", it->first, e.what());
+            it = samplers.erase(it);
+            continue;
+        }
+
+        const nlohmann::json event{ { "type", "stats" }, { "id", it->first }, { "data", data } };
+        fmt::println("{}", event.dump());
+        ++it;
+    }
+
+    std::fflush(stdout);
+}
+
+} // namespace
+
+auto events(const events_options &options, const global_options &global) -> int
+{
+    // One timer drives the sampling of every container, so the cost of a tick is a
+    // pread per statistics file and not a process or an open(2) per container.
+    auto timer = utils::create_timerfd(std::chrono::milliseconds{ options.interval_ms });
+    io::Epoll epoll;
+    if (!epoll.add(timer, EPOLLIN)) {
+        throw std::runtime_error("failed to add timerfd to epoll");
+    }
+
+    // Watch before the first scan, so no container is missed in between.
+    std::optional<container_watch> watch;
+    if (options.containers.empty()) {
+        watch.emplace(global.root);
+        if (!epoll.add(watch->fd(), EPOLLIN)) {
+            throw std::runtime_error("failed to add inotify fd to epoll");
+        }
+    }
+
+    samplers_t samplers;
+    add_samplers(samplers, container_cgroups(global, options.containers));
+
+    auto tick{ true };
+    while (true) {
+        if (tick) {
+            emit_samples(samplers);
+            tick = false;
+        }
+
+        if (!watch && samplers.empty()) {
+            return 0;
+        }
+
+        for (const auto &event : epoll.wait(-1)) {
+            if (event.data.fd == timer.get()) {
+                std::uint64_t expirations{ 0 };
+                std::ignore = timer.read(expirations);
+                tick = true;
+                continue;
+            }
+
+            add_samplers(samplers, new_cgroups(global, watch->read()));
+        }
+    }
+}
+
+} // namespace linyaps_box::command
@@ -18,9 +18,8 @@ try {
     status_directory_manager mgr(global.root);
     runtime_t runtime(std::move(mgr));
 
-    const auto &container_refs = runtime.containers();
-    auto container = container_refs.find(options.ID);
-    if (UNLIKELY(container == container_refs.cend())) {
+    auto container = runtime.find_container(options.ID);
+    if (UNLIKELY(!container)) {
         throw std::runtime_error("container not found");
     }
 
@@ -63,7 +62,7 @@ try {
     option.caps = std::move(options.caps);
 #endif
 
-    return container->second.exec(std::move(option));
+    return container->exec(std::move(option));
 } catch (const std::exception &e) {
     LINYAPS_BOX_LOG_ERROR("failed to exec: {}", e.what());
     return EXIT_FAILURE;
@@ -11,15 +11,11 @@ auto linyaps_box::command::kill(const kill_options &options, const global_option
 {
     status_directory_manager mgr(global.root);
     runtime_t runtime(std::move(mgr));
-    const auto &containers = runtime.containers();
-    for (const auto &[id, ref] : containers) {
-        if (id != options.container) {
-            continue;
-        }
-
-        ref.kill(options.signal);
-        return 0;
+    auto container = runtime.find_container(options.container);
+    if (!container) {
+        throw std::runtime_error("container not found");
     }
 
-    throw std::runtime_error("container not found");
+    container->kill(options.signal);
+    return 0;
 }
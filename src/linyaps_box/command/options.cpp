@@ -14,6 +14,7 @@
 #include <array>
 #include <charconv>
 #include <csignal>
+#include <map>
 
 #include <unistd.h>
 
@@ -147,6 +148,11 @@ auto register_global(CLI::App &app, linyaps_box::command::global_options &opts)
     app.add_flag("--cee-syslog",
                  opts.cee_syslog,
                  "Prefix syslog messages with @cee: when --log-format=json");
+
+    app.add_option("--trace-file",
+                   opts.trace_file,
+                   "Write a Chrome trace-event timeline of the runtime to FILE")
+      ->type_name("FILE");
 }
 
 auto register_list(CLI::App &app, linyaps_box::command::list_options &opts) -> CLI::App *
@@ -175,6 +181,94 @@ auto register_run(CLI::App &app, linyaps_box::command::run_options &opts) -> CLI
       ->default_val("config.json");
     add_preserve_fds(cmd, opts.preserve_fds);
     add_console_socket(cmd, opts.console_socket);
+    cmd->add_option("--startup-timing",
+                    opts.startup_timing,
+                    "Write a per-phase startup timing breakdown as JSON to FILE")
+      ->type_name("FILE");
+    cmd->add_option("--usage-report",
+                    opts.usage_report,
+                    "Write the resource usage of the container as JSON to FILE when it exits")
+      ->type_name("FILE");
+    cmd->add_flag("-d,--detach",
+                  opts.detach,
+                  "Return once the container started, a small monitor waits for its exit");
+    cmd->add_option("--supervisor",
+                    opts.supervisor,
+                    "Let the supervisor listening on SOCKET watch the container")
+      ->type_name("SOCKET");
+    return cmd;
+}
+
+auto register_create(CLI::App &app, linyaps_box::command::create_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("create", "Create a container without starting its process");
+    cmd->add_option("CONTAINER", opts.ID, "The container ID")->required();
+    cmd->add_option("-b,--bundle", opts.bundle, "Path to the OCI bundle")
+      ->default_val(".")
+      ->check(CLI::ExistingDirectory);
+    cmd->add_option("-f,--config", opts.config, "Override the configuration file to use")
+      ->type_name("FILE")
+      ->default_val("config.json");
+    add_preserve_fds(cmd, opts.preserve_fds);
+    add_console_socket(cmd, opts.console_socket);
+    return cmd;
+}
+
+auto register_start(CLI::App &app, linyaps_box::command::start_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("start", "Execute the process of a created container");
+    cmd->add_option("CONTAINER", opts.container, "The container ID")->required();
+    return cmd;
+}
+
+auto register_pool(CLI::App &app, linyaps_box::command::pool_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand(
+      "pool",
+      "Keep a number of created and frozen containers of a bundle ready to be claimed");
+    cmd->add_option("NAME", opts.name, "The pool name, a prefix of the member IDs")->required();
+    cmd->add_option("-b,--bundle", opts.bundle, "Path to the OCI bundle")
+      ->default_val(".")
+      ->check(CLI::ExistingDirectory);
+    cmd->add_option("-f,--config", opts.config, "Override the configuration file to use")
+      ->type_name("FILE")
+      ->default_val("config.json");
+    cmd->add_option("-s,--size", opts.size, "The number of idle containers to keep")
+      ->type_name("N")
+      ->default_val(1);
+    cmd->add_option("--idle-ttl",
+                    opts.idle_ttl,
+                    "Destroy idle containers not claimed in time, such as 10m, 0 never does")
+      ->type_name("DURATION")
+      ->transform(CLI::AsNumberWithUnit(std::map<std::string, std::uint64_t>{
+        { "s", 1 },
+        { "m", 60 },
+        { "h", 3600 },
+      }));
+    return cmd;
+}
+
+auto register_claim(CLI::App &app, linyaps_box::command::claim_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("claim", "Start an idle container of a pool and print its ID")
+                  ->positionals_at_end();
+    cmd->add_option("--cwd", opts.cwd, "Replace the working directory of the process")
+      ->type_name("PATH")
+      ->check([](const std::string &str) -> std::string {
+          return std::filesystem::path{ str }.is_absolute() ? "" : "must be an absolute path";
+      });
+    cmd
+      ->add_option("-e,--env",
+                   opts.envs,
+                   "Replace the environment of the process, use -e KEY=VALUE -e KEY2=VALUE2")
+      ->type_name("ENV")
+      ->check(
+        [](const std::string &str) noexcept -> std::string {
+            return linyaps_box::utils::is_invalid_env(str) ? "invalid env: " + str : "";
+        },
+        "check environment variables is valid or not");
+    cmd->add_option("POOL", opts.pool, "The pool name")->required();
+    cmd->add_option("ARGS", opts.args, "Replace the arguments of the process");
     return cmd;
 }
 
@@ -285,6 +379,104 @@ auto register_kill(CLI::App &app, linyaps_box::command::kill_options &opts) -> C
     return cmd;
 }
 
+auto register_pause(CLI::App &app, linyaps_box::command::pause_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("pause", "Freeze all processes of a running container");
+    cmd->add_option("CONTAINER", opts.container, "The container ID")->required();
+    return cmd;
+}
+
+auto register_resume(CLI::App &app, linyaps_box::command::resume_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("resume", "Thaw all processes of a paused container");
+    cmd->add_option("CONTAINER", opts.container, "The container ID")->required();
+    return cmd;
+}
+
+auto register_update(CLI::App &app, linyaps_box::command::update_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("update", "Update the resource limits of a running container");
+    cmd->add_option("CONTAINER", opts.container, "The container ID")->required();
+    cmd->add_option("-r,--resources",
+                    opts.resources,
+                    "Path to a JSON file with an OCI linux.resources object, - for stdin")
+      ->type_name("FILE");
+
+    const auto number_or_max = [](const std::string &str) -> std::string {
+        if (str == "max") {
+            return "";
+        }
+
+        std::uint64_t value{ };
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        if (ec != std::errc{ } || ptr != str.data() + str.size()) {
+            return "must be a number or max";
+        }
+
+        return "";
+    };
+
+    cmd->add_option("--cpu-weight", opts.cpu_weight, "cpu.weight, the relative CPU share")
+      ->type_name("WEIGHT")
+      ->check(CLI::Range(1, 10000));
+    cmd->add_option("--cpu-quota", opts.cpu_quota, "CPU time per period in microseconds")
+      ->type_name("USEC")
+      ->check(number_or_max);
+    cmd->add_option("--cpu-period", opts.cpu_period, "CPU period in microseconds")
+      ->type_name("USEC")
+      ->needs("--cpu-quota");
+    cmd->add_option("--memory-high", opts.memory_high, "memory.high, the throttling limit")
+      ->type_name("BYTES")
+      ->check(number_or_max);
+    cmd->add_option("--memory-max", opts.memory_max, "memory.max, the hard limit")
+      ->type_name("BYTES")
+      ->check(number_or_max);
+    cmd->add_option("--pids-max", opts.pids_max, "pids.max, the maximum number of tasks")
+      ->type_name("N")
+      ->check(number_or_max);
+    cmd->add_option("--io-weight", opts.io_weight, "io.weight, the default IO weight")
+      ->type_name("WEIGHT")
+      ->check(CLI::Range(1, 10000));
+    return cmd;
+}
+
+auto register_stats(CLI::App &app, linyaps_box::command::stats_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("stats", "Print the cgroup statistics of containers as JSON");
+    cmd->add_option("CONTAINER", opts.containers, "Container IDs, all containers if omitted");
+    return cmd;
+}
+
+auto register_events(CLI::App &app, linyaps_box::command::events_options &opts) -> CLI::App *
+{
+    auto *cmd = app.add_subcommand(
+      "events",
+      "Stream the cgroup statistics of containers as newline-delimited JSON");
+    cmd->add_option("CONTAINER", opts.containers, "Container IDs, all containers if omitted");
+    cmd->add_option("--interval", opts.interval_ms, "The sampling interval, such as 500ms or 5s")
+      ->type_name("DURATION")
+      ->transform(CLI::AsNumberWithUnit(std::map<std::string, std::uint64_t>{
+                                          { "ms", 1 },
+                                          { "s", 1000 },
+                                          { "m", 60000 },
+                                        },
+                                        CLI::AsNumberWithUnit::UNIT_REQUIRED))
+      ->check(CLI::PositiveNumber)
+      ->default_str("5s");
+    return cmd;
+}
+
+auto register_supervisor(CLI::App &app, linyaps_box::command::supervisor_options &opts)
+  -> CLI::App *
+{
+    auto *cmd = app.add_subcommand("supervisor",
+                                   "Watch the containers run with --supervisor in one process");
+    cmd->add_option("-s,--socket", opts.socket, "The unix socket to listen on")
+      ->type_name("SOCKET")
+      ->required();
+    return cmd;
+}
+
 } // namespace
 
 namespace {
@@ -300,12 +492,32 @@ struct cli_app_data
     linyaps_box::command::global_options global;
     linyaps_box::command::list_options list_opts;
     linyaps_box::command::run_options run_opts;
+    linyaps_box::command::create_options create_opts;
+    linyaps_box::command::start_options start_opts;
+    linyaps_box::command::pool_options pool_opts;
+    linyaps_box::command::claim_options claim_opts;
     linyaps_box::command::exec_options exec_opts;
     linyaps_box::command::kill_options kill_opts;
+    linyaps_box::command::pause_options pause_opts;
+    linyaps_box::command::resume_options resume_opts;
+    linyaps_box::command::update_options update_opts;
+    linyaps_box::command::stats_options stats_opts;
+    linyaps_box::command::events_options events_opts;
+    linyaps_box::command::supervisor_options supervisor_opts;
     CLI::App *cmd_list{ nullptr };
     CLI::App *cmd_run{ nullptr };
+    CLI::App *cmd_create{ nullptr };
+    CLI::App *cmd_start{ nullptr };
+    CLI::App *cmd_pool{ nullptr };
+    CLI::App *cmd_claim{ nullptr };
     CLI::App *cmd_exec{ nullptr };
     CLI::App *cmd_kill{ nullptr };
+    CLI::App *cmd_pause{ nullptr };
+    CLI::App *cmd_resume{ nullptr };
+    CLI::App *cmd_update{ nullptr };
+    CLI::App *cmd_stats{ nullptr };
+    CLI::App *cmd_events{ nullptr };
+    CLI::App *cmd_supervisor{ nullptr };
 };
 
 void build_cli_app(cli_app_data &data)
@@ -319,8 +531,18 @@ void build_cli_app(cli_app_data &data)
     register_global(data.app, data.global);
     data.cmd_list = register_list(data.app, data.list_opts);
     data.cmd_run = register_run(data.app, data.run_opts);
+    data.cmd_create = register_create(data.app, data.create_opts);
+    data.cmd_start = register_start(data.app, data.start_opts);
+    data.cmd_pool = register_pool(data.app, data.pool_opts);
+    data.cmd_claim = register_claim(data.app, data.claim_opts);
     data.cmd_exec = register_exec(data.app, data.exec_opts);
     data.cmd_kill = register_kill(data.app, data.kill_opts);
+    data.cmd_pause = register_pause(data.app, data.pause_opts);
+    data.cmd_resume = register_resume(data.app, data.resume_opts);
+    data.cmd_update = register_update(data.app, data.update_opts);
+    data.cmd_stats = register_stats(data.app, data.stats_opts);
+    data.cmd_events = register_events(data.app, data.events_opts);
+    data.cmd_supervisor = register_supervisor(data.app, data.supervisor_opts);
 }
 
 void run_parse(CLI::App &app, int argc, char **argv)
@@ -336,10 +558,30 @@ auto convert_result(cli_app_data &data) -> linyaps_box::command::options
         opts.subcommand_opt = data.list_opts;
     } else if (data.cmd_run->parsed()) {
         opts.subcommand_opt = std::move(data.run_opts);
+    } else if (data.cmd_create->parsed()) {
+        opts.subcommand_opt = std::move(data.create_opts);
+    } else if (data.cmd_start->parsed()) {
+        opts.subcommand_opt = std::move(data.start_opts);
+    } else if (data.cmd_pool->parsed()) {
+        opts.subcommand_opt = std::move(data.pool_opts);
+    } else if (data.cmd_claim->parsed()) {
+        opts.subcommand_opt = std::move(data.claim_opts);
     } else if (data.cmd_exec->parsed()) {
         opts.subcommand_opt = std::move(data.exec_opts);
     } else if (data.cmd_kill->parsed()) {
         opts.subcommand_opt = std::move(data.kill_opts);
+    } else if (data.cmd_pause->parsed()) {
+        opts.subcommand_opt = std::move(data.pause_opts);
+    } else if (data.cmd_resume->parsed()) {
+        opts.subcommand_opt = std::move(data.resume_opts);
+    } else if (data.cmd_update->parsed()) {
+        opts.subcommand_opt = std::move(data.update_opts);
+    } else if (data.cmd_stats->parsed()) {
+        opts.subcommand_opt = std::move(data.stats_opts);
+    } else if (data.cmd_events->parsed()) {
+        opts.subcommand_opt = std::move(data.events_opts);
+    } else if (data.cmd_supervisor->parsed()) {
+        opts.subcommand_opt = std::move(data.supervisor_opts);
     }
     return opts;
 }
@@ -31,6 +31,7 @@ struct global_options
     log::level log_level;
     log::output_format log_format;
     bool cee_syslog{ false };
+    std::optional<std::filesystem::path> trace_file;
 };
 
 struct list_options
@@ -69,7 +70,44 @@ struct run_options
     std::filesystem::path bundle;
     std::filesystem::path config;
     std::optional<std::filesystem::path> console_socket;
+    std::optional<std::filesystem::path> startup_timing;
+    std::optional<std::filesystem::path> usage_report;
     int preserve_fds{ 0 };
+    bool detach{ false };
+    // hand the container to the supervisor listening on this socket
+    std::optional<std::filesystem::path> supervisor;
+};
+
+struct create_options
+{
+    std::string ID;
+    std::filesystem::path bundle;
+    std::filesystem::path config;
+    std::optional<std::filesystem::path> console_socket;
+    int preserve_fds{ 0 };
+};
+
+struct start_options
+{
+    std::string container;
+};
+
+struct pool_options
+{
+    std::string name;
+    std::filesystem::path bundle;
+    std::filesystem::path config;
+    std::size_t size{ 1 };
+    // seconds an idle member waits to be claimed, 0 waits forever
+    std::uint64_t idle_ttl{ 0 };
+};
+
+struct claim_options
+{
+    std::string pool;
+    std::vector<std::string> args;
+    std::vector<std::string> envs;
+    std::optional<std::filesystem::path> cwd;
 };
 
 struct kill_options
@@ -78,10 +116,65 @@ struct kill_options
     int signal{ };
 };
 
+struct pause_options
+{
+    std::string container;
+};
+
+struct resume_options
+{
+    std::string container;
+};
+
+struct update_options
+{
+    std::string container;
+    // an OCI linux.resources object, "-" reads it from stdin
+    std::optional<std::filesystem::path> resources;
+    // cgroup v2 values, "max" is accepted where the kernel accepts it
+    std::optional<std::uint64_t> cpu_weight;
+    std::optional<std::string> cpu_quota;
+    std::optional<std::uint64_t> cpu_period;
+    std::optional<std::string> memory_high;
+    std::optional<std::string> memory_max;
+    std::optional<std::string> pids_max;
+    std::optional<std::uint64_t> io_weight;
+};
+
+struct stats_options
+{
+    // every container with a cgroup when empty
+    std::vector<std::string> containers;
+};
+
+struct supervisor_options
+{
+    std::filesystem::path socket;
+};
+
+struct events_options
+{
+    std::vector<std::string> containers;
+    std::uint64_t interval_ms{ 5000 };
+};
+
 struct options
 {
-    using subcommand_opt_t =
-      std::variant<std::monostate, list_options, exec_options, run_options, kill_options>;
+    using subcommand_opt_t = std::variant<std::monostate,
+                                          list_options,
+                                          exec_options,
+                                          run_options,
+                                          create_options,
+                                          start_options,
+                                          pool_options,
+                                          claim_options,
+                                          kill_options,
+                                          pause_options,
+                                          resume_options,
+                                          update_options,
+                                          stats_options,
+                                          events_options,
+                                          supervisor_options>;
 
     global_options global;
     subcommand_opt_t subcommand_opt;
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/pool.h"
+
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/os/process.h"
+#include "linyaps_box/runtime.h"
+#include "linyaps_box/status_directory_manager.h"
+#include "linyaps_box/utils/utils.h"
+
+#include <csignal>
+
+#include <unistd.h>
+
+namespace {
+
+// The member may have exited since it was listed and its pid been reused. Pin the
+// process with a pidfd before checking it is still the member, the way
+// container_ref checks the start time, so the check holds until it is killed.
+void kill_member(const linyaps_box::container_status &member)
+{
+    using namespace linyaps_box;
+
+    auto pidfd = os::pidfd_open(member.pid);
+    if (!pidfd && pidfd.error() == std::errc::no_such_process) {
+        return;
+    }
+
+    if (derive_status(member) == runtime_status::STOPPED) {
+        return;
+    }
+
+    int err{ 0 };
+    if (pidfd) {
+        if (auto ret = os::pidfd_send_signal(pidfd->ref(), SIGKILL); !ret) {
+            err = ret.error().value();
+        }
+    } else if (::kill(member.pid, SIGKILL) != 0) {
+        err = errno;
+    }
+
+    if (err != 0 && err != ESRCH) {
+        throw std::system_error(err,
+                                std::system_category(),
+                                fmt::format("failed to kill pool member {}", member.id));
+    }
+}
+
+} // namespace
+
+auto linyaps_box::command::pool(const pool_options &options, const global_options &global) -> int
+{
+    if (global.manager == cgroup_manager_t::disabled) {
+        throw std::runtime_error("idle pool members are frozen, which needs a cgroup manager");
+    }
+
+    status_directory_manager mgr(global.root);
+    runtime_t runtime(std::move(mgr));
+    auto idle = runtime.idle_pool_members(options.name);
+
+    // Shrink from the oldest member. Unlinking its exec FIFO first keeps a
+    // concurrent claim from starting the container being destroyed.
+    const auto surplus = idle.size() > options.size ? idle.size() - options.size : 0;
+    for (std::size_t i = 0; i < surplus; ++i) {
+        const auto &member = idle[i];
+        if (::unlink(member.exec_fifo.c_str()) != 0) {
+            continue;
+        }
+
+        LINYAPS_BOX_LOG_DEBUG("Destroy surplus pool member {}", member.id);
+        kill_member(member);
+    }
+
+    for (auto count = idle.size(); count < options.size; ++count) {
+        const create_container_options_t create_container_options{
+            global.manager,
+            fmt::format("{}-{}", options.name, utils::gen_random_string(8)),
+            options.bundle,
+            options.config,
+            { }
+        };
+        auto container = runtime.create_container(create_container_options);
+
+        const auto &cfg = container.get_config();
+        if (UNLIKELY(!cfg.process || !cfg.root)) {
+            throw std::runtime_error("'process' and 'root' are required for create a container");
+        }
+
+        if (cfg.process->terminal.value_or(false)) {
+            throw std::runtime_error("a container with terminal cannot be pooled");
+        }
+
+        run_container_options_t run_options{ };
+        run_options.pool = options.name;
+        if (options.idle_ttl > 0) {
+            run_options.idle_timeout = std::chrono::seconds{ options.idle_ttl };
+        }
+
+        if (container.create(std::move(run_options)) != EXIT_SUCCESS) {
+            throw std::runtime_error(fmt::format("failed to create pool member {}",
+                                                 create_container_options.ID));
+        }
+
+        container.pause();
+    }
+
+    return 0;
+}
@@ -6,30 +6,70 @@
 
 #include "linyaps_box/runtime.h"
 #include "linyaps_box/status_directory_manager.h"
+#include "linyaps_box/supervisor.h"
+#include "linyaps_box/utils/timing.h"
 #include "linyaps_box/utils/utils.h"
 
 auto linyaps_box::command::run(const struct run_options &options, const global_options &global)
   -> int
 {
+    if (options.startup_timing) {
+        utils::phase_recorder::instance().enable();
+    }
+
+    if (options.supervisor) {
+        if (options.usage_report) {
+            throw std::runtime_error("--usage-report is not supported with --supervisor");
+        }
+
+        // the supervisor creates the container under its own --root and cgroup manager
+        supervised_run_request request;
+        request.id = options.ID;
+        request.bundle = std::filesystem::absolute(options.bundle);
+        request.config = options.config;
+        if (options.console_socket) {
+            request.console_socket = std::filesystem::absolute(*options.console_socket);
+        }
+        if (options.startup_timing) {
+            request.startup_timing = std::filesystem::absolute(*options.startup_timing);
+        }
+        request.preserve_fds = options.preserve_fds;
+        request.detach = options.detach;
+        return run_in_supervisor(*options.supervisor, request);
+    }
+
     status_directory_manager mgr(global.root);
     runtime_t runtime(std::move(mgr));
     const create_container_options_t create_container_options{ global.manager,
                                                                options.ID,
                                                                options.bundle,
-                                                               options.config };
+                                                               options.config,
+                                                               { } };
     auto container = runtime.create_container(create_container_options);
 
     run_container_options_t run_options;
     run_options.preserve_fds = options.preserve_fds;
+    run_options.startup_timing = options.startup_timing;
+    run_options.usage_report = options.usage_report;
 
     const auto &cfg = container.get_config();
     if (UNLIKELY(!cfg.process || !cfg.root)) {
         throw std::runtime_error("'process' and 'root' are required for run a container");
     }
 
-    if (container.get_config().process->terminal && options.console_socket) {
+    const auto terminal = cfg.process->terminal.value_or(false);
+    if (terminal && options.console_socket) {
         run_options.console_socket = infra::unix_socket::connect(*options.console_socket);
     }
 
-    return container.run(std::move(run_options));
+    if (!options.detach) {
+        return container.run(std::move(run_options));
+    }
+
+    // nobody is left to forward the terminal once run returns
+    if (terminal && !options.console_socket) {
+        throw std::runtime_error("--console-socket is required for a container with terminal");
+    }
+
+    return container.run_detached(std::move(run_options));
 }
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/start.h"
+
+#include "linyaps_box/runtime.h"
+#include "linyaps_box/status_directory_manager.h"
+
+auto linyaps_box::command::start(const start_options &options, const global_options &global) -> int
+{
+    status_directory_manager mgr(global.root);
+    runtime_t runtime(std::move(mgr));
+    auto container = runtime.find_container(options.container);
+    if (!container) {
+        throw std::runtime_error("container not found");
+    }
+
+    container->start();
+    return 0;
+}
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/stats.h"
+
+#include "linyaps_box/runtime.h"
+#include "linyaps_box/status_directory_manager.h"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+namespace linyaps_box::command {
+
+auto container_cgroups(const global_options &global, const std::vector<std::string> &ids)
+  -> std::vector<std::pair<std::string, std::filesystem::path>>
+{
+    status_directory_manager mgr(global.root);
+    runtime_t runtime(std::move(mgr));
+
+    std::vector<std::pair<std::string, std::filesystem::path>> ret;
+    if (ids.empty()) {
+        for (const auto &[id, container] : runtime.containers()) {
+            auto status = container.status();
+            if (!status.cgroup_path.empty()) {
+                ret.emplace_back(id, std::move(status.cgroup_path));
+            }
+        }
+
+        return ret;
+    }
+
+    for (const auto &id : ids) {
+        auto container = runtime.find_container(id);
+        if (!container) {
+            throw std::runtime_error("container " + id + " not found");
+        }
+
+        auto status = container->status();
+        if (status.cgroup_path.empty()) {
+            throw std::runtime_error("container " + id + " has no cgroup");
+        }
+
+        ret.emplace_back(id, std::move(status.cgroup_path));
+    }
+
+    return ret;
+}
+
+auto stats(const stats_options &options, const global_options &global) -> int
+{
+    status_directory_manager mgr(global.root);
+    runtime_t runtime(std::move(mgr));
+
+    auto j = nlohmann::json::array();
+    if (options.containers.empty()) {
+        for (const auto &[id, container] : runtime.containers()) {
+            if (container.status().cgroup_path.empty()) {
+                continue;
+            }
+
+            j.push_back({ { "id", id }, { "data", container.stats() } });
+        }
+    }
+
+    for (const auto &id : options.containers) {
+        auto container = runtime.find_container(id);
+        if (!container) {
+            throw std::runtime_error("container " + id + " not found");
+        }
+
+        j.push_back({ { "id", id }, { "data", container->stats() } });
+    }
+
+    fmt::println("{}", j.dump(4));
+    return 0;
+}
+
+} // namespace linyaps_box::command
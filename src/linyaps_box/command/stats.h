@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/command/options.h"
+
+#include <utility>
+
+namespace linyaps_box::command {
+
+// The cgroups of the given containers, or of every container that has one when
+// ids is empty. Throws if a given container does not exist or has no cgroup.
+[[nodiscard]] auto container_cgroups(const global_options &global,
+                                     const std::vector<std::string> &ids)
+  -> std::vector<std::pair<std::string, std::filesystem::path>>;
+
+[[nodiscard]] auto stats(const stats_options &options, const global_options &global) -> int;
+
+} // namespace linyaps_box::command
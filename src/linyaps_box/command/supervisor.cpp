@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/supervisor.h"
+
+#include "linyaps_box/supervisor.h"
+
+auto linyaps_box::command::supervisor(const supervisor_options &options,
+                                      const global_options &global) -> int
+{
+    linyaps_box::supervisor daemon(global.root, global.manager);
+    return daemon.serve(options.socket);
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/command/update.h"
+
+#include "linyaps_box/runtime.h"
+#include "linyaps_box/status_directory_manager.h"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+auto read_resources(const std::filesystem::path &path)
+  -> linyaps_box::oci_config::linux_t::resources_t
+{
+    nlohmann::json json;
+    if (path == "-") {
+        json = nlohmann::json::parse(std::cin);
+    } else {
+        std::ifstream stream{ path };
+        if (!stream) {
+            throw std::runtime_error("failed to open " + path.string());
+        }
+        json = nlohmann::json::parse(stream);
+    }
+
+    return json.get<linyaps_box::oci_config::linux_t::resources_t>();
+}
+
+} // namespace
+
+auto linyaps_box::command::update(const update_options &options, const global_options &global)
+  -> int
+{
+    oci_config::linux_t::resources_t resources;
+    if (options.resources) {
+        resources = read_resources(*options.resources);
+    }
+
+    // The flags are cgroup v2 values already, they go through the unified map and
+    // so take precedence over the same setting in --resources.
+    auto &unified = resources.unified ? *resources.unified : resources.unified.emplace();
+    if (options.cpu_weight) {
+        unified["cpu.weight"] = std::to_string(*options.cpu_weight);
+    }
+    if (options.cpu_quota) {
+        unified["cpu.max"] = options.cpu_period
+          ? fmt::format("{} {}", *options.cpu_quota, *options.cpu_period)
+          : *options.cpu_quota;
+    }
+    if (options.memory_high) {
+        unified["memory.high"] = *options.memory_high;
+    }
+    if (options.memory_max) {
+        unified["memory.max"] = *options.memory_max;
+    }
+    if (options.pids_max) {
+        unified["pids.max"] = *options.pids_max;
+    }
+    if (options.io_weight) {
+        unified["io.weight"] = fmt::format("default {}", *options.io_weight);
+    }
+
+    status_directory_manager mgr(global.root);
+    runtime_t runtime(std::move(mgr));
+    auto container = runtime.find_container(options.container);
+    if (!container) {
+        throw std::runtime_error("container not found");
+    }
+
+    container->update(resources);
+    return 0;
+}
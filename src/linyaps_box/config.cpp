@@ -6,6 +6,8 @@
 
 #include "linyaps_box/config/enum_tables.h"
 #include "linyaps_box/config/mount_options.h"
+#include "linyaps_box/config/parse_helpers.h"
+#include "linyaps_box/config/parser.h"
 #include "linyaps_box/config/validate.h"
 #include "linyaps_box/utils/enum_traits.h"
 #include "linyaps_box/utils/semver.h"
@@ -15,6 +17,7 @@
 
 #include <charconv>
 #include <fstream>
+#include <iterator>
 #include <limits>
 
 namespace nlohmann {
@@ -67,7 +70,9 @@ namespace {
 
 namespace mo = linyaps_box::config::mount_options;
 
-auto parse_range_list(std::string_view s) -> std::vector<unsigned int>
+} // namespace
+
+auto linyaps_box::config::parse_range_list(std::string_view s) -> std::vector<unsigned int>
 {
     std::vector<unsigned int> result;
     if (s.empty()) {
@@ -165,6 +170,8 @@ auto parse_range_list(std::string_view s) -> std::vector<unsigned int>
     return result;
 }
 
+namespace {
+
 auto parse_id_mapping_chunk(std::string_view chunk) -> linyaps_box::oci_config::id_mapping_t
 {
     // format: "containerID:hostID:size"
@@ -272,7 +279,7 @@ auto parse_inline_idmap_option(std::string_view opt) -> inline_idmap_result
 
 } // namespace
 
-auto parse_mount_options(const std::vector<std::string> &options)
+auto linyaps_box::config::parse_mount_options(const std::vector<std::string> &options)
   -> std::tuple<unsigned long,
                 unsigned long,
                 std::optional<linyaps_box::oci_config::mount_t::recursive_attr>,
@@ -377,6 +384,34 @@ auto parse_mount_options(const std::vector<std::string> &options)
              std::move(data) };
 }
 
+auto linyaps_box::config::parse_rootfs_propagation(std::string_view name) -> unsigned long
+{
+    struct propagation_entry_t
+    {
+        std::string_view name;
+        unsigned long value;
+    };
+
+    constexpr std::array<propagation_entry_t, 8> table{ {
+      { "private", MS_PRIVATE },
+      { "rprivate", MS_PRIVATE | MS_REC },
+      { "shared", MS_SHARED },
+      { "rshared", MS_SHARED | MS_REC },
+      { "slave", MS_SLAVE },
+      { "rslave", MS_SLAVE | MS_REC },
+      { "unbindable", MS_UNBINDABLE },
+      { "runbindable", MS_UNBINDABLE | MS_REC },
+    } };
+
+    for (const auto &entry : table) {
+        if (name == entry.name) {
+            return entry.value;
+        }
+    }
+
+    throw std::runtime_error("unknown value: " + std::string(name));
+}
+
 namespace linyaps_box {
 
 void from_json(const nlohmann::json &j, linyaps_box::oci_config::process_t::console_size_t &v)
@@ -727,11 +762,11 @@ void from_json(const nlohmann::json &j, oci_config::linux_t::resources_t::cpu_t
     }
 
     if (auto it = j.find("cpus"); it != j.end() && !it->is_null()) {
-        v.cpus = parse_range_list(it->get_ref<const std::string &>());
+        v.cpus = config::parse_range_list(it->get_ref<const std::string &>());
     }
 
     if (auto it = j.find("mems"); it != j.end() && !it->is_null()) {
-        v.mems = parse_range_list(it->get_ref<const std::string &>());
+        v.mems = config::parse_range_list(it->get_ref<const std::string &>());
     }
 
     if (auto it = j.find("idle"); it != j.end() && !it->is_null()) {
@@ -908,7 +943,7 @@ void from_json(const nlohmann::json &j, oci_config::linux_t::memory_policy_t &v)
     v.mode = *mode_opt;
 
     if (auto nodes_it = j.find("nodes"); nodes_it != j.end() && !nodes_it->is_null()) {
-        v.nodes = parse_range_list(nodes_it->get<std::string_view>());
+        v.nodes = config::parse_range_list(nodes_it->get<std::string_view>());
     }
 
     if (auto flags_it = j.find("flags"); flags_it != j.end() && !flags_it->is_null()) {
@@ -1077,39 +1112,9 @@ void from_json(const nlohmann::json &j, oci_config::linux_t &v)
     }
 
     if (auto it = j.find("rootfsPropagation"); it != j.end() && !it->is_null()) {
-        auto prop_name = it->get<std::string_view>();
-
-        struct propagation_entry_t
-        {
-            std::string_view name;
-            unsigned long value;
-        };
-
-        const std::array<propagation_entry_t, 8> table{ {
-          { "private", MS_PRIVATE },
-          { "rprivate", MS_PRIVATE | MS_REC },
-          { "shared", MS_SHARED },
-          { "rshared", MS_SHARED | MS_REC },
-          { "slave", MS_SLAVE },
-          { "rslave", MS_SLAVE | MS_REC },
-          { "unbindable", MS_UNBINDABLE },
-          { "runbindable", MS_UNBINDABLE | MS_REC },
-        } };
-
-        bool found = false;
-        for (const auto &entry : table) {
-            if (prop_name == entry.name) {
-                v.rootfs_propagation = entry.value;
-                found = true;
-                break;
-            }
-        }
-
-        if (UNLIKELY(!found)) {
-            throw std::runtime_error("unknown value: " + std::string(prop_name));
-        }
+        v.rootfs_propagation = config::parse_rootfs_propagation(it->get<std::string_view>());
     } else {
-        v.rootfs_propagation = MS_PRIVATE | MS_REC;
+        v.rootfs_propagation = config::default_rootfs_propagation;
     }
 
     if (auto it = j.find("sysctl"); it != j.end() && !it->is_null()) {
@@ -1212,14 +1217,24 @@ void from_json(const nlohmann::json &j, oci_config::mount_t &v)
 
     if (auto it = j.find("options"); it != j.end() && !it->is_null()) {
         auto options = it->get<std::vector<std::string>>();
+        std::optional<std::vector<oci_config::id_mapping_t>> uid_mappings;
+        std::optional<std::vector<oci_config::id_mapping_t>> gid_mappings;
         std::tie(v.vfs_flags,
                  v.propagation_flags,
                  v.rec_attr,
                  v.extension_flags,
                  v.idmap,
-                 v.uid_mappings,
-                 v.gid_mappings,
-                 v.data) = parse_mount_options(options);
+                 uid_mappings,
+                 gid_mappings,
+                 v.data) = config::parse_mount_options(options);
+
+        // inline "idmap=uids=...,gids=..." mappings override uidMappings/gidMappings
+        if (uid_mappings) {
+            v.uid_mappings = std::move(uid_mappings);
+        }
+        if (gid_mappings) {
+            v.gid_mappings = std::move(gid_mappings);
+        }
     }
 }
 
@@ -1314,7 +1329,7 @@ auto validate_namespace_path(const oci_config::linux_t::namespace_t &ns) -> void
 
 auto oci_config::parse(std::string_view content) -> oci_config
 {
-    auto config = nlohmann::json::parse(content).get<oci_config>();
+    auto config = config::parse_streaming(content);
     validate(config);
     return config;
 }
@@ -1329,9 +1344,11 @@ auto oci_config::parse(const std::filesystem::path &path) -> oci_config
           std::make_error_code(static_cast<std::errc>(errno)));
     }
 
-    auto config = nlohmann::json::parse(stream).get<oci_config>();
-    validate(config);
-    return config;
+    // the streaming parser needs the whole document in memory, which is still
+    // far smaller than the nlohmann::json tree it replaces
+    const std::string content{ std::istreambuf_iterator<char>{ stream },
+                               std::istreambuf_iterator<char>{ } };
+    return parse(std::string_view{ content });
 }
 
 } // namespace linyaps_box
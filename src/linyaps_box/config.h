@@ -90,14 +90,15 @@ struct oci_config
             std::optional<int32_t> nice;
             std::optional<int32_t> priority;
 
+            // the SCHED_FLAG_* bits of sched_setattr(2)
             enum class flag_t : std::uint8_t {
-                RESET_ON_FORK,
-                RECLAIM,
-                DL_OVERRUN,
-                KEEP_POLICY,
-                KEEP_PARAMS,
-                UTIL_CLAMP_MIN,
-                UTIL_CLAMP_MAX,
+                RESET_ON_FORK = 0x01,
+                RECLAIM = 0x02,
+                DL_OVERRUN = 0x04,
+                KEEP_POLICY = 0x08,
+                KEEP_PARAMS = 0x10,
+                UTIL_CLAMP_MIN = 0x20,
+                UTIL_CLAMP_MAX = 0x40,
                 LINYAPS_MARK_AS_BITMASK_ENUM(UTIL_CLAMP_MAX),
             };
 
@@ -177,7 +178,7 @@ struct oci_config
         unsigned long propagation_flags{ 0 };
 
         // Recursive mount_setattr attributes — applied via mount_setattr(AT_RECURSIVE).
-        // TODO: implement mount_setattr.
+        // Only honored when the kernel supports the new mount API (5.12+).
         struct recursive_attr
         {
             uint64_t set{ 0 };
@@ -566,4 +567,6 @@ void from_json(const nlohmann::json &j, oci_config &v);
 
 void from_json(const nlohmann::json &j, oci_config::process_t &v);
 
+void from_json(const nlohmann::json &j, oci_config::linux_t::resources_t &v);
+
 } // namespace linyaps_box
@@ -0,0 +1,636 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/config/cache.h"
+
+#include "linyaps_box/io/stream.h"
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/os/fs.h"
+#include "linyaps_box/utils/defer.h"
+#include "linyaps_box/utils/utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <sys/stat.h>
+
+namespace linyaps_box::config {
+
+namespace {
+
+// "LBCC" in little endian
+constexpr uint32_t cache_magic = 0x4343424cU;
+// Bump whenever the encoding or the parse result of a config.json changes.
+// 2: uidMappings/gidMappings of mounts are no longer dropped by "options".
+// 3: process.scheduler.flags hold the SCHED_FLAG_* bits.
+constexpr uint32_t cache_format_version = 3;
+
+struct cache_key
+{
+    uint64_t dev;
+    uint64_t ino;
+    int64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    int64_t ctime_sec;
+    int64_t ctime_nsec;
+
+    [[nodiscard]] auto operator==(const cache_key &other) const noexcept -> bool
+    {
+        return std::memcmp(this, &other, sizeof(cache_key)) == 0;
+    }
+};
+
+static_assert(std::has_unique_object_representations_v<cache_key>);
+
+struct cache_header
+{
+    uint32_t magic;
+    uint32_t version;
+    cache_key key;
+    uint64_t payload_size;
+};
+
+static_assert(std::has_unique_object_representations_v<cache_header>);
+
+auto make_key(const struct stat &st) noexcept -> cache_key
+{
+    return { static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino),
+             static_cast<int64_t>(st.st_size), st.st_mtim.tv_sec,
+             st.st_mtim.tv_nsec,               st.st_ctim.tv_sec,
+             st.st_ctim.tv_nsec };
+}
+
+// A rewrite of the config within the same timestamp tick leaves mtime and ctime
+// unchanged. Like git's racy index check, a cache is only trusted if it was
+// written strictly after the last change of the config it was built from.
+auto is_racy(const cache_key &key, const struct stat &cache_st) noexcept -> bool
+{
+    const auto to_ns = [](int64_t sec, int64_t nsec) {
+        return std::chrono::seconds{ sec } + std::chrono::nanoseconds{ nsec };
+    };
+
+    const auto changed =
+      std::max(to_ns(key.mtime_sec, key.mtime_nsec), to_ns(key.ctime_sec, key.ctime_nsec));
+    return to_ns(cache_st.st_mtim.tv_sec, cache_st.st_mtim.tv_nsec) <= changed;
+}
+
+// Every type in oci_config is described once by listing its members, the same
+// list drives both the writer and the reader.
+#define LINYAPS_BOX_CACHE_FIELDS(type, ...)                                                        \
+    template <typename Ar>                                                                         \
+    auto visit_fields(Ar &ar, type &v) -> void                                                     \
+    {                                                                                              \
+        ar(__VA_ARGS__);                                                                           \
+    }                                                                                              \
+    template <typename Ar>                                                                         \
+    auto visit_fields(Ar &ar, const type &v) -> void                                               \
+    {                                                                                              \
+        ar(__VA_ARGS__);                                                                           \
+    }
+
+using process_t = oci_config::process_t;
+using mount_t = oci_config::mount_t;
+using linux_t = oci_config::linux_t;
+using resources_t = linux_t::resources_t;
+using seccomp_t = linux_t::seccomp_t;
+using hooks_t = oci_config::hooks_t;
+
+LINYAPS_BOX_CACHE_FIELDS(process_t::console_size_t, v.height, v.width)
+LINYAPS_BOX_CACHE_FIELDS(process_t::rlimit_t, v.type, v.soft, v.hard)
+LINYAPS_BOX_CACHE_FIELDS(
+  process_t::capabilities_t, v.effective, v.bounding, v.inheritable, v.permitted, v.ambient)
+LINYAPS_BOX_CACHE_FIELDS(process_t::scheduler_t,
+                         v.policy,
+                         v.nice,
+                         v.priority,
+                         v.flags,
+                         v.runtime,
+                         v.deadline,
+                         v.period)
+LINYAPS_BOX_CACHE_FIELDS(process_t::io_priority_t, v.class_, v.priority)
+LINYAPS_BOX_CACHE_FIELDS(process_t::exec_cpu_affinity_t, v.initial, v.final)
+LINYAPS_BOX_CACHE_FIELDS(process_t::user_t, v.uid, v.gid, v.umask, v.additional_gids)
+LINYAPS_BOX_CACHE_FIELDS(process_t,
+                         v.terminal,
+                         v.console_size,
+                         v.cwd,
+                         v.env,
+                         v.args,
+                         v.rlimits,
+                         v.apparmor_profile,
+                         v.capabilities,
+                         v.no_new_privileges,
+                         v.oom_score_adj,
+                         v.scheduler,
+                         v.selinux_label,
+                         v.io_priority,
+                         v.exec_cpu_affinity,
+                         v.user)
+LINYAPS_BOX_CACHE_FIELDS(oci_config::id_mapping_t, v.host_id, v.container_id, v.size)
+LINYAPS_BOX_CACHE_FIELDS(mount_t::recursive_attr, v.set, v.clr)
+LINYAPS_BOX_CACHE_FIELDS(mount_t,
+                         v.vfs_flags,
+                         v.propagation_flags,
+                         v.rec_attr,
+                         v.extension_flags,
+                         v.idmap,
+                         v.source,
+                         v.destination,
+                         v.type,
+                         v.data,
+                         v.uid_mappings,
+                         v.gid_mappings)
+LINYAPS_BOX_CACHE_FIELDS(linux_t::namespace_t, v.type_, v.path)
+LINYAPS_BOX_CACHE_FIELDS(linux_t::time_offset_t, v.secs, v.nanosecs)
+LINYAPS_BOX_CACHE_FIELDS(
+  linux_t::device_t, v.type, v.path, v.major, v.minor, v.mode, v.uid, v.gid)
+LINYAPS_BOX_CACHE_FIELDS(linux_t::network_device_t, v.name)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::device_t, v.allow, v.type, v.major, v.minor, v.access)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::memory_t,
+                         v.limit,
+                         v.reservation,
+                         v.swap,
+                         v.kernel,
+                         v.kernel_tcp,
+                         v.swappiness,
+                         v.disable_OOM_killer,
+                         v.use_hierarchy,
+                         v.check_before_update)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::cpu_t,
+                         v.shares,
+                         v.quota,
+                         v.burst,
+                         v.period,
+                         v.realtime_runtime,
+                         v.realtime_period,
+                         v.cpus,
+                         v.mems,
+                         v.idle)
+LINYAPS_BOX_CACHE_FIELDS(
+  resources_t::block_io_t::weight_device_t, v.major, v.minor, v.weight, v.leaf_weight)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::block_io_t::throttle_device_t, v.major, v.minor, v.rate)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::block_io_t,
+                         v.weight,
+                         v.leaf_weight,
+                         v.weight_devices,
+                         v.throttle_read_bps_device,
+                         v.throttle_write_bps_device,
+                         v.throttle_read_iops_device,
+                         v.throttle_write_iops_device)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::hugepage_limit_t, v.page_size, v.limit)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::network_t::priority_t, v.name, v.priority)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::network_t, v.class_id, v.priorities)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::pids_t, v.limit)
+LINYAPS_BOX_CACHE_FIELDS(resources_t::rdma_t, v.hca_handles, v.hca_objects)
+LINYAPS_BOX_CACHE_FIELDS(resources_t,
+                         v.devices,
+                         v.memory,
+                         v.cpu,
+                         v.block_io,
+                         v.hugepage_limits,
+                         v.network,
+                         v.pids,
+                         v.rdma,
+                         v.unified)
+LINYAPS_BOX_CACHE_FIELDS(linux_t::intel_rdt_t,
+                         v.clos_id,
+                         v.l3_cache_schema,
+                         v.memory_bandwidth_schema,
+                         v.schemata,
+                         v.enable_monitoring)
+LINYAPS_BOX_CACHE_FIELDS(linux_t::memory_policy_t, v.mode, v.nodes, v.flags)
+LINYAPS_BOX_CACHE_FIELDS(seccomp_t::syscall_t::arg_t, v.index, v.value, v.value_two, v.op)
+LINYAPS_BOX_CACHE_FIELDS(seccomp_t::syscall_t, v.names, v.action, v.errno_ret, v.args)
+LINYAPS_BOX_CACHE_FIELDS(seccomp_t,
+                         v.default_action,
+                         v.default_errno_ret,
+                         v.architectures,
+                         v.flags,
+                         v.listener_path,
+                         v.listener_metadata,
+                         v.syscalls)
+LINYAPS_BOX_CACHE_FIELDS(linux_t::personality_t, v.domain, v.flags)
+LINYAPS_BOX_CACHE_FIELDS(linux_t,
+                         v.namespaces,
+                         v.uid_mappings,
+                         v.gid_mappings,
+                         v.time_offsets,
+                         v.devices,
+                         v.network_devices,
+                         v.cgroups_path,
+                         v.resources,
+                         v.intel_rdt,
+                         v.memory_policy,
+                         v.sysctl,
+                         v.seccomp,
+                         v.rootfs_propagation,
+                         v.masked_paths,
+                         v.readonly_paths,
+                         v.mount_label,
+                         v.personality)
+LINYAPS_BOX_CACHE_FIELDS(hooks_t::hook_t, v.path, v.args, v.env, v.timeout)
+LINYAPS_BOX_CACHE_FIELDS(hooks_t,
+                         v.prestart,
+                         v.create_runtime,
+                         v.create_container,
+                         v.start_container,
+                         v.poststart,
+                         v.poststop)
+LINYAPS_BOX_CACHE_FIELDS(oci_config::root_t, v.path, v.readonly)
+LINYAPS_BOX_CACHE_FIELDS(oci_config,
+                         v.process,
+                         v.hostname,
+                         v.domainname,
+                         v.mounts,
+                         v.linux,
+                         v.hooks,
+                         v.root,
+                         v.annotations)
+
+#undef LINYAPS_BOX_CACHE_FIELDS
+
+class writer
+{
+public:
+    template <typename... T>
+    auto operator()(const T &...values) -> void
+    {
+        (put(values), ...);
+    }
+
+    [[nodiscard]] auto take() && -> std::vector<std::byte> { return std::move(buf); }
+
+private:
+    std::vector<std::byte> buf;
+
+    auto put_raw(const void *data, std::size_t size) -> void
+    {
+        const auto old_size = buf.size();
+        buf.resize(old_size + size);
+        std::memcpy(buf.data() + old_size, data, size);
+    }
+
+    auto put_size(std::size_t size) -> void
+    {
+        if (UNLIKELY(size > std::numeric_limits<uint32_t>::max())) {
+            throw std::length_error("container too large for config cache");
+        }
+
+        put(static_cast<uint32_t>(size));
+    }
+
+    auto put(const std::string &s) -> void
+    {
+        put_size(s.size());
+        put_raw(s.data(), s.size());
+    }
+
+    auto put(const std::filesystem::path &p) -> void { put(p.native()); }
+
+    template <typename T>
+    auto put(const std::optional<T> &o) -> void
+    {
+        put(o.has_value());
+        if (o) {
+            put(*o);
+        }
+    }
+
+    template <typename T>
+    auto put(const std::vector<T> &vec) -> void
+    {
+        put_size(vec.size());
+        for (const auto &v : vec) {
+            put(v);
+        }
+    }
+
+    template <typename K, typename V>
+    auto put(const std::unordered_map<K, V> &map) -> void
+    {
+        // iteration order depends on insertion history, sort to keep the
+        // encoding canonical so equal configs always encode equally
+        std::vector<const typename std::unordered_map<K, V>::value_type *> entries;
+        entries.reserve(map.size());
+        for (const auto &entry : map) {
+            entries.push_back(&entry);
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const auto *lhs, const auto *rhs) {
+            return lhs->first < rhs->first;
+        });
+
+        put_size(entries.size());
+        for (const auto *entry : entries) {
+            put(entry->first);
+            put(entry->second);
+        }
+    }
+
+    template <typename T>
+    auto put(const T &v) -> void
+    {
+        if constexpr (std::is_enum_v<T>) {
+            put(static_cast<std::underlying_type_t<T>>(v));
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            put_raw(&v, sizeof(T));
+        } else {
+            visit_fields(*this, v);
+        }
+    }
+};
+
+class reader
+{
+public:
+    explicit reader(utils::span<const std::byte> data) noexcept
+        : data(data)
+    {
+    }
+
+    template <typename... T>
+    auto operator()(T &...values) -> void
+    {
+        (get(values), ...);
+    }
+
+    [[nodiscard]] auto exhausted() const noexcept -> bool { return offset == data.size(); }
+
+private:
+    utils::span<const std::byte> data;
+    std::size_t offset{ 0 };
+
+    auto get_raw(void *out, std::size_t size) -> void
+    {
+        if (UNLIKELY(size > data.size() - offset)) {
+            throw std::runtime_error("config cache is truncated");
+        }
+
+        std::memcpy(out, data.data() + offset, size);
+        offset += size;
+    }
+
+    // Every encoded element takes at least one byte, so a count larger than the
+    // remaining payload is corrupt and must be rejected before allocating.
+    auto get_size() -> std::size_t
+    {
+        uint32_t size{ 0 };
+        get(size);
+        if (UNLIKELY(size > data.size() - offset)) {
+            throw std::runtime_error("config cache is truncated");
+        }
+
+        return size;
+    }
+
+    auto get(std::string &s) -> void
+    {
+        const auto size = get_size();
+        s.assign(reinterpret_cast<const char *>(data.data() + offset), size);
+        offset += size;
+    }
+
+    auto get(std::filesystem::path &p) -> void
+    {
+        std::string s;
+        get(s);
+        p = std::move(s);
+    }
+
+    template <typename T>
+    auto get(std::optional<T> &o) -> void
+    {
+        bool has_value{ false };
+        get(has_value);
+        if (!has_value) {
+            o.reset();
+            return;
+        }
+
+        get(o.emplace());
+    }
+
+    template <typename T>
+    auto get(std::vector<T> &vec) -> void
+    {
+        const auto size = get_size();
+        vec.clear();
+        vec.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            get(vec.emplace_back());
+        }
+    }
+
+    template <typename K, typename V>
+    auto get(std::unordered_map<K, V> &map) -> void
+    {
+        const auto size = get_size();
+        map.clear();
+        map.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            K k{ };
+            get(k);
+            get(map[std::move(k)]);
+        }
+    }
+
+    template <typename T>
+    auto get(T &v) -> void
+    {
+        if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> raw{ };
+            get(raw);
+            v = static_cast<T>(raw);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            uint8_t raw{ };
+            get_raw(&raw, sizeof(raw));
+            if (UNLIKELY(raw > 1)) {
+                throw std::runtime_error("config cache contains an invalid boolean");
+            }
+            v = raw != 0;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            get_raw(&v, sizeof(T));
+        } else {
+            visit_fields(*this, v);
+        }
+    }
+};
+
+auto read_file(utils::file_descriptor_ref fd, const struct stat &st)
+  -> utils::uninit_vector<std::byte>
+{
+    utils::uninit_vector<std::byte> buf;
+    buf.reserve(static_cast<std::size_t>(st.st_size));
+    std::ignore = os::throw_if_error(io::read_to_end(fd, buf));
+    return buf;
+}
+
+auto load(const std::filesystem::path &cache, const cache_key &key) -> std::optional<oci_config>
+{
+    auto fd = os::open(cache, { os::sys::open_flag::cloexec, os::sys::access_mode::read_only });
+    if (!fd) {
+        return std::nullopt;
+    }
+
+    const auto st = os::throw_if_error(os::fstat(fd->ref()));
+    if (is_racy(key, st)) {
+        return std::nullopt;
+    }
+
+    utils::uninit_vector<std::byte> buf;
+    std::ignore = os::throw_if_error(io::read_to_end(fd->ref(), buf));
+
+    cache_header header{ };
+    if (buf.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+
+    std::memcpy(&header, buf.data(), sizeof(header));
+    if (header.magic != cache_magic || header.version != cache_format_version
+        || !(header.key == key) || header.payload_size != buf.size() - sizeof(header)) {
+        return std::nullopt;
+    }
+
+    return deserialize(utils::span<const std::byte>{ buf.data() + sizeof(header),
+                                                     buf.size() - sizeof(header) });
+}
+
+auto store(const std::filesystem::path &cache, const cache_key &key, const oci_config &config)
+  -> void
+{
+    auto payload = serialize(config);
+    const cache_header header{ cache_magic, cache_format_version, key, payload.size() };
+
+    std::filesystem::create_directories(cache.parent_path());
+
+    // write to a unique temporary file then rename over the old cache, readers
+    // never observe a partially written cache
+    auto temp = cache;
+    temp += ".tmp-" + utils::gen_random_string(6);
+    auto fd = os::throw_if_error(
+      os::open(temp,
+               { os::sys::open_flag::create | os::sys::open_flag::exclusive
+                   | os::sys::open_flag::cloexec | os::sys::open_flag::no_follow,
+                 os::sys::access_mode::write_only },
+               std::filesystem::perms::owner_read | std::filesystem::perms::owner_write));
+    auto cleanup = utils::make_errdefer([&temp]() noexcept {
+        std::error_code ec;
+        std::filesystem::remove(temp, ec);
+    });
+
+    os::throw_if_error(io::write_all(
+      fd.ref(),
+      utils::span<const std::byte>{ reinterpret_cast<const std::byte *>(&header),
+                                    sizeof(header) }));
+    os::throw_if_error(io::write_all(fd.ref(), payload));
+    std::filesystem::rename(temp, cache);
+}
+
+} // namespace
+
+auto serialize(const oci_config &config) -> std::vector<std::byte>
+{
+    writer w;
+    w(config);
+    return std::move(w).take();
+}
+
+auto serialize(const oci_config::linux_t::seccomp_t &seccomp) -> std::vector<std::byte>
+{
+    writer w;
+    w(seccomp);
+    return std::move(w).take();
+}
+
+auto deserialize(utils::span<const std::byte> data) -> oci_config
+{
+    reader r{ data };
+    oci_config config;
+    r(config);
+    if (UNLIKELY(!r.exhausted())) {
+        throw std::runtime_error("config cache has trailing data");
+    }
+
+    return config;
+}
+
+auto prune_cache_dir(const std::filesystem::path &dir, std::size_t max_entries) noexcept -> void
+{
+    try {
+        std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+        for (const auto &entry : std::filesystem::directory_iterator{ dir }) {
+            std::error_code ec;
+            if (!entry.is_regular_file(ec)) {
+                continue;
+            }
+
+            auto mtime = entry.last_write_time(ec);
+            if (!ec) {
+                entries.emplace_back(mtime, entry.path());
+            }
+        }
+
+        if (entries.size() <= max_entries) {
+            return;
+        }
+
+        const auto newest = entries.begin() + static_cast<std::ptrdiff_t>(max_entries);
+        std::nth_element(entries.begin(), newest, entries.end(), [](const auto &a, const auto &b) {
+            return a.first > b.first;
+        });
+
+        // concurrent runs may prune the same files, a missing file is fine
+        for (auto it = newest; it != entries.end(); ++it) {
+            std::error_code ec;
+            std::filesystem::remove(it->second, ec);
+        }
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_DEBUG("failed to prune cache directory {}: {}", dir, e.what());
+    }
+}
+
+auto parse_cached(const std::filesystem::path &path,
+                  const std::filesystem::path &cache,
+                  std::size_t max_entries) -> oci_config
+{
+    // the key only needs fstat, config.json itself is read on a miss
+    auto fd = os::throw_if_error(
+      os::open(path, { os::sys::open_flag::cloexec, os::sys::access_mode::read_only }));
+    const auto st = os::throw_if_error(os::fstat(fd.ref()));
+    const auto key = make_key(st);
+
+    try {
+        if (auto config = load(cache, key); config) {
+            LINYAPS_BOX_LOG_DEBUG("load oci_config {} from cache {}", path, cache);
+            return std::move(config).value();
+        }
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_DEBUG("ignore broken config cache {}: {}", cache, e.what());
+    }
+
+    // only configs that pass validation are ever stored, so a cache hit
+    // implies the validation result as well
+    const auto content = read_file(fd.ref(), st);
+    auto config = oci_config::parse(
+      std::string_view{ reinterpret_cast<const char *>(content.data()), content.size() });
+
+    try {
+        store(cache, key, config);
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_DEBUG("failed to update config cache {}: {}", cache, e.what());
+    }
+
+    if (max_entries != 0) {
+        prune_cache_dir(cache.parent_path(), max_entries);
+    }
+
+    return config;
+}
+
+} // namespace linyaps_box::config
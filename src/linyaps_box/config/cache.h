@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+#include "linyaps_box/utils/span.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace linyaps_box::config {
+
+// Compact binary form of an already validated oci_config. The encoding is
+// private to one ll-box build: it follows the member order of oci_config and
+// carries no field names, so bump cache_format_version whenever any member of
+// oci_config is added, removed or reordered.
+[[nodiscard]] auto serialize(const oci_config &config) -> std::vector<std::byte>;
+
+// The same encoding for the seccomp section alone, it keys compiled filters.
+[[nodiscard]] auto serialize(const oci_config::linux_t::seccomp_t &seccomp)
+  -> std::vector<std::byte>;
+
+// Throws std::runtime_error if data is truncated or otherwise malformed.
+[[nodiscard]] auto deserialize(utils::span<const std::byte> data) -> oci_config;
+
+// How many files the cache directory shared by all runs keeps, it otherwise
+// collects one entry for every config path and seccomp policy ever launched.
+constexpr std::size_t shared_cache_entries = 64;
+
+// Remove all but the max_entries most recently written files of dir. Only for
+// directories that hold nothing but caches, failures are only logged.
+auto prune_cache_dir(const std::filesystem::path &dir, std::size_t max_entries) noexcept -> void;
+
+// Parse and validate the config at path, reusing the cache file when it was
+// produced from the very same file (device, inode, size, mtime and ctime all
+// match). On a miss the config is parsed from JSON and the cache is refreshed.
+// Cache failures are never fatal, they only fall back to a regular parse.
+// A non-zero max_entries marks the directory of cache as shared, it is pruned
+// to that many entries whenever a new cache is stored.
+[[nodiscard]] auto parse_cached(const std::filesystem::path &path,
+                                const std::filesystem::path &cache,
+                                std::size_t max_entries = 0) -> oci_config;
+
+} // namespace linyaps_box::config
@@ -76,9 +76,9 @@ constexpr std::array<flag_entry, 8> propagation{ {
 // Values use MOUNT_ATTR_* (kernel 5.12+).  These are consumed from mount options
 // and NOT passed to mount(2).
 //
-// TODO: implement mount_setattr.  ATIME field handling: when any ATIME bit is
-//       set/cleared, MOUNT_ATTR__ATIME must appear in attr_clr to reset the
-//       field before applying the new mode.
+// ATIME field handling: when any ATIME bit is set/cleared, MOUNT_ATTR__ATIME
+// must appear in attr_clr to reset the field before applying the new mode,
+// the container mounter takes care of that.
 constexpr std::array<flag_entry, 9> recursive_attr_set{ {
   { static_cast<unsigned long>(os::sys::mount_attr_rdonly), "rro" },
   { static_cast<unsigned long>(os::sys::mount_attr_nosuid), "rnosuid" },
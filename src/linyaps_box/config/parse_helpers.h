@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <sys/mount.h>
+
+// Value level helpers shared by the DOM based from_json overloads and the
+// streaming parser, so both accept exactly the same spelling of each field.
+namespace linyaps_box::config {
+
+// Used when linux.rootfsPropagation is absent or null.
+constexpr unsigned long default_rootfs_propagation = MS_PRIVATE | MS_REC;
+
+// Parse a cpuset style list such as "0-3,7".
+[[nodiscard]] auto parse_range_list(std::string_view s) -> std::vector<unsigned int>;
+
+// Map "private", "rslave", ... to the mount(2) propagation flags.
+[[nodiscard]] auto parse_rootfs_propagation(std::string_view name) -> unsigned long;
+
+// Split the options of a mount entry into the fields of oci_config::mount_t,
+// in member order starting at vfs_flags.
+[[nodiscard]] auto parse_mount_options(const std::vector<std::string> &options)
+  -> std::tuple<unsigned long,
+                unsigned long,
+                std::optional<oci_config::mount_t::recursive_attr>,
+                oci_config::mount_t::extension,
+                std::optional<oci_config::mount_t::idmap_type>,
+                std::optional<std::vector<oci_config::id_mapping_t>>,
+                std::optional<std::vector<oci_config::id_mapping_t>>,
+                std::string>;
+
+} // namespace linyaps_box::config
@@ -0,0 +1,1829 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/config/parser.h"
+
+#include "linyaps_box/config/enum_tables.h"
+#include "linyaps_box/config/parse_helpers.h"
+#include "linyaps_box/utils/enum_traits.h"
+#include "linyaps_box/utils/semver.h"
+#include "linyaps_box/utils/utils.h"
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace linyaps_box::config {
+
+namespace {
+
+// Pull style JSON tokenizer over a complete document. Strings without escapes
+// are returned as views into the input, so reading keys and skipping values
+// never allocates.
+class json_cursor
+{
+public:
+    enum class kind : std::uint8_t { object, array, string, number, boolean, null };
+
+    explicit json_cursor(std::string_view input) noexcept
+        : input(input)
+    {
+    }
+
+    [[nodiscard]] auto peek() -> kind
+    {
+        skip_whitespace();
+        if (UNLIKELY(pos == input.size())) {
+            fail("unexpected end of input");
+        }
+
+        switch (input[pos]) {
+        case '{':
+            return kind::object;
+        case '[':
+            return kind::array;
+        case '"':
+            return kind::string;
+        case 't':
+        case 'f':
+            return kind::boolean;
+        case 'n':
+            return kind::null;
+        default:
+            break;
+        }
+
+        if (input[pos] == '-' || is_digit(input[pos])) {
+            return kind::number;
+        }
+
+        fail("unexpected character");
+    }
+
+    auto consume_null() -> bool
+    {
+        if (peek() != kind::null) {
+            return false;
+        }
+
+        expect_literal("null");
+        return true;
+    }
+
+    [[nodiscard]] auto read_bool() -> bool
+    {
+        if (UNLIKELY(peek() != kind::boolean)) {
+            fail("expected boolean");
+        }
+
+        if (input[pos] == 't') {
+            expect_literal("true");
+            return true;
+        }
+
+        expect_literal("false");
+        return false;
+    }
+
+    template <typename T>
+    [[nodiscard]] auto read_integer() -> T
+    {
+        if (UNLIKELY(peek() != kind::number)) {
+            fail("expected number");
+        }
+
+        const auto begin = pos;
+        if (UNLIKELY(!scan_number())) {
+            fail_at(begin, "expected integer");
+        }
+
+        T value{ };
+        const auto *last = input.data() + pos;
+        auto [ptr, ec] = std::from_chars(input.data() + begin, last, value);
+        if (UNLIKELY(ec != std::errc{ } || ptr != last)) {
+            fail_at(begin, "integer out of range");
+        }
+
+        return value;
+    }
+
+    // The view is only valid until the next read from this cursor.
+    [[nodiscard]] auto read_string_view() -> std::string_view
+    {
+        if (UNLIKELY(peek() != kind::string)) {
+            fail("expected string");
+        }
+
+        const auto begin = ++pos;
+        while (pos < input.size()) {
+            const auto c = static_cast<unsigned char>(input[pos]);
+            if (c == '"') {
+                return input.substr(begin, pos++ - begin);
+            }
+
+            if (c == '\\') {
+                scratch.assign(input.data() + begin, pos - begin);
+                finish_string(&scratch);
+                return scratch;
+            }
+
+            if (UNLIKELY(c < 0x20)) {
+                fail("control character in string");
+            }
+
+            ++pos;
+        }
+
+        fail("unterminated string");
+    }
+
+    [[nodiscard]] auto read_string() -> std::string { return std::string{ read_string_view() }; }
+
+    // on_member(key) must consume the value, key is only valid until then.
+    template <typename Fn>
+    auto read_object(Fn &&on_member) -> void
+    {
+        if (!open('}', kind::object, "expected object")) {
+            return;
+        }
+
+        do {
+            const auto key = read_string_view();
+            expect(':');
+            on_member(key);
+        } while (next('}'));
+    }
+
+    // on_element() must consume exactly one value.
+    template <typename Fn>
+    auto read_array(Fn &&on_element) -> void
+    {
+        if (!open(']', kind::array, "expected array")) {
+            return;
+        }
+
+        do {
+            on_element();
+        } while (next(']'));
+    }
+
+    // Validates the skipped value but never materializes it.
+    auto skip_value() -> void
+    {
+        switch (peek()) {
+        case kind::object:
+            if (open('}', kind::object, "expected object")) {
+                do {
+                    if (UNLIKELY(peek() != kind::string)) {
+                        fail("expected string");
+                    }
+
+                    ++pos;
+                    finish_string(nullptr);
+                    expect(':');
+                    skip_value();
+                } while (next('}'));
+            }
+            break;
+        case kind::array:
+            if (open(']', kind::array, "expected array")) {
+                do {
+                    skip_value();
+                } while (next(']'));
+            }
+            break;
+        case kind::string:
+            ++pos;
+            finish_string(nullptr);
+            break;
+        case kind::number:
+            std::ignore = scan_number();
+            break;
+        case kind::boolean:
+            std::ignore = read_bool();
+            break;
+        case kind::null:
+            std::ignore = consume_null();
+            break;
+        }
+    }
+
+    auto finish() -> void
+    {
+        skip_whitespace();
+        if (UNLIKELY(pos != input.size())) {
+            fail("unexpected trailing characters");
+        }
+    }
+
+    [[noreturn]] auto fail(std::string_view what) const -> void { fail_at(pos, what); }
+
+private:
+    // deep enough for any sane config while keeping the recursion bounded
+    static constexpr unsigned max_depth = 256;
+
+    std::string_view input;
+    std::size_t pos{ 0 };
+    unsigned depth{ 0 };
+    std::string scratch;
+
+    [[noreturn]] auto fail_at(std::size_t offset, std::string_view what) const -> void
+    {
+        throw std::runtime_error(fmt::format("invalid OCI config at offset {}: {}", offset, what));
+    }
+
+    static constexpr auto is_digit(char c) noexcept -> bool { return c >= '0' && c <= '9'; }
+
+    auto skip_whitespace() noexcept -> void
+    {
+        while (pos < input.size()
+               && (input[pos] == ' ' || input[pos] == '\n' || input[pos] == '\r'
+                   || input[pos] == '\t')) {
+            ++pos;
+        }
+    }
+
+    auto expect(char c) -> void
+    {
+        skip_whitespace();
+        if (UNLIKELY(pos == input.size() || input[pos] != c)) {
+            fail(fmt::format("expected '{}'", c));
+        }
+
+        ++pos;
+    }
+
+    auto expect_literal(std::string_view literal) -> void
+    {
+        if (UNLIKELY(input.substr(pos, literal.size()) != literal)) {
+            fail("invalid literal");
+        }
+
+        pos += literal.size();
+    }
+
+    // Returns false for an empty container, which is consumed entirely.
+    auto open(char close, kind expected, std::string_view what) -> bool
+    {
+        if (UNLIKELY(peek() != expected)) {
+            fail(what);
+        }
+
+        if (UNLIKELY(++depth > max_depth)) {
+            fail("nesting too deep");
+        }
+
+        ++pos;
+        skip_whitespace();
+        if (pos < input.size() && input[pos] == close) {
+            ++pos;
+            --depth;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Consume the separator after an element, false once the container is closed.
+    auto next(char close) -> bool
+    {
+        skip_whitespace();
+        if (pos < input.size()) {
+            if (input[pos] == ',') {
+                ++pos;
+                return true;
+            }
+
+            if (input[pos] == close) {
+                ++pos;
+                --depth;
+                return false;
+            }
+        }
+
+        fail(fmt::format("expected ',' or '{}'", close));
+    }
+
+    // Returns true if the number has neither a fraction nor an exponent.
+    auto scan_number() -> bool
+    {
+        const auto digits = [this]() {
+            const auto begin = pos;
+            while (pos < input.size() && is_digit(input[pos])) {
+                ++pos;
+            }
+
+            if (UNLIKELY(pos == begin)) {
+                fail("invalid number");
+            }
+        };
+
+        if (input[pos] == '-') {
+            ++pos;
+        }
+
+        if (pos < input.size() && input[pos] == '0') {
+            ++pos;
+        } else {
+            digits();
+        }
+
+        auto integer = true;
+        if (pos < input.size() && input[pos] == '.') {
+            ++pos;
+            digits();
+            integer = false;
+        }
+
+        if (pos < input.size() && (input[pos] == 'e' || input[pos] == 'E')) {
+            ++pos;
+            if (pos < input.size() && (input[pos] == '+' || input[pos] == '-')) {
+                ++pos;
+            }
+
+            digits();
+            integer = false;
+        }
+
+        return integer;
+    }
+
+    auto read_hex4() -> std::uint32_t
+    {
+        if (UNLIKELY(input.size() - pos < 4)) {
+            fail("invalid unicode escape");
+        }
+
+        std::uint32_t value{ 0 };
+        auto [ptr, ec] = std::from_chars(input.data() + pos, input.data() + pos + 4, value, 16);
+        if (UNLIKELY(ec != std::errc{ } || ptr != input.data() + pos + 4)) {
+            fail("invalid unicode escape");
+        }
+
+        pos += 4;
+        return value;
+    }
+
+    static auto append_utf8(std::string &out, std::uint32_t cp) -> void
+    {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    auto read_escape(std::string *out) -> void
+    {
+        if (UNLIKELY(++pos == input.size())) {
+            fail("unterminated string");
+        }
+
+        char c{ };
+        switch (input[pos++]) {
+        case '"':
+            c = '"';
+            break;
+        case '\\':
+            c = '\\';
+            break;
+        case '/':
+            c = '/';
+            break;
+        case 'b':
+            c = '\b';
+            break;
+        case 'f':
+            c = '\f';
+            break;
+        case 'n':
+            c = '\n';
+            break;
+        case 'r':
+            c = '\r';
+            break;
+        case 't':
+            c = '\t';
+            break;
+        case 'u': {
+            auto cp = read_hex4();
+            if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                fail("unpaired surrogate in unicode escape");
+            }
+
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                if (UNLIKELY(input.substr(pos, 2) != "\\u")) {
+                    fail("unpaired surrogate in unicode escape");
+                }
+
+                pos += 2;
+                const auto low = read_hex4();
+                if (UNLIKELY(low < 0xDC00 || low > 0xDFFF)) {
+                    fail("unpaired surrogate in unicode escape");
+                }
+
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            }
+
+            if (out != nullptr) {
+                append_utf8(*out, cp);
+            }
+            return;
+        }
+        default:
+            fail("invalid escape sequence");
+        }
+
+        if (out != nullptr) {
+            out->push_back(c);
+        }
+    }
+
+    // Continue a string at pos (just after the opening quote or at the first
+    // escape), appending the decoded characters to out unless it is null.
+    auto finish_string(std::string *out) -> void
+    {
+        while (pos < input.size()) {
+            const auto begin = pos;
+            while (pos < input.size() && input[pos] != '"' && input[pos] != '\\'
+                   && static_cast<unsigned char>(input[pos]) >= 0x20) {
+                ++pos;
+            }
+
+            if (out != nullptr) {
+                out->append(input.data() + begin, pos - begin);
+            }
+
+            if (pos == input.size()) {
+                break;
+            }
+
+            if (input[pos] == '"') {
+                ++pos;
+                return;
+            }
+
+            if (UNLIKELY(input[pos] != '\\')) {
+                fail("control character in string");
+            }
+
+            read_escape(out);
+        }
+
+        fail("unterminated string");
+    }
+};
+
+// Every object is read through a key enum with a constexpr name table, unknown
+// keys are skipped. Returns the set of keys seen, one bit per enumerator.
+template <typename Key, typename Fn>
+auto read_fields(json_cursor &cur, Fn &&on_field) -> std::uint64_t
+{
+    std::uint64_t seen{ 0 };
+    cur.read_object([&cur, &on_field, &seen](std::string_view name) {
+        constexpr auto table = get_enum_table(static_cast<Key *>(nullptr));
+        static_assert(table.entries.size() <= 64);
+
+        const auto key = table.from_name(name);
+        if (!key) {
+            cur.skip_value();
+            return;
+        }
+
+        seen |= std::uint64_t{ 1 } << static_cast<unsigned>(*key);
+        on_field(*key);
+    });
+
+    return seen;
+}
+
+template <typename Key>
+auto require(std::uint64_t seen, std::initializer_list<Key> keys, std::string_view object) -> void
+{
+    constexpr auto table = get_enum_table(static_cast<Key *>(nullptr));
+    for (auto key : keys) {
+        if (UNLIKELY((seen & (std::uint64_t{ 1 } << static_cast<unsigned>(key))) == 0)) {
+            throw std::runtime_error(fmt::format("key '{}' not found in {}",
+                                                 table.to_name(key).value_or("<unknown>"),
+                                                 object));
+        }
+    }
+}
+
+// The OCI enum tables live at global scope, see enum_tables.h.
+template <typename E>
+auto read_enum(json_cursor &cur, std::string_view error = "unknown value: ") -> E
+{
+    constexpr auto table = ::get_enum_table(static_cast<E *>(nullptr));
+    const auto name = cur.read_string_view();
+    const auto value = table.from_name(name);
+    if (UNLIKELY(!value)) {
+        throw std::runtime_error(std::string{ error }.append(name));
+    }
+
+    return *value;
+}
+
+template <typename E>
+auto read_flags(json_cursor &cur) -> E
+{
+    E flags{ };
+    cur.read_array([&cur, &flags]() {
+        flags = flags | read_enum<E>(cur);
+    });
+
+    return flags;
+}
+
+template <typename T>
+auto read(json_cursor &cur, T &v)
+  -> std::enable_if_t<std::is_arithmetic_v<T> || std::is_same_v<T, std::filesystem::perms>>
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        v = cur.read_bool();
+    } else if constexpr (std::is_enum_v<T>) {
+        v = static_cast<T>(cur.template read_integer<std::underlying_type_t<T>>());
+    } else {
+        v = cur.template read_integer<T>();
+    }
+}
+
+auto read(json_cursor &cur, std::string &v) -> void
+{
+    v = cur.read_string_view();
+}
+
+auto read(json_cursor &cur, std::filesystem::path &v) -> void
+{
+    v = cur.read_string_view();
+}
+
+// Overloads for the oci_config types are found through ADL on json_cursor.
+template <typename T>
+auto read(json_cursor &cur, std::optional<T> &v) -> void
+{
+    if (cur.consume_null()) {
+        v.reset();
+        return;
+    }
+
+    read(cur, v.emplace());
+}
+
+template <typename T>
+auto read(json_cursor &cur, std::vector<T> &v) -> void
+{
+    v.clear();
+    cur.read_array([&cur, &v]() {
+        read(cur, v.emplace_back());
+    });
+}
+
+template <typename T>
+auto read(json_cursor &cur, std::unordered_map<std::string, T> &v) -> void
+{
+    v.clear();
+    cur.read_object([&cur, &v](std::string_view key) {
+        read(cur, v[std::string{ key }]);
+    });
+}
+
+auto read_range_list(json_cursor &cur, std::optional<std::vector<unsigned int>> &v) -> void
+{
+    if (cur.consume_null()) {
+        v.reset();
+        return;
+    }
+
+    v = parse_range_list(cur.read_string_view());
+}
+
+// --- process ---
+
+enum class console_size_key : std::uint8_t { height, width };
+LINYAPS_REGISTER_ENUM(console_size_key,
+                      { console_size_key::height, "height" },
+                      { console_size_key::width, "width" })
+
+auto read(json_cursor &cur, oci_config::process_t::console_size_t &v) -> void
+{
+    const auto seen = read_fields<console_size_key>(cur, [&cur, &v](console_size_key key) {
+        switch (key) {
+        case console_size_key::height:
+            return read(cur, v.height);
+        case console_size_key::width:
+            return read(cur, v.width);
+        }
+    });
+
+    require(seen, { console_size_key::height, console_size_key::width }, "consoleSize");
+}
+
+enum class rlimit_key : std::uint8_t { type, soft, hard };
+LINYAPS_REGISTER_ENUM(rlimit_key,
+                      { rlimit_key::type, "type" },
+                      { rlimit_key::soft, "soft" },
+                      { rlimit_key::hard, "hard" })
+
+auto read(json_cursor &cur, oci_config::process_t::rlimit_t &v) -> void
+{
+    const auto seen = read_fields<rlimit_key>(cur, [&cur, &v](rlimit_key key) {
+        switch (key) {
+        case rlimit_key::type:
+            v.type = read_enum<oci_config::process_t::rlimit_t::type_t>(cur);
+            return;
+        case rlimit_key::soft:
+            return read(cur, v.soft);
+        case rlimit_key::hard:
+            return read(cur, v.hard);
+        }
+    });
+
+    require(seen, { rlimit_key::type, rlimit_key::soft, rlimit_key::hard }, "rlimit");
+}
+
+enum class user_key : std::uint8_t { uid, gid, umask, additional_gids };
+LINYAPS_REGISTER_ENUM(user_key,
+                      { user_key::uid, "uid" },
+                      { user_key::gid, "gid" },
+                      { user_key::umask, "umask" },
+                      { user_key::additional_gids, "additionalGids" })
+
+auto read(json_cursor &cur, oci_config::process_t::user_t &v) -> void
+{
+    const auto seen = read_fields<user_key>(cur, [&cur, &v](user_key key) {
+        switch (key) {
+        case user_key::uid:
+            return read(cur, v.uid);
+        case user_key::gid:
+            return read(cur, v.gid);
+        case user_key::umask:
+            return read(cur, v.umask);
+        case user_key::additional_gids:
+            return read(cur, v.additional_gids);
+        }
+    });
+
+    require(seen, { user_key::uid, user_key::gid }, "user");
+}
+
+enum class capabilities_key : std::uint8_t { effective, bounding, inheritable, permitted, ambient };
+LINYAPS_REGISTER_ENUM(capabilities_key,
+                      { capabilities_key::effective, "effective" },
+                      { capabilities_key::bounding, "bounding" },
+                      { capabilities_key::inheritable, "inheritable" },
+                      { capabilities_key::permitted, "permitted" },
+                      { capabilities_key::ambient, "ambient" })
+
+auto read(json_cursor &cur, oci_config::process_t::capabilities_t &v) -> void
+{
+    std::ignore = read_fields<capabilities_key>(cur, [&cur, &v](capabilities_key key) {
+        switch (key) {
+        case capabilities_key::effective:
+            return read(cur, v.effective);
+        case capabilities_key::bounding:
+            return read(cur, v.bounding);
+        case capabilities_key::inheritable:
+            return read(cur, v.inheritable);
+        case capabilities_key::permitted:
+            return read(cur, v.permitted);
+        case capabilities_key::ambient:
+            return read(cur, v.ambient);
+        }
+    });
+}
+
+enum class scheduler_key : std::uint8_t {
+    policy,
+    nice,
+    priority,
+    flags,
+    runtime,
+    deadline,
+    period,
+};
+LINYAPS_REGISTER_ENUM(scheduler_key,
+                      { scheduler_key::policy, "policy" },
+                      { scheduler_key::nice, "nice" },
+                      { scheduler_key::priority, "priority" },
+                      { scheduler_key::flags, "flags" },
+                      { scheduler_key::runtime, "runtime" },
+                      { scheduler_key::deadline, "deadline" },
+                      { scheduler_key::period, "period" })
+
+auto read(json_cursor &cur, oci_config::process_t::scheduler_t &v) -> void
+{
+    using scheduler_t = oci_config::process_t::scheduler_t;
+
+    const auto seen = read_fields<scheduler_key>(cur, [&cur, &v](scheduler_key key) {
+        switch (key) {
+        case scheduler_key::policy:
+            v.policy = read_enum<scheduler_t::policy_t>(cur);
+            return;
+        case scheduler_key::nice:
+            return read(cur, v.nice);
+        case scheduler_key::priority:
+            return read(cur, v.priority);
+        case scheduler_key::flags:
+            if (cur.consume_null()) {
+                v.flags.reset();
+                return;
+            }
+
+            v.flags = read_flags<scheduler_t::flag_t>(cur);
+            return;
+        case scheduler_key::runtime:
+            return read(cur, v.runtime);
+        case scheduler_key::deadline:
+            return read(cur, v.deadline);
+        case scheduler_key::period:
+            return read(cur, v.period);
+        }
+    });
+
+    require(seen, { scheduler_key::policy }, "scheduler");
+}
+
+enum class io_priority_key : std::uint8_t { class_, priority };
+LINYAPS_REGISTER_ENUM(io_priority_key,
+                      { io_priority_key::class_, "class" },
+                      { io_priority_key::priority, "priority" })
+
+auto read(json_cursor &cur, oci_config::process_t::io_priority_t &v) -> void
+{
+    v.priority = 0;
+    const auto seen = read_fields<io_priority_key>(cur, [&cur, &v](io_priority_key key) {
+        switch (key) {
+        case io_priority_key::class_:
+            v.class_ = read_enum<oci_config::process_t::io_priority_t::class_t>(cur);
+            return;
+        case io_priority_key::priority:
+            return read(cur, v.priority);
+        }
+    });
+
+    require(seen, { io_priority_key::class_ }, "ioPriority");
+}
+
+enum class exec_cpu_affinity_key : std::uint8_t { initial, final };
+LINYAPS_REGISTER_ENUM(exec_cpu_affinity_key,
+                      { exec_cpu_affinity_key::initial, "initial" },
+                      { exec_cpu_affinity_key::final, "final" })
+
+auto read(json_cursor &cur, oci_config::process_t::exec_cpu_affinity_t &v) -> void
+{
+    std::ignore = read_fields<exec_cpu_affinity_key>(cur, [&cur, &v](exec_cpu_affinity_key key) {
+        switch (key) {
+        case exec_cpu_affinity_key::initial:
+            return read(cur, v.initial);
+        case exec_cpu_affinity_key::final:
+            return read(cur, v.final);
+        }
+    });
+}
+
+enum class process_key : std::uint8_t {
+    terminal,
+    console_size,
+    cwd,
+    env,
+    args,
+    rlimits,
+    apparmor_profile,
+    capabilities,
+    no_new_privileges,
+    oom_score_adj,
+    scheduler,
+    selinux_label,
+    io_priority,
+    exec_cpu_affinity,
+    user,
+};
+LINYAPS_REGISTER_ENUM(process_key,
+                      { process_key::terminal, "terminal" },
+                      { process_key::console_size, "consoleSize" },
+                      { process_key::cwd, "cwd" },
+                      { process_key::env, "env" },
+                      { process_key::args, "args" },
+                      { process_key::rlimits, "rlimits" },
+                      { process_key::apparmor_profile, "apparmorProfile" },
+                      { process_key::capabilities, "capabilities" },
+                      { process_key::no_new_privileges, "noNewPrivileges" },
+                      { process_key::oom_score_adj, "oomScoreAdj" },
+                      { process_key::scheduler, "scheduler" },
+                      { process_key::selinux_label, "selinuxLabel" },
+                      { process_key::io_priority, "ioPriority" },
+                      { process_key::exec_cpu_affinity, "execCPUAffinity" },
+                      { process_key::user, "user" })
+
+auto read(json_cursor &cur, oci_config::process_t &v) -> void
+{
+    const auto seen = read_fields<process_key>(cur, [&cur, &v](process_key key) {
+        switch (key) {
+        case process_key::terminal:
+            return read(cur, v.terminal);
+        case process_key::console_size:
+            return read(cur, v.console_size);
+        case process_key::cwd:
+            return read(cur, v.cwd);
+        case process_key::env:
+            return read(cur, v.env);
+        case process_key::args:
+            return read(cur, v.args);
+        case process_key::rlimits:
+            return read(cur, v.rlimits);
+        case process_key::apparmor_profile:
+            return read(cur, v.apparmor_profile);
+        case process_key::capabilities:
+            return read(cur, v.capabilities);
+        case process_key::no_new_privileges:
+            return read(cur, v.no_new_privileges);
+        case process_key::oom_score_adj:
+            return read(cur, v.oom_score_adj);
+        case process_key::scheduler:
+            return read(cur, v.scheduler);
+        case process_key::selinux_label:
+            return read(cur, v.selinux_label);
+        case process_key::io_priority:
+            return read(cur, v.io_priority);
+        case process_key::exec_cpu_affinity:
+            return read(cur, v.exec_cpu_affinity);
+        case process_key::user:
+            if (cur.consume_null()) {
+                v.user = { };
+                return;
+            }
+
+            return read(cur, v.user);
+        }
+    });
+
+    require(seen, { process_key::cwd, process_key::args }, "process");
+
+    // consoleSize only matters with a terminal, the key may precede "terminal"
+    if (!v.terminal.value_or(false)) {
+        v.console_size.reset();
+    }
+}
+
+// --- mounts ---
+
+enum class id_mapping_key : std::uint8_t { host_id, container_id, size };
+LINYAPS_REGISTER_ENUM(id_mapping_key,
+                      { id_mapping_key::host_id, "hostID" },
+                      { id_mapping_key::container_id, "containerID" },
+                      { id_mapping_key::size, "size" })
+
+auto read(json_cursor &cur, oci_config::id_mapping_t &v) -> void
+{
+    const auto seen = read_fields<id_mapping_key>(cur, [&cur, &v](id_mapping_key key) {
+        switch (key) {
+        case id_mapping_key::host_id:
+            return read(cur, v.host_id);
+        case id_mapping_key::container_id:
+            return read(cur, v.container_id);
+        case id_mapping_key::size:
+            return read(cur, v.size);
+        }
+    });
+
+    require(seen,
+            { id_mapping_key::host_id, id_mapping_key::container_id, id_mapping_key::size },
+            "id mapping");
+}
+
+enum class mount_key : std::uint8_t {
+    destination,
+    source,
+    type,
+    uid_mappings,
+    gid_mappings,
+    options,
+};
+LINYAPS_REGISTER_ENUM(mount_key,
+                      { mount_key::destination, "destination" },
+                      { mount_key::source, "source" },
+                      { mount_key::type, "type" },
+                      { mount_key::uid_mappings, "uidMappings" },
+                      { mount_key::gid_mappings, "gidMappings" },
+                      { mount_key::options, "options" })
+
+auto read(json_cursor &cur, oci_config::mount_t &v) -> void
+{
+    std::optional<std::vector<std::string>> options;
+    const auto seen = read_fields<mount_key>(cur, [&cur, &v, &options](mount_key key) {
+        switch (key) {
+        case mount_key::destination:
+            return read(cur, v.destination);
+        case mount_key::source:
+            return read(cur, v.source);
+        case mount_key::type:
+            return read(cur, v.type);
+        case mount_key::uid_mappings:
+            return read(cur, v.uid_mappings);
+        case mount_key::gid_mappings:
+            return read(cur, v.gid_mappings);
+        case mount_key::options:
+            return read(cur, options);
+        }
+    });
+
+    require(seen, { mount_key::destination }, "mount");
+
+    // options are applied last, whether they appear before or after uidMappings/gidMappings
+    if (options) {
+        std::optional<std::vector<oci_config::id_mapping_t>> uid_mappings;
+        std::optional<std::vector<oci_config::id_mapping_t>> gid_mappings;
+        std::tie(v.vfs_flags,
+                 v.propagation_flags,
+                 v.rec_attr,
+                 v.extension_flags,
+                 v.idmap,
+                 uid_mappings,
+                 gid_mappings,
+                 v.data) = parse_mount_options(*options);
+
+        // inline "idmap=uids=...,gids=..." mappings override uidMappings/gidMappings
+        if (uid_mappings) {
+            v.uid_mappings = std::move(uid_mappings);
+        }
+        if (gid_mappings) {
+            v.gid_mappings = std::move(gid_mappings);
+        }
+    }
+}
+
+// --- linux ---
+
+enum class namespace_key : std::uint8_t { type, path };
+LINYAPS_REGISTER_ENUM(namespace_key,
+                      { namespace_key::type, "type" },
+                      { namespace_key::path, "path" })
+
+auto read(json_cursor &cur, oci_config::linux_t::namespace_t &v) -> void
+{
+    const auto seen = read_fields<namespace_key>(cur, [&cur, &v](namespace_key key) {
+        switch (key) {
+        case namespace_key::type:
+            v.type_ = read_enum<oci_config::linux_t::namespace_t::type>(cur,
+                                                                        "unknown namespace type: ");
+            return;
+        case namespace_key::path:
+            return read(cur, v.path);
+        }
+    });
+
+    require(seen, { namespace_key::type }, "namespace");
+
+    // checked once the type is known, keys may come in any order
+    if (v.path) {
+        const auto type = to_string_view(v.type_);
+        if (UNLIKELY(v.path->empty())) {
+            throw std::runtime_error(
+              std::string{ "namespace path must not be empty for type: " }.append(type));
+        }
+
+        if (UNLIKELY(!v.path->is_absolute())) {
+            throw std::runtime_error("namespace path must be absolute for type: "
+                                     + std::string(type) + ", got: " + v.path->string());
+        }
+    }
+}
+
+enum class time_offset_key : std::uint8_t { secs, nanosecs };
+LINYAPS_REGISTER_ENUM(time_offset_key,
+                      { time_offset_key::secs, "secs" },
+                      { time_offset_key::nanosecs, "nanosecs" })
+
+auto read(json_cursor &cur, oci_config::linux_t::time_offset_t &v) -> void
+{
+    const auto seen = read_fields<time_offset_key>(cur, [&cur, &v](time_offset_key key) {
+        switch (key) {
+        case time_offset_key::secs:
+            return read(cur, v.secs);
+        case time_offset_key::nanosecs:
+            return read(cur, v.nanosecs);
+        }
+    });
+
+    require(seen, { time_offset_key::secs, time_offset_key::nanosecs }, "timeOffset");
+}
+
+enum class device_key : std::uint8_t { type, path, file_mode, major, minor, uid, gid };
+LINYAPS_REGISTER_ENUM(device_key,
+                      { device_key::type, "type" },
+                      { device_key::path, "path" },
+                      { device_key::file_mode, "fileMode" },
+                      { device_key::major, "major" },
+                      { device_key::minor, "minor" },
+                      { device_key::uid, "uid" },
+                      { device_key::gid, "gid" })
+
+auto read(json_cursor &cur, oci_config::linux_t::device_t &v) -> void
+{
+    const auto seen = read_fields<device_key>(cur, [&cur, &v](device_key key) {
+        switch (key) {
+        case device_key::type:
+            return read(cur, v.type);
+        case device_key::path:
+            return read(cur, v.path);
+        case device_key::file_mode:
+            return read(cur, v.mode);
+        case device_key::major:
+            return read(cur, v.major);
+        case device_key::minor:
+            return read(cur, v.minor);
+        case device_key::uid:
+            return read(cur, v.uid);
+        case device_key::gid:
+            return read(cur, v.gid);
+        }
+    });
+
+    require(seen, { device_key::type, device_key::path }, "device");
+}
+
+enum class network_device_key : std::uint8_t { name };
+LINYAPS_REGISTER_ENUM(network_device_key, { network_device_key::name, "name" })
+
+auto read(json_cursor &cur, oci_config::linux_t::network_device_t &v) -> void
+{
+    std::ignore = read_fields<network_device_key>(cur, [&cur, &v](network_device_key key) {
+        switch (key) {
+        case network_device_key::name:
+            return read(cur, v.name);
+        }
+    });
+}
+
+enum class allowed_device_key : std::uint8_t { allow, type, major, minor, access };
+LINYAPS_REGISTER_ENUM(allowed_device_key,
+                      { allowed_device_key::allow, "allow" },
+                      { allowed_device_key::type, "type" },
+                      { allowed_device_key::major, "major" },
+                      { allowed_device_key::minor, "minor" },
+                      { allowed_device_key::access, "access" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::device_t &v) -> void
+{
+    const auto seen = read_fields<allowed_device_key>(cur, [&cur, &v](allowed_device_key key) {
+        switch (key) {
+        case allowed_device_key::allow:
+            return read(cur, v.allow);
+        case allowed_device_key::type:
+            return read(cur, v.type);
+        case allowed_device_key::major:
+            return read(cur, v.major);
+        case allowed_device_key::minor:
+            return read(cur, v.minor);
+        case allowed_device_key::access:
+            return read(cur, v.access);
+        }
+    });
+
+    require(seen, { allowed_device_key::allow }, "resources.devices");
+}
+
+enum class memory_key : std::uint8_t {
+    limit,
+    reservation,
+    swap,
+    kernel,
+    kernel_tcp,
+    swappiness,
+    disable_oom_killer,
+    use_hierarchy,
+    check_before_update,
+};
+LINYAPS_REGISTER_ENUM(memory_key,
+                      { memory_key::limit, "limit" },
+                      { memory_key::reservation, "reservation" },
+                      { memory_key::swap, "swap" },
+                      { memory_key::kernel, "kernel" },
+                      { memory_key::kernel_tcp, "kernelTCP" },
+                      { memory_key::swappiness, "swappiness" },
+                      { memory_key::disable_oom_killer, "disableOOMKiller" },
+                      { memory_key::use_hierarchy, "useHierarchy" },
+                      { memory_key::check_before_update, "checkBeforeUpdate" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::memory_t &v) -> void
+{
+    std::ignore = read_fields<memory_key>(cur, [&cur, &v](memory_key key) {
+        switch (key) {
+        case memory_key::limit:
+            return read(cur, v.limit);
+        case memory_key::reservation:
+            return read(cur, v.reservation);
+        case memory_key::swap:
+            return read(cur, v.swap);
+        case memory_key::kernel:
+            return read(cur, v.kernel);
+        case memory_key::kernel_tcp:
+            return read(cur, v.kernel_tcp);
+        case memory_key::swappiness:
+            return read(cur, v.swappiness);
+        case memory_key::disable_oom_killer:
+            return read(cur, v.disable_OOM_killer);
+        case memory_key::use_hierarchy:
+            return read(cur, v.use_hierarchy);
+        case memory_key::check_before_update:
+            return read(cur, v.check_before_update);
+        }
+    });
+}
+
+enum class cpu_key : std::uint8_t {
+    shares,
+    quota,
+    burst,
+    period,
+    realtime_runtime,
+    realtime_period,
+    cpus,
+    mems,
+    idle,
+};
+LINYAPS_REGISTER_ENUM(cpu_key,
+                      { cpu_key::shares, "shares" },
+                      { cpu_key::quota, "quota" },
+                      { cpu_key::burst, "burst" },
+                      { cpu_key::period, "period" },
+                      { cpu_key::realtime_runtime, "realtimeRuntime" },
+                      { cpu_key::realtime_period, "realtimePeriod" },
+                      { cpu_key::cpus, "cpus" },
+                      { cpu_key::mems, "mems" },
+                      { cpu_key::idle, "idle" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::cpu_t &v) -> void
+{
+    using idle_t = oci_config::linux_t::resources_t::cpu_t::idle_t;
+
+    std::ignore = read_fields<cpu_key>(cur, [&cur, &v](cpu_key key) {
+        switch (key) {
+        case cpu_key::shares:
+            return read(cur, v.shares);
+        case cpu_key::quota:
+            return read(cur, v.quota);
+        case cpu_key::burst:
+            return read(cur, v.burst);
+        case cpu_key::period:
+            return read(cur, v.period);
+        case cpu_key::realtime_runtime:
+            return read(cur, v.realtime_runtime);
+        case cpu_key::realtime_period:
+            return read(cur, v.realtime_period);
+        case cpu_key::cpus:
+            return read_range_list(cur, v.cpus);
+        case cpu_key::mems:
+            return read_range_list(cur, v.mems);
+        case cpu_key::idle:
+            if (cur.consume_null()) {
+                v.idle.reset();
+                return;
+            }
+
+            v.idle = cur.read_integer<int64_t>() == 1 ? idle_t::IDLE : idle_t::NONE;
+            return;
+        }
+    });
+}
+
+enum class weight_device_key : std::uint8_t { major, minor, weight, leaf_weight };
+LINYAPS_REGISTER_ENUM(weight_device_key,
+                      { weight_device_key::major, "major" },
+                      { weight_device_key::minor, "minor" },
+                      { weight_device_key::weight, "weight" },
+                      { weight_device_key::leaf_weight, "leafWeight" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::block_io_t::weight_device_t &v)
+  -> void
+{
+    const auto seen = read_fields<weight_device_key>(cur, [&cur, &v](weight_device_key key) {
+        switch (key) {
+        case weight_device_key::major:
+            return read(cur, v.major);
+        case weight_device_key::minor:
+            return read(cur, v.minor);
+        case weight_device_key::weight:
+            return read(cur, v.weight);
+        case weight_device_key::leaf_weight:
+            return read(cur, v.leaf_weight);
+        }
+    });
+
+    require(seen, { weight_device_key::major, weight_device_key::minor }, "weightDevice");
+}
+
+enum class throttle_device_key : std::uint8_t { major, minor, rate };
+LINYAPS_REGISTER_ENUM(throttle_device_key,
+                      { throttle_device_key::major, "major" },
+                      { throttle_device_key::minor, "minor" },
+                      { throttle_device_key::rate, "rate" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::block_io_t::throttle_device_t &v)
+  -> void
+{
+    const auto seen = read_fields<throttle_device_key>(cur, [&cur, &v](throttle_device_key key) {
+        switch (key) {
+        case throttle_device_key::major:
+            return read(cur, v.major);
+        case throttle_device_key::minor:
+            return read(cur, v.minor);
+        case throttle_device_key::rate:
+            return read(cur, v.rate);
+        }
+    });
+
+    require(seen,
+            { throttle_device_key::major, throttle_device_key::minor, throttle_device_key::rate },
+            "throttle device");
+}
+
+enum class block_io_key : std::uint8_t {
+    weight,
+    leaf_weight,
+    weight_device,
+    throttle_read_bps_device,
+    throttle_write_bps_device,
+    throttle_read_iops_device,
+    throttle_write_iops_device,
+};
+LINYAPS_REGISTER_ENUM(block_io_key,
+                      { block_io_key::weight, "weight" },
+                      { block_io_key::leaf_weight, "leafWeight" },
+                      { block_io_key::weight_device, "weightDevice" },
+                      { block_io_key::throttle_read_bps_device, "throttleReadBpsDevice" },
+                      { block_io_key::throttle_write_bps_device, "throttleWriteBpsDevice" },
+                      { block_io_key::throttle_read_iops_device, "throttleReadIOPSDevice" },
+                      { block_io_key::throttle_write_iops_device, "throttleWriteIOPSDevice" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::block_io_t &v) -> void
+{
+    std::ignore = read_fields<block_io_key>(cur, [&cur, &v](block_io_key key) {
+        switch (key) {
+        case block_io_key::weight:
+            return read(cur, v.weight);
+        case block_io_key::leaf_weight:
+            return read(cur, v.leaf_weight);
+        case block_io_key::weight_device:
+            return read(cur, v.weight_devices);
+        case block_io_key::throttle_read_bps_device:
+            return read(cur, v.throttle_read_bps_device);
+        case block_io_key::throttle_write_bps_device:
+            return read(cur, v.throttle_write_bps_device);
+        case block_io_key::throttle_read_iops_device:
+            return read(cur, v.throttle_read_iops_device);
+        case block_io_key::throttle_write_iops_device:
+            return read(cur, v.throttle_write_iops_device);
+        }
+    });
+}
+
+enum class hugepage_limit_key : std::uint8_t { page_size, limit };
+LINYAPS_REGISTER_ENUM(hugepage_limit_key,
+                      { hugepage_limit_key::page_size, "pageSize" },
+                      { hugepage_limit_key::limit, "limit" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::hugepage_limit_t &v) -> void
+{
+    const auto seen = read_fields<hugepage_limit_key>(cur, [&cur, &v](hugepage_limit_key key) {
+        switch (key) {
+        case hugepage_limit_key::page_size:
+            return read(cur, v.page_size);
+        case hugepage_limit_key::limit:
+            return read(cur, v.limit);
+        }
+    });
+
+    require(seen, { hugepage_limit_key::page_size, hugepage_limit_key::limit }, "hugepageLimit");
+}
+
+enum class network_priority_key : std::uint8_t { name, priority };
+LINYAPS_REGISTER_ENUM(network_priority_key,
+                      { network_priority_key::name, "name" },
+                      { network_priority_key::priority, "priority" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::network_t::priority_t &v) -> void
+{
+    const auto seen = read_fields<network_priority_key>(cur, [&cur, &v](network_priority_key key) {
+        switch (key) {
+        case network_priority_key::name:
+            return read(cur, v.name);
+        case network_priority_key::priority:
+            return read(cur, v.priority);
+        }
+    });
+
+    require(seen,
+            { network_priority_key::name, network_priority_key::priority },
+            "network priority");
+}
+
+enum class network_key : std::uint8_t { class_id, priorities };
+LINYAPS_REGISTER_ENUM(network_key,
+                      { network_key::class_id, "classID" },
+                      { network_key::priorities, "priorities" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::network_t &v) -> void
+{
+    std::ignore = read_fields<network_key>(cur, [&cur, &v](network_key key) {
+        switch (key) {
+        case network_key::class_id:
+            return read(cur, v.class_id);
+        case network_key::priorities:
+            return read(cur, v.priorities);
+        }
+    });
+}
+
+enum class pids_key : std::uint8_t { limit };
+LINYAPS_REGISTER_ENUM(pids_key, { pids_key::limit, "limit" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t::pids_t &v) -> void
+{
+    std::ignore = read_fields<pids_key>(cur, [&cur, &v](pids_key key) {
+        switch (key) {
+        case pids_key::limit:
+            return read(cur, v.limit);
+        }
+    });
+}
+
+// rdma is not used by ll-box and is skipped as an unknown key
+enum class resources_key : std::uint8_t {
+    unified,
+    devices,
+    pids,
+    memory,
+    cpu,
+    hugepage_limits,
+    block_io,
+    network,
+};
+LINYAPS_REGISTER_ENUM(resources_key,
+                      { resources_key::unified, "unified" },
+                      { resources_key::devices, "devices" },
+                      { resources_key::pids, "pids" },
+                      { resources_key::memory, "memory" },
+                      { resources_key::cpu, "cpu" },
+                      { resources_key::hugepage_limits, "hugepageLimits" },
+                      { resources_key::block_io, "blockIO" },
+                      { resources_key::network, "network" })
+
+auto read(json_cursor &cur, oci_config::linux_t::resources_t &v) -> void
+{
+    std::ignore = read_fields<resources_key>(cur, [&cur, &v](resources_key key) {
+        switch (key) {
+        case resources_key::unified:
+            return read(cur, v.unified);
+        case resources_key::devices:
+            return read(cur, v.devices);
+        case resources_key::pids:
+            return read(cur, v.pids);
+        case resources_key::memory:
+            return read(cur, v.memory);
+        case resources_key::cpu:
+            return read(cur, v.cpu);
+        case resources_key::hugepage_limits:
+            return read(cur, v.hugepage_limits);
+        case resources_key::block_io:
+            return read(cur, v.block_io);
+        case resources_key::network:
+            return read(cur, v.network);
+        }
+    });
+}
+
+enum class memory_policy_key : std::uint8_t { mode, nodes, flags };
+LINYAPS_REGISTER_ENUM(memory_policy_key,
+                      { memory_policy_key::mode, "mode" },
+                      { memory_policy_key::nodes, "nodes" },
+                      { memory_policy_key::flags, "flags" })
+
+auto read(json_cursor &cur, oci_config::linux_t::memory_policy_t &v) -> void
+{
+    using memory_policy_t = oci_config::linux_t::memory_policy_t;
+
+    const auto seen = read_fields<memory_policy_key>(cur, [&cur, &v](memory_policy_key key) {
+        switch (key) {
+        case memory_policy_key::mode:
+            v.mode = read_enum<memory_policy_t::mode_t>(cur);
+            return;
+        case memory_policy_key::nodes:
+            return read_range_list(cur, v.nodes);
+        case memory_policy_key::flags:
+            if (cur.consume_null()) {
+                v.flags.reset();
+                return;
+            }
+
+            v.flags = read_flags<memory_policy_t::flag_t>(cur);
+            return;
+        }
+    });
+
+    require(seen, { memory_policy_key::mode }, "memoryPolicy");
+}
+
+enum class personality_key : std::uint8_t { domain, flags };
+LINYAPS_REGISTER_ENUM(personality_key,
+                      { personality_key::domain, "domain" },
+                      { personality_key::flags, "flags" })
+
+auto read(json_cursor &cur, oci_config::linux_t::personality_t &v) -> void
+{
+    const auto seen = read_fields<personality_key>(cur, [&cur, &v](personality_key key) {
+        switch (key) {
+        case personality_key::domain:
+            v.domain = read_enum<oci_config::linux_t::personality_t::domain_t>(cur);
+            return;
+        case personality_key::flags:
+            return read(cur, v.flags);
+        }
+    });
+
+    require(seen, { personality_key::domain }, "personality");
+}
+
+enum class seccomp_arg_key : std::uint8_t { index, value, value_two, op };
+LINYAPS_REGISTER_ENUM(seccomp_arg_key,
+                      { seccomp_arg_key::index, "index" },
+                      { seccomp_arg_key::value, "value" },
+                      { seccomp_arg_key::value_two, "valueTwo" },
+                      { seccomp_arg_key::op, "op" })
+
+auto read(json_cursor &cur, oci_config::linux_t::seccomp_t::syscall_t::arg_t &v) -> void
+{
+    const auto seen = read_fields<seccomp_arg_key>(cur, [&cur, &v](seccomp_arg_key key) {
+        switch (key) {
+        case seccomp_arg_key::index:
+            return read(cur, v.index);
+        case seccomp_arg_key::value:
+            return read(cur, v.value);
+        case seccomp_arg_key::value_two:
+            return read(cur, v.value_two);
+        case seccomp_arg_key::op:
+            v.op = read_enum<oci_config::linux_t::seccomp_t::syscall_t::arg_t::op_t>(cur);
+            return;
+        }
+    });
+
+    require(seen,
+            { seccomp_arg_key::index, seccomp_arg_key::value, seccomp_arg_key::op },
+            "seccomp arg");
+}
+
+enum class syscall_key : std::uint8_t { names, action, errno_ret, args };
+LINYAPS_REGISTER_ENUM(syscall_key,
+                      { syscall_key::names, "names" },
+                      { syscall_key::action, "action" },
+                      { syscall_key::errno_ret, "errnoRet" },
+                      { syscall_key::args, "args" })
+
+auto read(json_cursor &cur, oci_config::linux_t::seccomp_t::syscall_t &v) -> void
+{
+    const auto seen = read_fields<syscall_key>(cur, [&cur, &v](syscall_key key) {
+        switch (key) {
+        case syscall_key::names:
+            return read(cur, v.names);
+        case syscall_key::action:
+            v.action = read_enum<oci_config::linux_t::seccomp_t::action_t>(cur);
+            return;
+        case syscall_key::errno_ret:
+            return read(cur, v.errno_ret);
+        case syscall_key::args:
+            return read(cur, v.args);
+        }
+    });
+
+    require(seen, { syscall_key::names, syscall_key::action }, "syscall");
+}
+
+enum class seccomp_key : std::uint8_t {
+    default_action,
+    default_errno_ret,
+    architectures,
+    flags,
+    listener_path,
+    listener_metadata,
+    syscalls,
+};
+LINYAPS_REGISTER_ENUM(seccomp_key,
+                      { seccomp_key::default_action, "defaultAction" },
+                      { seccomp_key::default_errno_ret, "defaultErrnoRet" },
+                      { seccomp_key::architectures, "architectures" },
+                      { seccomp_key::flags, "flags" },
+                      { seccomp_key::listener_path, "listenerPath" },
+                      { seccomp_key::listener_metadata, "listenerMetadata" },
+                      { seccomp_key::syscalls, "syscalls" })
+
+auto read(json_cursor &cur, oci_config::linux_t::seccomp_t &v) -> void
+{
+    using seccomp_t = oci_config::linux_t::seccomp_t;
+
+    const auto seen = read_fields<seccomp_key>(cur, [&cur, &v](seccomp_key key) {
+        switch (key) {
+        case seccomp_key::default_action:
+            v.default_action = read_enum<seccomp_t::action_t>(cur);
+            return;
+        case seccomp_key::default_errno_ret:
+            return read(cur, v.default_errno_ret);
+        case seccomp_key::architectures:
+            if (cur.consume_null()) {
+                v.architectures.reset();
+                return;
+            }
+
+            v.architectures.emplace();
+            cur.read_array([&cur, &v]() {
+                v.architectures->push_back(
+                  read_enum<seccomp_t::arch_t>(cur, "unknown architecture: "));
+            });
+            return;
+        case seccomp_key::flags:
+            if (cur.consume_null()) {
+                v.flags.reset();
+                return;
+            }
+
+            v.flags = read_flags<seccomp_t::flag_t>(cur);
+            return;
+        case seccomp_key::listener_path:
+            return read(cur, v.listener_path);
+        case seccomp_key::listener_metadata:
+            return read(cur, v.listener_metadata);
+        case seccomp_key::syscalls:
+            return read(cur, v.syscalls);
+        }
+    });
+
+    require(seen, { seccomp_key::default_action }, "seccomp");
+}
+
+// intelRdt is not used by ll-box and is skipped as an unknown key
+enum class linux_key : std::uint8_t {
+    uid_mappings,
+    gid_mappings,
+    namespaces,
+    devices,
+    net_devices,
+    cgroups_path,
+    masked_paths,
+    readonly_paths,
+    mount_label,
+    rootfs_propagation,
+    sysctl,
+    time_offsets,
+    personality,
+    memory_policy,
+    resources,
+    seccomp,
+};
+LINYAPS_REGISTER_ENUM(linux_key,
+                      { linux_key::uid_mappings, "uidMappings" },
+                      { linux_key::gid_mappings, "gidMappings" },
+                      { linux_key::namespaces, "namespaces" },
+                      { linux_key::devices, "devices" },
+                      { linux_key::net_devices, "netDevices" },
+                      { linux_key::cgroups_path, "cgroupsPath" },
+                      { linux_key::masked_paths, "maskedPaths" },
+                      { linux_key::readonly_paths, "readonlyPaths" },
+                      { linux_key::mount_label, "mountLabel" },
+                      { linux_key::rootfs_propagation, "rootfsPropagation" },
+                      { linux_key::sysctl, "sysctl" },
+                      { linux_key::time_offsets, "timeOffsets" },
+                      { linux_key::personality, "personality" },
+                      { linux_key::memory_policy, "memoryPolicy" },
+                      { linux_key::resources, "resources" },
+                      { linux_key::seccomp, "seccomp" })
+
+auto read_time_offsets(json_cursor &cur, oci_config::linux_t &v) -> void
+{
+    if (cur.consume_null()) {
+        v.time_offsets.reset();
+        return;
+    }
+
+    auto &offsets = v.time_offsets.emplace();
+    cur.read_object([&cur, &offsets](std::string_view clock) {
+        auto [it, inserted] = offsets.try_emplace(std::string{ clock });
+        if (UNLIKELY(!inserted)) {
+            throw std::runtime_error("duplicated timeOffset: " + it->first);
+        }
+
+        read(cur, it->second);
+    });
+}
+
+auto read(json_cursor &cur, oci_config::linux_t &v) -> void
+{
+    v.rootfs_propagation = default_rootfs_propagation;
+    std::ignore = read_fields<linux_key>(cur, [&cur, &v](linux_key key) {
+        switch (key) {
+        case linux_key::uid_mappings:
+            return read(cur, v.uid_mappings);
+        case linux_key::gid_mappings:
+            return read(cur, v.gid_mappings);
+        case linux_key::namespaces:
+            // namespace type uniqueness is checked in validate()
+            return read(cur, v.namespaces);
+        case linux_key::devices:
+            return read(cur, v.devices);
+        case linux_key::net_devices:
+            return read(cur, v.network_devices);
+        case linux_key::cgroups_path:
+            return read(cur, v.cgroups_path);
+        case linux_key::masked_paths:
+            return read(cur, v.masked_paths);
+        case linux_key::readonly_paths:
+            return read(cur, v.readonly_paths);
+        case linux_key::mount_label:
+            return read(cur, v.mount_label);
+        case linux_key::rootfs_propagation:
+            v.rootfs_propagation = cur.consume_null()
+              ? default_rootfs_propagation
+              : parse_rootfs_propagation(cur.read_string_view());
+            return;
+        case linux_key::sysctl:
+            return read(cur, v.sysctl);
+        case linux_key::time_offsets:
+            return read_time_offsets(cur, v);
+        case linux_key::personality:
+            return read(cur, v.personality);
+        case linux_key::memory_policy:
+            return read(cur, v.memory_policy);
+        case linux_key::resources:
+            return read(cur, v.resources);
+        case linux_key::seccomp:
+            return read(cur, v.seccomp);
+        }
+    });
+}
+
+// --- hooks ---
+
+enum class hook_key : std::uint8_t { path, args, env, timeout };
+LINYAPS_REGISTER_ENUM(hook_key,
+                      { hook_key::path, "path" },
+                      { hook_key::args, "args" },
+                      { hook_key::env, "env" },
+                      { hook_key::timeout, "timeout" })
+
+auto read(json_cursor &cur, oci_config::hooks_t::hook_t &v) -> void
+{
+    const auto seen = read_fields<hook_key>(cur, [&cur, &v](hook_key key) {
+        switch (key) {
+        case hook_key::path:
+            return read(cur, v.path);
+        case hook_key::args:
+            return read(cur, v.args);
+        case hook_key::env:
+            return read(cur, v.env);
+        case hook_key::timeout:
+            return read(cur, v.timeout);
+        }
+    });
+
+    require(seen, { hook_key::path }, "hook");
+}
+
+enum class hooks_key : std::uint8_t {
+    prestart,
+    create_runtime,
+    create_container,
+    start_container,
+    poststart,
+    poststop,
+};
+LINYAPS_REGISTER_ENUM(hooks_key,
+                      { hooks_key::prestart, "prestart" },
+                      { hooks_key::create_runtime, "createRuntime" },
+                      { hooks_key::create_container, "createContainer" },
+                      { hooks_key::start_container, "startContainer" },
+                      { hooks_key::poststart, "poststart" },
+                      { hooks_key::poststop, "poststop" })
+
+auto read(json_cursor &cur, oci_config::hooks_t &v) -> void
+{
+    std::ignore = read_fields<hooks_key>(cur, [&cur, &v](hooks_key key) {
+        switch (key) {
+        case hooks_key::prestart:
+            return read(cur, v.prestart);
+        case hooks_key::create_runtime:
+            return read(cur, v.create_runtime);
+        case hooks_key::create_container:
+            return read(cur, v.create_container);
+        case hooks_key::start_container:
+            return read(cur, v.start_container);
+        case hooks_key::poststart:
+            return read(cur, v.poststart);
+        case hooks_key::poststop:
+            return read(cur, v.poststop);
+        }
+    });
+}
+
+// --- root ---
+
+enum class root_key : std::uint8_t { path, readonly };
+LINYAPS_REGISTER_ENUM(root_key, { root_key::path, "path" }, { root_key::readonly, "readonly" })
+
+auto read(json_cursor &cur, oci_config::root_t &v) -> void
+{
+    const auto seen = read_fields<root_key>(cur, [&cur, &v](root_key key) {
+        switch (key) {
+        case root_key::path:
+            return read(cur, v.path);
+        case root_key::readonly:
+            return read(cur, v.readonly);
+        }
+    });
+
+    require(seen, { root_key::path }, "root");
+}
+
+enum class config_key : std::uint8_t {
+    oci_version,
+    process,
+    hostname,
+    domainname,
+    linux,
+    hooks,
+    mounts,
+    root,
+    annotations,
+};
+LINYAPS_REGISTER_ENUM(config_key,
+                      { config_key::oci_version, "ociVersion" },
+                      { config_key::process, "process" },
+                      { config_key::hostname, "hostname" },
+                      { config_key::domainname, "domainname" },
+                      { config_key::linux, "linux" },
+                      { config_key::hooks, "hooks" },
+                      { config_key::mounts, "mounts" },
+                      { config_key::root, "root" },
+                      { config_key::annotations, "annotations" })
+
+auto read(json_cursor &cur, oci_config &v) -> void
+{
+    const auto seen = read_fields<config_key>(cur, [&cur, &v](config_key key) {
+        switch (key) {
+        case config_key::oci_version: {
+            const auto semver = utils::semver(cur.read_string_view());
+            if (UNLIKELY(!utils::semver(oci_config::version).is_compatible_with(semver))) {
+                throw std::runtime_error("unsupported OCI version: " + semver.to_string());
+            }
+            return;
+        }
+        case config_key::process:
+            return read(cur, v.process);
+        case config_key::hostname:
+            return read(cur, v.hostname);
+        case config_key::domainname:
+            return read(cur, v.domainname);
+        case config_key::linux:
+            return read(cur, v.linux);
+        case config_key::hooks:
+            return read(cur, v.hooks);
+        case config_key::mounts:
+            if (cur.consume_null()) {
+                return;
+            }
+
+            return read(cur, v.mounts);
+        case config_key::root:
+            return read(cur, v.root);
+        case config_key::annotations:
+            return read(cur, v.annotations);
+        }
+    });
+
+    require(seen, { config_key::oci_version }, "config");
+}
+
+} // namespace
+
+auto parse_streaming(std::string_view content) -> oci_config
+{
+    json_cursor cur{ content };
+    oci_config config;
+    read(cur, config);
+    cur.finish();
+    return config;
+}
+
+} // namespace linyaps_box::config
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+
+#include <string_view>
+
+namespace linyaps_box::config {
+
+// Single pass parser filling oci_config straight from the JSON text, without
+// building a nlohmann::json tree first. It accepts the same documents as the
+// from_json overloads except that sections ll-box never uses (linux.intelRdt,
+// linux.resources.rdma) are skipped like unknown keys and stay empty.
+//
+// The result is NOT validated, see oci_config::parse.
+[[nodiscard]] auto parse_streaming(std::string_view content) -> oci_config;
+
+} // namespace linyaps_box::config
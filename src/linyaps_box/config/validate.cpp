@@ -12,7 +12,10 @@
 
 #include <algorithm>
 #include <bitset>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
 #include <utility>
 
 namespace linyaps_box {
@@ -164,6 +167,105 @@ void validate(const std::vector<oci_config::linux_t::namespace_t> &namespaces)
     }
 }
 
+void validate(const oci_config::linux_t::memory_policy_t &v)
+{
+    using mode_t = oci_config::linux_t::memory_policy_t::mode_t;
+    using flag_t = oci_config::linux_t::memory_policy_t::flag_t;
+
+    const auto has_nodes = v.nodes && !v.nodes->empty();
+    switch (v.mode) {
+    case mode_t::DEFAULT:
+    case mode_t::LOCAL: {
+        if (UNLIKELY(has_nodes)) {
+            throw std::runtime_error("memoryPolicy.nodes must be empty for MPOL_DEFAULT and "
+                                     "MPOL_LOCAL");
+        }
+    } break;
+    case mode_t::BIND:
+    case mode_t::INTERLEAVE:
+    case mode_t::WEIGHTED_INTERLEAVE:
+    case mode_t::PREFERRED_MANY: {
+        if (UNLIKELY(!has_nodes)) {
+            throw std::runtime_error("memoryPolicy.nodes is required for MPOL_BIND, "
+                                     "MPOL_INTERLEAVE, MPOL_WEIGHTED_INTERLEAVE and "
+                                     "MPOL_PREFERRED_MANY");
+        }
+    } break;
+    case mode_t::PREFERRED:
+        break;
+    }
+
+    if (v.flags) {
+        if (UNLIKELY((*v.flags & flag_t::STATIC_NODES) == flag_t::STATIC_NODES
+                     && (*v.flags & flag_t::RELATIVE_NODES) == flag_t::RELATIVE_NODES)) {
+            throw std::runtime_error(
+              "MPOL_F_STATIC_NODES and MPOL_F_RELATIVE_NODES are mutually exclusive");
+        }
+
+        if (UNLIKELY((*v.flags & flag_t::NUMA_BALANCING) == flag_t::NUMA_BALANCING
+                     && v.mode != mode_t::BIND)) {
+            throw std::runtime_error("MPOL_F_NUMA_BALANCING requires MPOL_BIND");
+        }
+    }
+
+    // Whether the nodes are online is checked by apply_memory_policy: a cached
+    // config skips validation, and nodes may go offline after it was stored.
+}
+
+// The namespace a sysctl belongs to, like runc: writing any other key would change
+// the host. nullopt for keys that are not namespaced.
+auto sysctl_namespace(std::string_view key)
+  -> std::optional<oci_config::linux_t::namespace_t::type>
+{
+    using type = oci_config::linux_t::namespace_t::type;
+
+    constexpr std::string_view ipc_keys[] = {
+        "kernel.msgmax", "kernel.msgmnb", "kernel.msgmni",         "kernel.sem",
+        "kernel.shmall", "kernel.shmmax", "kernel.shm_rmid_forced", "kernel.shmmni",
+    };
+    if (std::find(std::begin(ipc_keys), std::end(ipc_keys), key) != std::end(ipc_keys)
+        || key.rfind("fs.mqueue.", 0) == 0) {
+        return type::IPC;
+    }
+
+    if (key == "kernel.hostname" || key == "kernel.domainname") {
+        return type::UTS;
+    }
+
+    if (key.rfind("net.", 0) == 0) {
+        return type::NET;
+    }
+
+    return std::nullopt;
+}
+
+void validate_sysctl(const oci_config::linux_t &v)
+{
+    for (const auto &[key, value] : *v.sysctl) {
+        // keys become paths below /proc/sys
+        if (UNLIKELY(key.empty() || key.find('/') != std::string::npos
+                     || key.find("..") != std::string::npos || key.front() == '.'
+                     || key.back() == '.')) {
+            throw std::runtime_error(fmt::format("invalid sysctl key: {}", key));
+        }
+
+        const auto ns = sysctl_namespace(key);
+        if (UNLIKELY(!ns)) {
+            throw std::runtime_error(fmt::format("sysctl {} is not namespaced", key));
+        }
+
+        const auto separate = v.namespaces
+          && std::any_of(v.namespaces->cbegin(), v.namespaces->cend(), [&ns](const auto &n) {
+                 return n.type_ == *ns;
+             });
+        if (UNLIKELY(!separate)) {
+            throw std::runtime_error(fmt::format("sysctl {} requires a separate {} namespace",
+                                                 key,
+                                                 to_string_view(*ns)));
+        }
+    }
+}
+
 void validate(const oci_config::linux_t &v)
 {
     if (v.namespaces) {
@@ -178,6 +280,14 @@ void validate(const oci_config::linux_t &v)
 #endif
     }
 
+    if (v.memory_policy) {
+        validate(*v.memory_policy);
+    }
+
+    if (v.sysctl) {
+        validate_sysctl(v);
+    }
+
     if (v.masked_paths) {
         for (const auto &p : *v.masked_paths) {
             if (UNLIKELY(!p.is_absolute())) {
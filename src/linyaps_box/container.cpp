@@ -4,25 +4,36 @@
 
 #include "linyaps_box/container.h"
 
+#include "linyaps_box/config/cache.h"
 #include "linyaps_box/config/mount_options.h"
 #include "linyaps_box/container_monitor.h"
+#include "linyaps_box/impl/cgroupfs_manager.h"
 #include "linyaps_box/impl/disabled_cgroup_manager.h"
 #include "linyaps_box/infra/rootfs.h"
 #include "linyaps_box/infra/unix_socket.h"
+#include "linyaps_box/io/stream.h"
 #include "linyaps_box/log/logger.h"
 #include "linyaps_box/log/macro.h"
+#include "linyaps_box/memory_reclaim.h"
 #include "linyaps_box/os/fs.h"
+#include "linyaps_box/os/mount.h"
 #include "linyaps_box/os/process.h"
 #include "linyaps_box/protocol/message_channel.h"
 #include "linyaps_box/protocol/sync_socket_forwarder.h"
 #include "linyaps_box/security/privilege.h"
+#include "linyaps_box/security/seccomp.h"
 #include "linyaps_box/terminal.h"
 #include "linyaps_box/utils/cgroups.h"
 #include "linyaps_box/utils/close_range.h"
 #include "linyaps_box/utils/file_describer.h"
+#include "linyaps_box/utils/idmap.h"
+#include "linyaps_box/utils/mempolicy.h"
 #include "linyaps_box/utils/process_stat.h"
+#include "linyaps_box/utils/rusage.h"
+#include "linyaps_box/utils/sched.h"
 #include "linyaps_box/utils/session.h"
 #include "linyaps_box/utils/signal.h"
+#include "linyaps_box/utils/timing.h"
 #include "utils/defer.h"
 
 #include <linux/magic.h>
@@ -40,6 +51,7 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <unordered_map>
 
 #include <grp.h>
 #include <pwd.h>
@@ -85,6 +97,8 @@ namespace stage = protocol::stage;
 
 void execute_hook(const oci_config::hooks_t::hook_t &hook, const container_status &state)
 {
+    const utils::phase_scope phase{ "execute_hook", hook.path.native() };
+
     // FIXME: hook state JSON is sent over a SEQPACKET socketpair, which discards
     //  bytes beyond the hook's first read() buffer (e.g. Python's 8K) when the
     //  message is larger — large `annotations` can truncate the JSON and make the
@@ -230,17 +244,41 @@ struct clone_fn_args
     int preserve_fds;
     linyaps_box::container *container{ nullptr };
     child_message_channel sync;
+    // the read end of the exec FIFO, -1 unless the container is only created
+    int exec_fifo{ -1 };
 };
 
+// Bind mounts with the "idmap"/"ridmap" options or their own mappings. A
+// copy-symlink entry is no mount at all.
+[[nodiscard]] auto is_idmapped(const oci_config::mount_t &mount) noexcept -> bool
+{
+    return (mount.idmap || mount.uid_mappings)
+      && (mount.extension_flags & oci_config::mount_t::extension::COPY_SYMLINK)
+      != oci_config::mount_t::extension::COPY_SYMLINK;
+}
+
 // NOTE: All function in this namespace are running in the container namespace.
 namespace container_ns {
 
-void initialize_container(const oci_config &oci_config, child_message_channel &sync)
+// Returns the idmapped mounts the runtime prepared meanwhile, indexed like
+// the mounts of the config, the other entries are invalid.
+[[nodiscard]] auto initialize_container(const oci_config &oci_config,
+                                        child_message_channel &sync)
+  -> std::vector<utils::file_descriptor>
 {
     LINYAPS_BOX_LOG_DEBUG("Request OCI runtime in runtime namespace to configure namespace");
 
-    sync.send_stage(stage::type::namespace_ready);
-    sync.expect_stage(stage::type::namespace_done);
+    std::vector<utils::file_descriptor> idmapped_trees(oci_config.mounts.size());
+    {
+        const utils::phase_scope phase{ "wait_namespace_configured" };
+        sync.send_stage(stage::type::namespace_ready);
+        for (std::size_t i = 0; i < oci_config.mounts.size(); ++i) {
+            if (is_idmapped(oci_config.mounts[i])) {
+                idmapped_trees[i] = sync.expect_mount_fd(static_cast<std::uint32_t>(i));
+            }
+        }
+        sync.expect_stage(stage::type::namespace_done);
+    }
 
     LINYAPS_BOX_LOG_DEBUG("Container namespaces configured from runtime namespace");
 
@@ -262,6 +300,8 @@ void initialize_container(const oci_config &oci_config, child_message_channel &s
                                     "failed to write to /proc/self/oom_score_adj");
         }
     }
+
+    return idmapped_trees;
 }
 
 void syscall_mount(const char *_special_file,
@@ -317,8 +357,88 @@ struct remount_t
     utils::file_descriptor destination_fd;
     unsigned long flags{ };
     std::string data;
+    // new mount API only: make the whole tree readonly ("rro")
+    bool recursive{ false };
 };
 
+// MS_* flags of a mount entry as mount_setattr(2) attributes. Unlike MS_REMOUNT
+// nothing which is not requested gets cleared, so flags locked by a user
+// namespace can't make it fail.
+[[nodiscard]] auto to_mount_attr(unsigned long vfs_flags) noexcept -> os::sys::mount_attr
+{
+    constexpr std::array<std::pair<unsigned long, uint64_t>, 6> flags{ {
+      { MS_RDONLY, os::sys::mount_attr_rdonly },
+      { MS_NOSUID, os::sys::mount_attr_nosuid },
+      { MS_NODEV, os::sys::mount_attr_nodev },
+      { MS_NOEXEC, os::sys::mount_attr_noexec },
+      { MS_NODIRATIME, os::sys::mount_attr_nodiratime },
+      { os::sys::ms_nosymfollow, os::sys::mount_attr_nosymfollow },
+    } };
+
+    os::sys::mount_attr attr{ };
+    for (const auto &[flag, mount_attr] : flags) {
+        if ((vfs_flags & flag) != 0) {
+            attr.attr_set |= mount_attr;
+        }
+    }
+
+    // relatime is the zero value of the atime field
+    if ((vfs_flags & MS_NOATIME) != 0) {
+        attr.attr_set |= os::sys::mount_attr_noatime;
+        attr.attr_clr |= os::sys::mount_attr__atime;
+    } else if ((vfs_flags & MS_STRICTATIME) != 0) {
+        attr.attr_set |= os::sys::mount_attr_strictatime;
+        attr.attr_clr |= os::sys::mount_attr__atime;
+    } else if ((vfs_flags & MS_RELATIME) != 0) {
+        attr.attr_clr |= os::sys::mount_attr__atime;
+    }
+
+    return attr;
+}
+
+[[nodiscard]] auto to_mount_attr(const oci_config::mount_t::recursive_attr &rec) noexcept
+  -> os::sys::mount_attr
+{
+    os::sys::mount_attr attr{ rec.set, rec.clr };
+
+    // "ratime" and "rnostrictatime" only clear a bit of the atime field, which
+    // the kernel rejects; clear the whole field, i.e. relatime.
+    if (((attr.attr_set | attr.attr_clr) & os::sys::mount_attr__atime) != 0) {
+        attr.attr_clr |= os::sys::mount_attr__atime;
+    }
+
+    return attr;
+}
+
+auto do_mount_setattr(const utils::file_descriptor &mount,
+                      const os::sys::mount_attr &attr,
+                      bool recursive) -> void
+{
+    if (attr.attr_set == 0 && attr.attr_clr == 0 && attr.propagation == 0) {
+        return;
+    }
+
+    LINYAPS_BOX_LOG_DEBUG("mount_setattr {}: set={:#x} clr={:#x} propagation={} recursive={}",
+                          mount.get(),
+                          attr.attr_set,
+                          attr.attr_clr,
+                          dump(0, attr.propagation),
+                          recursive);
+    os::throw_if_error(os::mount_setattr(mount.ref(), attr, recursive), "mount_setattr");
+}
+
+// With the new mount API propagation is a mount attribute, MS_REC maps to AT_RECURSIVE.
+auto do_propagation_setattr(const utils::file_descriptor &mount, unsigned long flags) -> void
+{
+    if (flags == 0) {
+        return;
+    }
+
+    os::sys::mount_attr attr{ };
+    attr.propagation = flags & ~MS_REC;
+    do_mount_setattr(mount, attr, (flags & MS_REC) != 0);
+}
+
 auto do_remount(const remount_t &mount) -> void
 {
     if (UNLIKELY(mount.destination_fd.get() == -1)) {
@@ -329,6 +449,14 @@ auto do_remount(const remount_t &mount) -> void
         throw std::invalid_argument("remount: flags must include BIND|REMOUNT|RDONLY");
     }
 
+    // the fd refers to the mount itself, only the readonly bit is left to flip
+    if (os::new_mount_api_supported()) {
+        os::sys::mount_attr attr{ };
+        attr.attr_set = os::sys::mount_attr_rdonly;
+        do_mount_setattr(mount.destination_fd, attr, mount.recursive);
+        return;
+    }
+
     auto destination = mount.destination_fd.ref().current_path();
     const auto *data_ptr = mount.data.empty() ? nullptr : mount.data.c_str();
 
@@ -453,15 +581,40 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
     syscall_mount(nullptr, dest_path.c_str(), nullptr, flags, nullptr);
 }
 
+// Clone the source of a bind mount and set its attributes while it is still
+// detached, before it is attached or idmapped. Needs the new mount API.
+[[nodiscard]] auto clone_bind_tree(utils::file_descriptor_ref source,
+                                   const oci_config::mount_t &mount) -> utils::file_descriptor
+{
+    auto tree = os::throw_if_error(os::open_tree_clone(source, (mount.vfs_flags & MS_REC) != 0),
+                                   "open_tree");
+
+    // MS_RDONLY is left to the caller, see do_mount
+    do_mount_setattr(tree, to_mount_attr(mount.vfs_flags & ~MS_RDONLY), false);
+    if (mount.rec_attr) {
+        auto attr = to_mount_attr(*mount.rec_attr);
+        attr.attr_set &= ~os::sys::mount_attr_rdonly;
+        do_mount_setattr(tree, attr, true);
+    }
+
+    return tree;
+}
+
+// An idmapped mount arrives as a detached tree from the runtime, see
+// runtime_ns::send_idmapped_mounts, and only has to be attached.
 [[nodiscard]] utils::file_descriptor do_bind_mount(const infra::Root &root,
-                                                   const oci_config::mount_t &mount)
+                                                   const oci_config::mount_t &mount,
+                                                   utils::file_descriptor idmapped_tree = { })
 {
     if (UNLIKELY(!mount.source)) {
         throw std::invalid_argument("bind mount requires source");
     }
 
-    auto source_fd = os::throw_if_error(
-      os::open(mount.source.value(), { os::sys::open_flag::cloexec, os::sys::access_mode::path }));
+    const auto idmapped = idmapped_tree.valid();
+    auto source_fd = idmapped ? std::move(idmapped_tree)
+                              : os::throw_if_error(os::open(mount.source.value(),
+                                                            { os::sys::open_flag::cloexec,
+                                                              os::sys::access_mode::path }));
     auto source_ref = source_fd.ref();
     auto source_stat =
       os::throw_if_error(os::fstatat(source_ref, "", os::sys::at_flag::empty_path));
@@ -481,6 +634,14 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
                       (S_ISDIR(dest_stat.st_mode) ? "dir" : "file")));
     }
 
+    if (os::new_mount_api_supported()) {
+        // The clone fd refers to the new mount, so neither the destination path
+        // nor a remount is needed afterwards.
+        auto tree = idmapped ? std::move(source_fd) : clone_bind_tree(source_ref, mount);
+        os::throw_if_error(os::move_mount(tree.ref(), destination_fd.ref()), "move_mount");
+        return tree;
+    }
+
     // remove MS_RDONLY for creating destination
     // we will remount it on later
     auto bind_flags = mount.vfs_flags & ~MS_RDONLY;
@@ -507,9 +668,14 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
     throw std::runtime_error("mount cgroup: Not implemented");
 }
 
+// Readonly bind mounts are made readonly by the returned remount entry, so
+// that later mounts can still create their destinations beneath them. Without
+// delay_readonly that happens before returning.
 [[nodiscard]] std::optional<remount_t> do_mount(container &container,
                                                 infra::Root &root,
-                                                const oci_config::mount_t &mount)
+                                                const oci_config::mount_t &mount,
+                                                bool delay_readonly = true,
+                                                utils::file_descriptor idmapped_tree = { })
 {
     LINYAPS_BOX_LOG_DEBUG(
       "Mount {} to {}",
@@ -539,9 +705,12 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
         is_sys_rbind = true;
     }
 
+    const auto new_mount_api = os::new_mount_api_supported();
+    auto is_bind = (mount.vfs_flags & MS_BIND) != 0;
+
     utils::file_descriptor destination_fd;
-    if ((mount.vfs_flags & MS_BIND) != 0) {
-        destination_fd = do_bind_mount(root, mount);
+    if (is_bind) {
+        destination_fd = do_bind_mount(root, mount, std::move(idmapped_tree));
 
         if (mount.destination == "/dev") {
             container.set_mount_dev_from_host();
@@ -569,6 +738,12 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
                     destination_fd = os::throw_if_error(
                       root.open(mount.destination,
                                 { os::sys::open_flag::cloexec, os::sys::access_mode::path }));
+                    is_bind = true;
+                    if (new_mount_api) {
+                        do_mount_setattr(destination_fd,
+                                         to_mount_attr(mount.vfs_flags & ~MS_RDONLY),
+                                         false);
+                    }
 
                     // mask /sys/fs/cgroup to prevent host cgroup leakage unless explicitly mounted
                     auto has_cgroup_mount =
@@ -603,6 +778,47 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
         }
     }
 
+    // if the mount destination is root, we need to reopen it after mount
+    // to refresh the file descriptor, otherwise it may cause some unexpected behavior
+    auto maybe_refresh_root = [&root, &mount] {
+        if (mount.destination == "/") {
+            os::throw_if_error(root.reopen());
+        }
+    };
+
+    if (new_mount_api) {
+        if (!is_bind && (mount.propagation_flags != 0 || mount.rec_attr)) {
+            // the fd opened before mounting refers to the covered directory
+            destination_fd = os::throw_if_error(
+              root.open(mount.destination,
+                        { os::sys::open_flag::cloexec, os::sys::access_mode::path }));
+            if (mount.rec_attr) {
+                do_mount_setattr(destination_fd, to_mount_attr(*mount.rec_attr), true);
+            }
+        }
+
+        do_propagation_setattr(destination_fd, mount.propagation_flags);
+        maybe_refresh_root();
+
+        // mount(2) has applied MS_RDONLY to anything but bind mounts, and the
+        // procfs options don't need a remount since kernel 5.7
+        const auto rec_rdonly = mount.rec_attr
+          && (mount.rec_attr->set & os::sys::mount_attr_rdonly) != 0;
+        if (!is_bind || ((mount.vfs_flags & MS_RDONLY) == 0 && !rec_rdonly)) {
+            return std::nullopt;
+        }
+
+        auto readonly =
+          remount_t{ std::move(destination_fd), MS_BIND | MS_REMOUNT | MS_RDONLY, { }, rec_rdonly };
+        if (!delay_readonly) {
+            do_remount(readonly);
+            return std::nullopt;
+        }
+
+        LINYAPS_BOX_LOG_DEBUG("readonly delayed");
+        return readonly;
+    }
+
     if (auto prop_flags = mount.propagation_flags; prop_flags != 0) {
         do_propagation_mount(destination_fd, prop_flags);
     }
@@ -622,14 +838,6 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
         need_remount = true;
     }
 
-    // if the mount destination is root, we need to reopen it after mount
-    // to refresh the file descriptor, otherwise it may cause some unexpected behavior
-    auto maybe_refresh_root = [&root, &mount] {
-        if (mount.destination == "/") {
-            os::throw_if_error(root.reopen());
-        }
-    };
-
     maybe_refresh_root();
 
     if (!need_remount) {
@@ -647,7 +855,7 @@ auto do_propagation_mount(const utils::file_descriptor &destination, unsigned lo
     }
 
     auto delay_readonly_mount = remount_t{ std::move(destination_fd), remount_flags, mount.data };
-    if ((remount_flags & MS_RDONLY) == 0) {
+    if ((remount_flags & MS_RDONLY) == 0 || !delay_readonly) {
         // if not readonly mount, just remount directly
         LINYAPS_BOX_LOG_DEBUG("remount {} directly", mount.destination);
         do_remount(delay_readonly_mount);
@@ -686,11 +894,17 @@ class mounter
     }
 
 public:
-    explicit mounter(infra::Root rootfd, container &container)
+    explicit mounter(infra::Root rootfd,
+                     container &container,
+                     std::vector<utils::file_descriptor> idmapped_trees)
         : container(container)
         , root(std::move(rootfd))
+        , idmapped_trees(std::move(idmapped_trees))
     {
         remounts.reserve(this->container.get().get_config().mounts.size());
+        LINYAPS_BOX_LOG_DEBUG("mount with {}",
+                              os::new_mount_api_supported() ? "open_tree/move_mount/mount_setattr"
+                                                            : "mount(2)");
     }
 
     void configure_rootfs()
@@ -748,6 +962,8 @@ public:
         // reopen rootfs after mount to refresh vfs state
         os::throw_if_error(root.reopen());
 
+        // Unlike readonly paths this stays non recursive: once it is applied the
+        // container's own /proc, /dev and tmpfs mounts sit beneath the rootfs.
         if (oci_config.root->readonly) {
             LINYAPS_BOX_LOG_DEBUG("remount bind rootfs to readonly");
             remount_t remount;
@@ -759,13 +975,15 @@ public:
 
     void do_mounts()
     {
-        for (const auto &mount : container.get().get_config().mounts) {
-            this->mount(mount);
+        const auto &mounts = container.get().get_config().mounts;
+        for (std::size_t i = 0; i < mounts.size(); ++i) {
+            this->mount(mounts[i], std::move(idmapped_trees[i]));
         }
     }
 
-    void mount(const oci_config::mount_t &mount)
+    void mount(const oci_config::mount_t &mount, utils::file_descriptor idmapped_tree = { })
     {
+        const utils::phase_scope phase{ "mount", mount.destination.native() };
         LINYAPS_BOX_LOG_DEBUG("do mount");
         if ((mount.extension_flags & oci_config::mount_t::extension::COPY_SYMLINK)
             == oci_config::mount_t::extension::COPY_SYMLINK) {
@@ -806,7 +1024,7 @@ public:
             return;
         }
 
-        auto delay_mount = do_mount(container, root, mount);
+        auto delay_mount = do_mount(container, root, mount, true, std::move(idmapped_tree));
         if (!delay_mount.has_value()) {
             return;
         }
@@ -814,6 +1032,44 @@ public:
         remounts.push_back(std::move(delay_mount).value());
     }
 
+    // Written through the container's own procfs, after it is mounted and before
+    // readonlyPaths (usually /proc/sys) make it readonly. One directory fd serves
+    // every key.
+    void write_sysctl()
+    {
+        const auto &linux = container.get().get_config().linux;
+        if (!linux || !linux->sysctl || linux->sysctl->empty()) {
+            return;
+        }
+
+        auto res = root.open("/proc/sys",
+                             { os::sys::open_flag::cloexec | os::sys::open_flag::directory,
+                               os::sys::access_mode::read_only });
+        if (UNLIKELY(!res)) {
+            throw std::system_error(res.error(),
+                                    "failed to open /proc/sys under rootfs, is /proc mounted?");
+        }
+        const auto dir = std::move(res).value();
+
+        for (const auto &[key, value] : *linux->sysctl) {
+            auto path = key;
+            std::replace(path.begin(), path.end(), '.', '/');
+
+            auto file = os::throw_if_error(
+              os::openat(dir.ref(),
+                         path,
+                         { os::sys::open_flag::cloexec, os::sys::access_mode::write_only }),
+              fmt::format("failed to open sysctl {}", key));
+
+            LINYAPS_BOX_LOG_DEBUG("set sysctl {}={}", key, value);
+            if (UNLIKELY(::write(file.get(), value.data(), value.size()) < 0)) {
+                throw std::system_error(errno,
+                                        std::system_category(),
+                                        fmt::format("failed to set sysctl {}", key));
+            }
+        }
+    }
+
     void make_path_readonly()
     {
         const auto &linux = container.get().get_config().linux;
@@ -838,6 +1094,11 @@ public:
             }
 
             auto dst = std::move(dst_res).value();
+            if (os::new_mount_api_supported()) {
+                make_readonly_recursive(dst, path);
+                continue;
+            }
+
             auto dst_ref = dst.ref();
             auto vfs_flag = MS_BIND | MS_RDONLY | MS_REC;
             auto prop_flag = MS_PRIVATE | MS_REC;
@@ -908,13 +1169,9 @@ public:
                 mount.type = "tmpfs";
                 mount.data = "size=0k";
 
+                // nothing is created beneath a masked path, no need to delay the readonly remount
                 LINYAPS_BOX_LOG_DEBUG("mask directory {}", path.string());
-                auto delay_mount = do_mount(container, root, mount);
-                if (!delay_mount) {
-                    throw std::runtime_error("mask directory " + path.string()
-                                             + " did not produce a remount entry");
-                }
-                remounts.emplace_back(std::move(delay_mount).value());
+                std::ignore = do_mount(container, root, mount, false);
                 continue;
             }
 
@@ -922,12 +1179,7 @@ public:
             mount.vfs_flags |= MS_BIND;
 
             LINYAPS_BOX_LOG_DEBUG("mask file {}", path.string());
-            auto delay_mount = do_mount(container, root, mount);
-            if (!delay_mount) {
-                throw std::runtime_error("mask file " + path.string()
-                                         + " did not produce a remount entry");
-            }
-            remounts.emplace_back(std::move(delay_mount).value());
+            std::ignore = do_mount(container, root, mount, false);
         }
     }
 
@@ -949,6 +1201,36 @@ private:
     std::reference_wrapper<linyaps_box::container> container;
     infra::Root root;
     std::vector<remount_t> remounts;
+    // see initialize_container
+    std::vector<utils::file_descriptor> idmapped_trees;
+
+    // A mount root is made readonly in place, together with everything mounted
+    // beneath it. Any other path gets a recursive clone of itself, made private
+    // and readonly while detached, on top of it. mount_setattr only touches the
+    // requested attributes, so nothing has to be inherited via fstatfs.
+    static void make_readonly_recursive(const utils::file_descriptor &dst,
+                                        const std::filesystem::path &path)
+    {
+        LINYAPS_BOX_LOG_DEBUG("make readonly path {} recursively", path.string());
+
+        os::sys::mount_attr attr{ };
+        attr.attr_set = os::sys::mount_attr_rdonly;
+
+        auto ret = os::mount_setattr(dst.ref(), attr, true);
+        if (ret) {
+            return;
+        }
+
+        // EINVAL: not a mount root
+        if (ret.error() != std::errc::invalid_argument) {
+            throw std::system_error(ret.error(), fmt::format("make {} readonly", path.string()));
+        }
+
+        auto tree = os::throw_if_error(os::open_tree_clone(dst.ref(), true), "open_tree");
+        attr.propagation = MS_PRIVATE;
+        do_mount_setattr(tree, attr, true);
+        os::throw_if_error(os::move_mount(tree.ref(), dst.ref()), "move_mount");
+    }
 
     // Creates default device nodes mandated by the OCI runtime spec.
     // https://github.com/opencontainers/runtime-spec/blob/main/config-linux.md#default-devices
@@ -1102,7 +1384,9 @@ private:
     }
 };
 
-void configure_mounts(container &container, const std::filesystem::path &rootfs)
+void configure_mounts(container &container,
+                      const std::filesystem::path &rootfs,
+                      std::vector<utils::file_descriptor> idmapped_trees)
 {
     LINYAPS_BOX_LOG_DEBUG("=== configure_mounts START ===");
     LINYAPS_BOX_LOG_DEBUG("Configure mounts");
@@ -1110,26 +1394,54 @@ void configure_mounts(container &container, const std::filesystem::path &rootfs)
     const auto &oci_config = container.get_config();
 
     if (oci_config.mounts.empty()) {
+        if (UNLIKELY(oci_config.linux && oci_config.linux->sysctl
+                     && !oci_config.linux->sysctl->empty())) {
+            throw std::runtime_error("linux.sysctl requires /proc to be mounted in the container");
+        }
+
         LINYAPS_BOX_LOG_DEBUG("Nothing to do");
         return;
     }
 
-    auto m = std::make_unique<mounter>(os::throw_if_error(infra::Root::open(rootfs)), container);
+    auto m = std::make_unique<mounter>(os::throw_if_error(infra::Root::open(rootfs)),
+                                       container,
+                                       std::move(idmapped_trees));
 
     LINYAPS_BOX_LOG_DEBUG("Processing mount points");
 
-    m->configure_rootfs();
-    m->do_mounts();
-    m->make_path_masked();
-    m->make_path_readonly();
-    m->finalize();
+    {
+        const utils::phase_scope phase{ "configure_rootfs" };
+        m->configure_rootfs();
+    }
+    {
+        const utils::phase_scope phase{ "do_mounts" };
+        m->do_mounts();
+    }
+    {
+        const utils::phase_scope phase{ "write_sysctl" };
+        m->write_sysctl();
+    }
+    {
+        const utils::phase_scope phase{ "make_path_masked" };
+        m->make_path_masked();
+    }
+    {
+        const utils::phase_scope phase{ "make_path_readonly" };
+        m->make_path_readonly();
+    }
+    {
+        const utils::phase_scope phase{ "finalize" };
+        m->finalize();
+    }
 
     LINYAPS_BOX_LOG_DEBUG("Mounts configured");
 }
 
-[[noreturn]] void execute_process(const oci_config &oci_config)
+// A filter given here is installed right before execvpe, so that it never
+// sees the syscalls of ll-box itself.
+[[noreturn]] void execute_process(const oci_config::process_t &process,
+                                  const security::seccomp_filter *seccomp)
 {
-    const auto &process = *oci_config.process;
 
     LINYAPS_BOX_LOG_DEBUG("Execute container process:{}", [&process]() -> std::string {
         std::stringstream ss;
@@ -1170,6 +1482,10 @@ void configure_mounts(container &container, const std::filesystem::path &rootfs)
           "current working directory is outside the container mount namespace");
     }
 
+    if (seccomp != nullptr) {
+        security::install_seccomp(*seccomp);
+    }
+
     ::execvpe(c_args.at(0),
               const_cast<char *const *>(c_args.data()),
               const_cast<char *const *>(c_env.data()));
@@ -1341,6 +1657,30 @@ void do_pivot_root(const container &container,
       container.rootfs_propagation());
 }
 
+// Tell the runtime that the container is created, then block until start writes
+// to the exec FIFO. Returns the process to execute.
+auto wait_for_start(int exec_fifo, child_message_channel &sync, oci_config::process_t process)
+  -> oci_config::process_t
+{
+    const utils::file_descriptor fifo{ exec_fifo };
+    LINYAPS_BOX_LOG_DEBUG("Waiting for the container to be started");
+    // nothing else may be sent until the FIFO is read, see wait_container_claimed
+    sync.send_stage(protocol::stage::type::created);
+
+    auto option = read_start_request(fifo.ref());
+    if (!option.args.empty()) {
+        process.args = std::move(option.args);
+    }
+    if (option.env) {
+        process.env = std::move(option.env);
+    }
+    if (option.cwd) {
+        process.cwd = std::move(*option.cwd);
+    }
+
+    return process;
+}
+
 void start_container_hooks(const container &container, const container_status &status)
 {
     const auto &oci_config = container.get_config();
@@ -1484,6 +1824,8 @@ int clone_fn(void *data) noexcept
     auto &args = *static_cast<clone_fn_args *>(data);
 
     try {
+        utils::phase_recorder::instance().rebind(utils::phase_origin::container);
+
         auto &logger = log::global_logger::instance();
         logger.set_forwarder(std::make_unique<protocol::sync_socket_forwarder>(args.sync));
 
@@ -1521,6 +1863,7 @@ int clone_fn(void *data) noexcept
 
         auto &container = *args.container;
         const auto &oci_config = container.get_config();
+        utils::apply_initial_cpu_affinity(*oci_config.process);
 
         auto rootfs = container.get_config().root->path;
         if (rootfs.is_relative()) {
@@ -1534,8 +1877,11 @@ int clone_fn(void *data) noexcept
         // container rootfs after the root switch.
         std::ignore = security::last_cap();
 
-        container_ns::initialize_container(container.get_config(), sync);
-        container_ns::configure_mounts(container, rootfs);
+        auto idmapped_trees = container_ns::initialize_container(container.get_config(), sync);
+        {
+            const utils::phase_scope phase{ "configure_mounts" };
+            container_ns::configure_mounts(container, rootfs, std::move(idmapped_trees));
+        }
         wait_prestart_hooks_result(oci_config, sync);
         wait_create_runtime_result(oci_config, sync);
 
@@ -1548,7 +1894,10 @@ int clone_fn(void *data) noexcept
                          [](const auto &ns) {
                              return ns.type_ == oci_config::linux_t::namespace_t::type::MOUNT;
                          });
-        do_pivot_root(container, rootfs, has_mount_ns);
+        {
+            const utils::phase_scope phase{ "do_pivot_root" };
+            do_pivot_root(container, rootfs, has_mount_ns);
+        }
 
         // NOTE: Cache the host root fd before pivot_root,
         // so that O_PATH fd is still usable for /proc/self/fd/<fd>
@@ -1556,6 +1905,7 @@ int clone_fn(void *data) noexcept
 
         utils::setsid();
         if (container.get_config().process->terminal.value_or(false)) {
+            const utils::phase_scope phase{ "configure_terminal" };
             configure_terminal(container, sync);
         }
 
@@ -1565,11 +1915,29 @@ int clone_fn(void *data) noexcept
         }
         // processing all extensions before drop capabilities
         processing_extensions(oci_config);
+        utils::apply_scheduling(*oci_config.process, oci_config.annotations);
+        if (oci_config.linux && oci_config.linux->memory_policy) {
+            utils::apply_memory_policy(*oci_config.linux->memory_policy);
+        }
 
-        security::privilege_context ctx{ oci_config.process->user };
-        ctx.set_capabilities(oci_config.process->capabilities)
-          .set_no_new_privs(oci_config.process->no_new_privileges.value_or(false));
-        ctx.apply();
+        const auto no_new_privs = oci_config.process->no_new_privileges.value_or(false);
+        const auto &seccomp = container.seccomp();
+        {
+            const utils::phase_scope phase{ "drop_privileges" };
+            // without no_new_privs the filter needs CAP_SYS_ADMIN, which is about to go
+            if (seccomp && !no_new_privs) {
+                security::install_seccomp(*seccomp);
+            }
+
+            security::privilege_context ctx{ oci_config.process->user };
+            ctx.set_capabilities(oci_config.process->capabilities).set_no_new_privs(no_new_privs);
+            ctx.apply();
+        }
+
+        std::optional<oci_config::process_t> started;
+        if (args.exec_fifo >= 0) {
+            started = wait_for_start(args.exec_fifo, sync, *oci_config.process);
+        }
 
         start_container_hooks(container, status);
 
@@ -1579,9 +1947,12 @@ int clone_fn(void *data) noexcept
         utils::sigprocmask(SIG_UNBLOCK, set, nullptr);
         utils::reset_signals(set);
 
+        utils::apply_final_cpu_affinity(*oci_config.process);
+
         args.sync.send_stage(protocol::stage::type::exec_ready);
 
-        execute_process(oci_config);
+        execute_process(started ? *started : *oci_config.process,
+                        seccomp && no_new_privs ? &*seccomp : nullptr);
         // NOTE: Child process errors are intentionally logged and then swallowed
         // here. The parent process is NOT notified via a typed error message.
         // This is by design: the child's error boundary is isolated from the
@@ -1758,8 +2129,95 @@ void set_rlimits(const std::vector<oci_config::process_t::rlimit_t> &rlimits)
                   });
 }
 
-std::pair<int, parent_message_channel> start_container_process(container &container,
-                                                               run_container_options_t &options)
+struct container_process_t
+{
+    pid_t pid{ -1 };
+    // invalid when neither clone3(2) nor pidfd_open(2) is available
+    utils::file_descriptor pidfd;
+    // whether the process was started inside the cgroup passed to start_container_process
+    bool in_cgroup{ false };
+};
+
+// clone3(2) returns a pidfd for exactly the process it created, and with a cgroup
+// directory the child starts there instead of being migrated after the fact.
+// Returns std::nullopt when clone3 is unavailable, e.g. before kernel 5.3 or under
+// a seccomp filter that answers ENOSYS for it.
+[[nodiscard]] auto clone3_container_process(int clone_flag,
+                                            utils::file_descriptor_ref cgroup_dirfd,
+                                            clone_fn_args &args)
+  -> std::optional<container_process_t>
+{
+    int pidfd{ -1 };
+    os::sys::clone_args cl_args{ };
+    cl_args.flags = (static_cast<uint64_t>(clone_flag) & ~uint64_t{ CSIGNAL })
+      | os::sys::clone_pidfd;
+    cl_args.exit_signal = static_cast<uint64_t>(clone_flag) & CSIGNAL;
+    cl_args.pidfd = reinterpret_cast<uintptr_t>(&pidfd);
+    if (cgroup_dirfd.is_valid()) {
+        cl_args.flags |= os::sys::clone_into_cgroup;
+        cl_args.cgroup = static_cast<uint64_t>(cgroup_dirfd.get());
+    }
+
+    auto ret = os::clone3(cl_args);
+    if (!ret && cgroup_dirfd.is_valid()
+        && ret.error() == std::errc::argument_list_too_long) {
+        // the cgroup field needs kernel 5.7, let the caller migrate the process
+        LINYAPS_BOX_LOG_DEBUG("CLONE_INTO_CGROUP is not supported, clone without it");
+        cl_args.flags &= ~os::sys::clone_into_cgroup;
+        cl_args.cgroup = 0;
+        ret = os::clone3(cl_args);
+    }
+
+    if (!ret) {
+        if (ret.error() == std::errc::function_not_supported) {
+            return std::nullopt;
+        }
+
+        throw std::system_error(ret.error(), "clone3");
+    }
+
+    if (*ret == 0) {
+        _exit(container_ns::clone_fn(&args));
+    }
+
+    return container_process_t{ *ret,
+                                utils::file_descriptor{ pidfd },
+                                (cl_args.flags & os::sys::clone_into_cgroup) != 0 };
+}
+
+[[nodiscard]] auto clone_container_process(int clone_flag, clone_fn_args &args)
+  -> container_process_t
+{
+    const child_stack stack;
+    const int child_pid =
+      clone(container_ns::clone_fn, stack.top(), clone_flag, static_cast<void *>(&args));
+    if (child_pid < 0) {
+        throw std::runtime_error("clone failed");
+    }
+
+    if (child_pid == 0) {
+        throw std::logic_error("clone should not return in child");
+    }
+
+    // Not reaped yet, so the pid can not have been reused.
+    container_process_t process{ child_pid, { }, false };
+    if (auto pidfd = os::pidfd_open(child_pid); pidfd) {
+        process.pidfd = std::move(pidfd).value();
+    } else {
+        LINYAPS_BOX_LOG_DEBUG("pidfd_open is not available: {}", pidfd.error().message());
+    }
+
+    return process;
+}
+
+// When cgroup_dirfd is valid the container process should be started inside that
+// cgroup, check container_process_t::in_cgroup for whether that happened.
+// The container process of a created container blocks on exec_fifo until start.
+auto start_container_process(container &container,
+                             run_container_options_t &options,
+                             utils::file_descriptor_ref cgroup_dirfd,
+                             utils::file_descriptor_ref exec_fifo)
+  -> std::pair<container_process_t, parent_message_channel>
 {
     const auto &oci_config = container.get_config();
 
@@ -1776,24 +2234,96 @@ std::pair<int, parent_message_channel> start_container_process(container &contai
     }
 
     const int clone_flag = runtime_ns::generate_clone_flag(namespaces);
-    clone_fn_args args = { options.preserve_fds, &container, std::move(child) };
+    clone_fn_args args = { options.preserve_fds, &container, std::move(child), exec_fifo };
 
     LINYAPS_BOX_LOG_DEBUG("OCI runtime in runtime namespace: PID={} PIDNS={}",
                           getpid(),
                           get_pid_namespace());
 
-    const child_stack stack;
-    const int child_pid =
-      clone(container_ns::clone_fn, stack.top(), clone_flag, static_cast<void *>(&args));
-    if (child_pid < 0) {
-        throw std::runtime_error("clone failed");
+    const utils::phase_scope phase{ "clone" };
+    auto process = clone3_container_process(clone_flag, cgroup_dirfd, args);
+    if (!process) {
+        LINYAPS_BOX_LOG_DEBUG("clone3 is not available, fallback to clone");
+        process = clone_container_process(clone_flag, args);
     }
 
-    if (child_pid == 0) {
-        throw std::logic_error("clone should not return in child");
+    return { std::move(process).value(), std::move(parent) };
+}
+
+void enable_memory_reclaim(container_monitor &monitor,
+                           const oci_config &config,
+                           utils::file_descriptor_ref cgroup_dirfd)
+{
+    if (!config.annotations || !cgroup_dirfd.is_valid()) {
+        return;
+    }
+
+    // a missing memory controller or PSI support must not keep the app from running
+    try {
+        auto policy = parse_memory_reclaim_policy(*config.annotations);
+        if (!policy) {
+            return;
+        }
+
+        LINYAPS_BOX_LOG_DEBUG("Register PSI trigger \"{}\"", to_psi_trigger(*policy));
+        monitor.enable_memory_reclaim(cgroup_dirfd, std::move(*policy));
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_WARN("memory reclaim is disabled: {}", e.what());
+    }
+}
+
+// Callers fall back to the status directory without it, e.g. when the socket path
+// does not fit in sun_path.
+void enable_control(container_monitor &monitor,
+                    const std::filesystem::path &socket,
+                    container_status status)
+{
+    try {
+        monitor.enable_control(infra::unix_socket::listen(socket), std::move(status));
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_DEBUG("control socket is disabled: {}", e.what());
+    }
+}
+
+void report_usage(const container_monitor &monitor,
+                  utils::file_descriptor_ref cgroup_dirfd,
+                  int exit_code,
+                  const std::optional<std::filesystem::path> &path)
+{
+    utils::usage_report report;
+    report.exit_code = exit_code;
+    report.container = monitor.usage();
+    report.descendants = monitor.descendants();
+    if (cgroup_dirfd.is_valid()) {
+        report.cgroup = utils::read_cgroup_usage(cgroup_dirfd);
+    }
+
+    LINYAPS_BOX_LOG_DEBUG("Container resource usage: {}", utils::to_string(report));
+
+    if (!path) {
+        return;
+    }
+
+    try {
+        utils::write_usage_report(*path, report);
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_WARN("failed to write usage report: {}", e.what());
     }
+}
 
-    return { child_pid, std::move(parent) };
+// Used when the container process could not be started inside its cgroup.
+void enter_cgroup(utils::file_descriptor_ref cgroup_dirfd, pid_t pid)
+{
+    auto procs = os::throw_if_error(
+      os::openat(cgroup_dirfd,
+                 "cgroup.procs",
+                 { os::sys::open_flag::cloexec, os::sys::access_mode::write_only }),
+      "open cgroup.procs");
+    const auto content = std::to_string(pid);
+    if (::write(procs.get(), content.data(), content.size())
+        != static_cast<ssize_t>(content.size())) {
+        throw std::system_error(errno, std::system_category(), "write to cgroup.procs");
+    }
 }
 
 [[nodiscard]] int execute_user_namespace_helper(const std::vector<std::string> &args)
@@ -2070,9 +2600,80 @@ void configure_uid_mapping(pid_t pid, const container &container)
 void configure_container_cgroup([[maybe_unused]] const container &container)
 {
     LINYAPS_BOX_LOG_DEBUG("Configure container cgroup");
-    // TODO: impl
-    // enter cgroup -> wait container ready -> enter finalize ->
-    // do some other settings -> configuration done
+    // The container process is already in its cgroup with all resources applied,
+    // see container::cgroup_preenter.
+    // TODO: settings that need the container to be ready first
+}
+
+// The user namespace of an idmapped mount needs mappings against our user
+// namespace, the container process is already in its own. So the mounts are
+// cloned and idmapped here, and attached by the container process.
+void send_idmapped_mounts(const container &container, parent_message_channel &sync)
+{
+    const auto &config = container.get_config();
+    // shared by the mounts with the same mappings, keyed by their contents
+    std::unordered_map<std::string, utils::file_descriptor> usernses;
+    for (std::size_t i = 0; i < config.mounts.size(); ++i) {
+        const auto &mount = config.mounts[i];
+        if (!is_idmapped(mount)) {
+            continue;
+        }
+
+        if (UNLIKELY((mount.vfs_flags & MS_BIND) == 0)) {
+            throw std::invalid_argument(
+              fmt::format("idmapped mount {} must be a bind mount", mount.destination.string()));
+        }
+
+        if (UNLIKELY(!os::new_mount_api_supported())) {
+            throw std::runtime_error("idmapped mounts require Linux 5.12 or later");
+        }
+
+        if (UNLIKELY(!mount.source)) {
+            throw std::invalid_argument("bind mount requires source");
+        }
+
+        // validate() makes sure the mappings of a mount come in pairs, mounts
+        // without their own use the container's
+        const auto *uid_mappings = &mount.uid_mappings;
+        const auto *gid_mappings = &mount.gid_mappings;
+        if (!*uid_mappings && config.linux) {
+            uid_mappings = &config.linux->uid_mappings;
+            gid_mappings = &config.linux->gid_mappings;
+        }
+
+        if (UNLIKELY(!*uid_mappings || !*gid_mappings)) {
+            throw std::invalid_argument(
+              fmt::format("idmapped mount {} has no uidMappings/gidMappings, neither does the "
+                          "container",
+                          mount.destination.string()));
+        }
+
+        auto uid_map = utils::format_id_mappings(**uid_mappings);
+        auto gid_map = utils::format_id_mappings(**gid_mappings);
+        auto key = uid_map + '\0' + gid_map;
+        auto it = usernses.find(key);
+        if (it == usernses.end()) {
+            LINYAPS_BOX_LOG_DEBUG("create user namespace for idmapped mounts\n{}{}",
+                                  uid_map,
+                                  gid_map);
+            it = usernses.emplace(std::move(key), utils::create_idmap_userns(uid_map, gid_map))
+                   .first;
+        }
+
+        auto source = os::throw_if_error(
+          os::open(*mount.source, { os::sys::open_flag::cloexec, os::sys::access_mode::path }));
+        auto tree = container_ns::clone_bind_tree(source.ref(), mount);
+
+        // only possible while the tree is detached
+        os::sys::mount_attr attr{ };
+        attr.attr_set = os::sys::mount_attr_idmap;
+        attr.userns_fd = static_cast<uint64_t>(it->second.get());
+        container_ns::do_mount_setattr(tree,
+                                       attr,
+                                       mount.idmap == oci_config::mount_t::idmap_type::RIDMAP);
+
+        sync.send_mount_fd(static_cast<std::uint32_t>(i), tree.ref());
+    }
 }
 
 void configure_container_namespaces(container &container, parent_message_channel &sync)
@@ -2109,16 +2710,23 @@ void configure_container_namespaces(container &container, parent_message_channel
                 // TODO: if not mapping a range of uid/gid, we could set uid/gid in the
                 // container process
                 if (const auto &uid_mappings = linux->uid_mappings; uid_mappings) {
+                    const utils::phase_scope phase{ "uid_mapping" };
                     configure_uid_mapping(pid, container);
                 }
 
                 if (const auto &gid_mappings = linux->gid_mappings; gid_mappings) {
+                    const utils::phase_scope phase{ "gid_mapping" };
                     configure_gid_mapping(pid, container);
                 }
             }
         }
     }
 
+    {
+        const utils::phase_scope phase{ "idmapped_mounts" };
+        send_idmapped_mounts(container, sync);
+    }
+
     configure_container_cgroup(container);
 
     LINYAPS_BOX_LOG_DEBUG("Container namespaces configured");
@@ -2190,10 +2798,82 @@ void wait_create_container_result(const container &container, parent_message_cha
     LINYAPS_BOX_LOG_DEBUG("Create container hooks executed");
 }
 
+// Opened for both reading and writing, so neither side blocks in open(2) and
+// the container process never sees EOF while waiting.
+auto create_exec_fifo(const std::filesystem::path &path) -> utils::file_descriptor
+{
+    os::throw_if_error(os::mknodat(utils::file_descriptor_ref::cwd(),
+                                   path,
+                                   std::filesystem::file_type::fifo,
+                                   std::filesystem::perms::owner_read
+                                     | std::filesystem::perms::owner_write,
+                                   0),
+                       fmt::format("failed to create {}", path));
+
+    return os::throw_if_error(
+      os::open(path, { os::sys::open_flag::cloexec, os::sys::access_mode::read_write }));
+}
+
+// Let the caller of a detached monitor return.
+void notify_caller(utils::file_descriptor notify)
+{
+    const std::byte ready{ 1 };
+    os::throw_if_error(io::write_all(notify.ref(), utils::span{ &ready, 1 }),
+                       "failed to notify the caller");
+}
+
+void wait_container_created(parent_message_channel &sync, utils::file_descriptor notify)
+{
+    LINYAPS_BOX_LOG_DEBUG("Waiting for container process to be created");
+    sync.wait_for_stage(stage::type::created);
+
+    notify_caller(std::move(notify));
+    LINYAPS_BOX_LOG_DEBUG("Container created, waiting for start");
+}
+
+// Nothing reads from or writes to the caller's terminal after it returned, the
+// container process holds its own copies. stderr stays for the log.
+void detach_stdio()
+{
+    auto null = os::throw_if_error(
+      os::open("/dev/null", { os::sys::open_flag::cloexec, os::sys::access_mode::read_write }));
+    for (const int fd : { STDIN_FILENO, STDOUT_FILENO }) {
+        if (::dup2(null.get(), fd) < 0) {
+            throw std::system_error(errno, std::system_category(), "dup2");
+        }
+    }
+}
+
+// Unlinking the exec FIFO is what claims a created container, so the monitor
+// only tears it down when it wins that race against start.
+void wait_container_claimed(parent_message_channel &sync,
+                            const std::filesystem::path &exec_fifo,
+                            std::chrono::seconds idle_timeout)
+{
+    // the container process is silent until it is started or dies
+    const auto deadline = std::chrono::steady_clock::now() + idle_timeout;
+    for (auto now = std::chrono::steady_clock::now(); now < deadline;
+         now = std::chrono::steady_clock::now()) {
+        if (sync.readable(std::chrono::ceil<std::chrono::milliseconds>(deadline - now))) {
+            return;
+        }
+    }
+
+    if (::unlink(exec_fifo.c_str()) != 0) {
+        return;
+    }
+
+    throw std::runtime_error(
+      fmt::format("container was not started within {}s", idle_timeout.count()));
+}
+
 void wait_container_started(parent_message_channel &sync)
 {
     LINYAPS_BOX_LOG_DEBUG("Waiting for container process to start");
     sync.wait_for_stage(stage::type::exec_ready);
+
+    // the socket is CLOEXEC, so its close marks the end of execve in the container
+    const utils::phase_scope phase{ "exec" };
     sync.wait_for_close();
     LINYAPS_BOX_LOG_DEBUG("Container process started successfully");
 }
@@ -2216,8 +2896,44 @@ void poststop_hooks(const container &container) noexcept
         return;
     }
 
-    auto state = container.status();
-    for (const auto &hook : container.get_config().hooks->poststop.value()) {
+    try {
+        run_poststop_hooks(container.get_config(), container.status());
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_ERROR("failed to get container state for poststop hooks: {}", e.what());
+    }
+}
+
+// Everything else about the container is in its status directory already.
+void hand_over(const infra::unix_socket &handoff,
+               pid_t pid,
+               std::optional<terminal_master> master)
+{
+    LINYAPS_BOX_LOG_DEBUG("Hand container process {} over to the supervisor", pid);
+
+    const auto message = nlohmann::json{ { "pid", pid } }.dump();
+    const utils::span<const std::byte> data{ reinterpret_cast<const std::byte *>(message.data()),
+                                             message.size() };
+
+    std::vector<utils::file_descriptor_ref> fds;
+    if (master) {
+        fds.push_back(master->fd().ref());
+    }
+
+    os::throw_if_error(handoff.send_data_with_fds(data, fds), "failed to hand over container");
+}
+
+} // namespace runtime_ns
+
+} // namespace
+
+void linyaps_box::run_poststop_hooks(const oci_config &config,
+                                     const container_status &state) noexcept
+{
+    if (!config.hooks || !config.hooks->poststop) {
+        return;
+    }
+
+    for (const auto &hook : config.hooks->poststop.value()) {
         try {
             execute_hook(hook, state);
         } catch (const std::exception &e) {
@@ -2226,10 +2942,6 @@ void poststop_hooks(const container &container) noexcept
     }
 }
 
-} // namespace runtime_ns
-
-} // namespace
-
 container::container(status_directory status_dir, const create_container_options_t &options)
     : container_ref(std::move(status_dir), options.ID)
     , bundle(std::filesystem::canonical(options.bundle))
@@ -2240,7 +2952,29 @@ container::container(status_directory status_dir, const create_container_options
     }
 
     LINYAPS_BOX_LOG_DEBUG("load oci_config from {}", config_path);
-    this->config = oci_config::parse(config_path);
+    {
+        const utils::phase_scope phase{ "parse_config" };
+        if (options.config_cache_dir.empty()) {
+            this->config = oci_config::parse(config_path);
+        } else {
+            // the key of the cache file only needs to be stable, the identity of
+            // config.json itself is verified by the cache header
+            auto name = fmt::format(
+              "{:016x}.bin",
+              std::hash<std::string>{ }(std::filesystem::absolute(config_path).string()));
+            this->config = config::parse_cached(config_path,
+                                                options.config_cache_dir / std::move(name),
+                                                config::shared_cache_entries);
+        }
+    }
+    if (this->config.linux && this->config.linux->seccomp) {
+        const utils::phase_scope phase{ "compile_seccomp" };
+        seccomp_ = security::load_or_compile_seccomp(*this->config.linux->seccomp,
+                                                     security::default_syscall_resolver(),
+                                                     options.config_cache_dir,
+                                                     config::shared_cache_entries);
+    }
+
     auto &mount = this->config.mounts;
     std::for_each(mount.begin(), mount.end(), [this](oci_config::mount_t &mount) {
         if (mount.destination.is_relative()) {
@@ -2273,8 +3007,10 @@ container::container(status_directory status_dir, const create_container_options
     case cgroup_manager_t::disabled: {
         this->manager = std::make_unique<disabled_cgroup_manager>();
     } break;
+    case cgroup_manager_t::cgroupfs: {
+        this->manager = std::make_unique<cgroupfs_manager>();
+    } break;
     case cgroup_manager_t::systemd:
-    case cgroup_manager_t::cgroupfs:
         throw std::runtime_error("unsupported cgroup manager");
     }
 }
@@ -2293,16 +3029,18 @@ const std::filesystem::path &container::get_bundle() const
 int container::run(run_container_options_t options)
 {
     int container_process_exit_code{ EXIT_FAILURE };
+    const auto detached = options.created_notify || options.started_notify;
 
     os::throw_if_error(os::set_child_subreaper(true));
 
     // Declared outside try so catch blocks can access it for cleanup
     std::optional<container_monitor> monitor;
+    std::optional<cgroup_status> cgroup;
+    utils::file_descriptor cgroup_dirfd;
 
     try {
         // TODO: there are some thing that should be done before starting the container process
-        // e.g. do something before creating cgroup by selecting manager, selinux label, seccomp
-        // setup, etc.
+        // e.g. do something before creating cgroup by selecting manager, selinux label, etc.
 
         // block all signals so that we can't be interrupted
         sigset_t set;
@@ -2312,10 +3050,41 @@ int container::run(run_container_options_t options)
 
         umask(0);
 
-        // TODO: cgroup preenter
-        auto [child_pid, sync] = runtime_ns::start_container_process(*this, options);
+        // The manager may hand back the directory of a cgroup created in advance,
+        // the container process is then spawned straight into it.
+        {
+            cgroup_options cg_options;
+            if (this->config.annotations) {
+                cg_options.annotations = *this->config.annotations;
+            }
+            if (this->config.linux && this->config.linux->cgroups_path) {
+                cg_options.cgroup_path = *this->config.linux->cgroups_path;
+            }
+            cg_options.id = this->get_id();
+            cg_options.pid = -1;
+            if (this->config.linux) {
+                cg_options.resources = this->config.linux->resources;
+            }
+            cgroup = this->cgroup_preenter(cg_options, cgroup_dirfd);
+        }
 
-        monitor.emplace(child_pid);
+        utils::file_descriptor exec_fifo;
+        if (options.created_notify) {
+            exec_fifo = runtime_ns::create_exec_fifo(this->status_dir().exec_fifo());
+        }
+
+        auto [process, sync] = runtime_ns::start_container_process(*this,
+                                                                   options,
+                                                                   cgroup_dirfd.ref(),
+                                                                   exec_fifo.ref());
+        exec_fifo = { };
+        const auto child_pid = process.pid;
+
+        monitor.emplace(child_pid, std::move(process.pidfd));
+
+        if (cgroup_dirfd.valid() && !process.in_cgroup) {
+            runtime_ns::enter_cgroup(cgroup_dirfd.ref(), child_pid);
+        }
 
         container_status status;
         status.oci_version = oci_config::version;
@@ -2323,6 +3092,13 @@ int container::run(run_container_options_t options)
         status.pid = child_pid;
         status.bundle = this->bundle;
         status.created = std::chrono::system_clock::now();
+        if (cgroup) {
+            status.cgroup_path = cgroup->path();
+        }
+        if (options.created_notify) {
+            status.exec_fifo = this->status_dir().exec_fifo();
+            status.pool = options.pool;
+        }
 
         auto start_time = utils::read_process_start_time(child_pid);
         if (UNLIKELY(!start_time)) {
@@ -2344,7 +3120,10 @@ int container::run(run_container_options_t options)
             status.annotations = *this->config.annotations;
         }
 
-        this->status_dir().write(status);
+        {
+            const utils::phase_scope phase{ "write_status" };
+            this->status_dir().write(status);
+        }
 
         runtime_ns::configure_container_namespaces(*this, sync);
         runtime_ns::prestart_hooks(*this, sync);
@@ -2373,13 +3152,51 @@ int container::run(run_container_options_t options)
                        console_inc.body);
         }
 
+        if (options.created_notify) {
+            runtime_ns::wait_container_created(sync, *std::exchange(options.created_notify, { }));
+            if (options.idle_timeout) {
+                runtime_ns::wait_container_claimed(sync, status.exec_fifo, *options.idle_timeout);
+            }
+        }
+
         runtime_ns::wait_container_started(sync);
 
         runtime_ns::poststart_hooks(*this);
 
-        // TODO: support detach from the parent's process
+        if (options.startup_timing) {
+            try {
+                utils::write_phase_report(*options.startup_timing,
+                                          utils::phase_recorder::instance());
+            } catch (const std::exception &e) {
+                LINYAPS_BOX_LOG_WARN("failed to write startup timing: {}", e.what());
+            }
+        }
+
+        if (options.handoff) {
+            // the supervisor inherits the container process once we exit, and
+            // tears the container down after it
+            runtime_ns::hand_over(*options.handoff, child_pid, std::move(master));
+            return EXIT_SUCCESS;
+        }
+
         // Now we wait for the container process to exit
         monitor->enable_signal_forwarding();
+        runtime_ns::enable_memory_reclaim(*monitor, this->config, cgroup_dirfd.ref());
+        runtime_ns::enable_control(*monitor,
+                                   this->status_dir().control_socket(),
+                                   std::move(status));
+
+        if (options.started_notify) {
+            runtime_ns::notify_caller(*std::exchange(options.started_notify, { }));
+        }
+
+        if (detached) {
+            // the monitor lives as long as the container, keep it small
+            sync.close();
+            options.console_socket.reset();
+            runtime_ns::detach_stdio();
+            this->shed_config();
+        }
 
         auto in = utils::file_descriptor{ STDIN_FILENO, false };
         auto out = utils::file_descriptor{ STDOUT_FILENO, false };
@@ -2420,6 +3237,11 @@ int container::run(run_container_options_t options)
         container_process_exit_code = monitor->wait_container_exit();
 
         runtime_ns::poststop_hooks(*this);
+
+        runtime_ns::report_usage(*monitor,
+                                 cgroup_dirfd.ref(),
+                                 container_process_exit_code,
+                                 options.usage_report);
     } catch (const std::exception &e) {
         if (monitor) {
             monitor->kill_child();
@@ -2428,19 +3250,98 @@ int container::run(run_container_options_t options)
         LINYAPS_BOX_LOG_ERROR("failed to run a container, caused by: {}", e.what());
     }
 
-    this->status_dir().remove();
+    if (cgroup) {
+        try {
+            this->manager->destroy_cgroup(*cgroup);
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_WARN("failed to destroy cgroup: {}", e.what());
+        }
+    }
 
-    // TODO: cleanup cgroup
+    this->status_dir().remove();
 
     return container_process_exit_code;
 }
 
-void container::cgroup_preenter(const cgroup_options &options, utils::file_descriptor &dirfd)
+int container::create(run_container_options_t options)
 {
-    auto type = utils::get_cgroup_type();
-    if (type != utils::cgroup_t::unified) {
-        return;
+    return this->spawn_monitor(std::move(options), true);
+}
+
+int container::run_detached(run_container_options_t options)
+{
+    return this->spawn_monitor(std::move(options), false);
+}
+
+auto container::spawn_monitor(run_container_options_t options, bool wait_for_start) -> int
+{
+    std::array<int, 2> fds{ };
+    if (UNLIKELY(::pipe2(fds.data(), O_CLOEXEC) != 0)) {
+        throw std::system_error(errno, std::system_category(), "pipe2");
+    }
+    utils::file_descriptor reader{ fds[0] };
+    utils::file_descriptor writer{ fds[1] };
+
+    auto monitor = ::fork();
+    if (UNLIKELY(monitor < 0)) {
+        throw std::system_error(errno, std::system_category(), "fork");
+    }
+
+    if (monitor == 0) {
+        int ret{ EXIT_FAILURE };
+        try {
+            reader = { };
+            // the monitor outlives this command, keep it out of the caller's session
+            utils::setsid();
+            (wait_for_start ? options.created_notify : options.started_notify) =
+              std::move(writer);
+            ret = this->run(std::move(options));
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_ERROR("failed to start the container monitor: {}", e.what());
+        }
+        _exit(ret);
+    }
+
+    writer = { };
+
+    std::byte ready{ };
+    ssize_t ret{ 0 };
+    do {
+        ret = ::read(reader.get(), &ready, 1);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret == 1) {
+        return EXIT_SUCCESS;
+    }
+
+    // the monitor failed before the container got there and has logged why
+    while (::waitpid(monitor, nullptr, 0) < 0 && errno == EINTR) { }
+    throw std::runtime_error(fmt::format("failed to {} container {}",
+                                         wait_for_start ? "create" : "start",
+                                         this->get_id()));
+}
+
+void container::shed_config()
+{
+    oci_config rest;
+    if (config.hooks && config.hooks->poststop) {
+        rest.hooks.emplace();
+        rest.hooks->poststop = std::move(config.hooks->poststop);
+    }
+
+    config = std::move(rest);
+    seccomp_.reset();
+    utils::trim_heap();
+    LINYAPS_BOX_LOG_DEBUG("Monitor RSS after dropping the config: {} KiB",
+                          utils::current_rss_kib().value_or(-1));
+}
+
+auto container::cgroup_preenter(const cgroup_options &options, utils::file_descriptor &dirfd)
+  -> std::optional<cgroup_status>
+{
+    if (this->manager->type() == cgroup_manager_t::disabled) {
+        return std::nullopt;
     }
 
-    this->manager->precreate_cgroup(options, dirfd);
+    return this->manager->precreate_cgroup(options, dirfd);
 }
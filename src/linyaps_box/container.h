@@ -8,6 +8,7 @@
 #include "linyaps_box/config.h"
 #include "linyaps_box/container_ref.h"
 #include "linyaps_box/infra/unix_socket.h"
+#include "linyaps_box/security/seccomp.h"
 #include "linyaps_box/status_directory.h"
 #include "linyaps_box/utils/file_describer.h"
 
@@ -19,14 +20,36 @@ struct create_container_options_t
     std::string ID;
     std::filesystem::path bundle;
     std::filesystem::path config;
+    // Where parsed configs are cached across runs, empty disables the cache.
+    std::filesystem::path config_cache_dir;
 };
 
 struct run_container_options_t
 {
     int preserve_fds;
     std::optional<infra::unix_socket> console_socket;
+    std::optional<std::filesystem::path> startup_timing;
+    std::optional<std::filesystem::path> usage_report;
+    // Only create the container: its process waits for start right before
+    // executing the workload, and a byte is written here once it does.
+    std::optional<utils::file_descriptor> created_notify;
+    // Run detached: a byte is written here once the container process started.
+    std::optional<utils::file_descriptor> started_notify;
+    // The warm pool of a created container, recorded in its status.
+    std::string pool;
+    // Tear a created container down when nobody starts it in time.
+    std::optional<std::chrono::seconds> idle_timeout;
+    // Hand the started container over to a supervisor instead of monitoring it:
+    // {"pid": N} goes here together with the PTY master, if run owns one, and run
+    // returns without waiting or cleaning up. The supervisor has to be a child
+    // subreaper above this process to inherit the container process.
+    std::optional<infra::unix_socket> handoff;
 };
 
+// Run the poststop hooks of config with the state of the stopped container,
+// failures are only logged.
+void run_poststop_hooks(const oci_config &config, const container_status &state) noexcept;
+
 class container final : public container_ref
 {
 public:
@@ -40,8 +63,23 @@ public:
     [[nodiscard]] auto get_config() const -> const linyaps_box::oci_config &;
     [[nodiscard]] auto get_bundle() const -> const std::filesystem::path &;
     [[nodiscard]] auto run(run_container_options_t options) -> int;
+    // Run the container from a detached monitor process, returning once the
+    // container is created. The monitor keeps waiting for start and the exit.
+    [[nodiscard]] auto create(run_container_options_t options) -> int;
+    // Like create, but return once the container process started.
+    [[nodiscard]] auto run_detached(run_container_options_t options) -> int;
+
+    // Compiled from linux.seccomp when the container is created.
+    [[nodiscard]] auto seccomp() const noexcept -> const std::optional<security::seccomp_filter> &
+    {
+        return seccomp_;
+    }
+
+    // Keep only what a monitor needs after the container process started, and
+    // return the freed heap to the kernel.
+    void shed_config();
 
-    // TODO:: support fully container capabilities, e.g. create, start, stop, delete...
+    // TODO:: support fully container capabilities, e.g. stop, delete...
 
     ~container() noexcept override = default;
 
@@ -65,10 +103,13 @@ public:
     auto set_mount_dev_from_host() noexcept { mount_dev_from_host_ = true; }
 
 private:
-    void cgroup_preenter(const cgroup_options &options, utils::file_descriptor &dirfd);
+    auto cgroup_preenter(const cgroup_options &options, utils::file_descriptor &dirfd)
+      -> std::optional<cgroup_status>;
+    auto spawn_monitor(run_container_options_t options, bool wait_for_start) -> int;
     linyaps_box::oci_config config;
     std::filesystem::path bundle;
     std::unique_ptr<cgroup_manager> manager;
+    std::optional<security::seccomp_filter> seccomp_;
     unsigned long rootfs_propagation_{ 0 };
     gid_t host_gid_;
     uid_t host_uid_;
@@ -6,14 +6,19 @@
 
 #include "linyaps_box/log/macro.h"
 #include "linyaps_box/os/fs.h"
+#include "linyaps_box/os/net.h"
 #include "linyaps_box/os/process.h"
 #include "linyaps_box/os/tty.h"
+#include "linyaps_box/utils/defer.h"
 #include "linyaps_box/utils/signal.h"
 #include "linyaps_box/utils/utils.h"
 
+#include <fmt/format.h>
+
 #include <sys/signalfd.h>
 
 #include <algorithm>
+#include <poll.h>
 
 namespace linyaps_box {
 namespace {
@@ -76,8 +81,78 @@ void handle_fd_error(const struct epoll_event &ev,
     }
 }
 
+// Requests and replies are single SOCK_SEQPACKET messages of JSON.
+constexpr std::size_t max_control_request_size{ 4 * 1024 };
+constexpr std::size_t max_control_reply_size{ 64 * 1024 };
+// A monitor answers from memory, one that takes longer is busy tearing down.
+constexpr int control_timeout_ms{ 1000 };
+
+auto send_json(const infra::unix_socket &socket, const nlohmann::json &body)
+  -> os::Result<std::size_t>
+{
+    const auto data = body.dump();
+    // the peer may be gone already, and SIGPIPE would be forwarded to the container
+    return os::send(socket.fd().ref(),
+                    { reinterpret_cast<const std::byte *>(data.data()), data.size() },
+                    os::sys::send_flag::nosignal);
+}
+
 } // anonymous namespace
 
+auto query_monitor(const std::filesystem::path &socket, const nlohmann::json &request)
+  -> std::optional<nlohmann::json>
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(socket, ec)) {
+        return std::nullopt;
+    }
+
+    std::optional<infra::unix_socket> conn;
+    try {
+        conn = infra::unix_socket::connect(socket);
+    } catch (const std::exception &e) {
+        // a stale socket of a monitor that died
+        LINYAPS_BOX_LOG_DEBUG("monitor is not reachable on {}: {}", socket, e.what());
+        return std::nullopt;
+    }
+
+    if (!send_json(*conn, request)) {
+        return std::nullopt;
+    }
+
+    pollfd pfd{ conn->fd().get(), POLLIN, 0 };
+    int ret{ 0 };
+    while ((ret = ::poll(&pfd, 1, control_timeout_ms)) < 0 && errno == EINTR) { }
+    if (ret <= 0) {
+        LINYAPS_BOX_LOG_DEBUG("monitor on {} did not answer", socket);
+        return std::nullopt;
+    }
+
+    std::string buffer(max_control_reply_size, '\0');
+    auto bytes = conn->recv(utils::as_writable_bytes(utils::span(buffer)));
+    if (!bytes || *bytes == 0) {
+        return std::nullopt;
+    }
+
+    buffer.resize(*bytes);
+    nlohmann::json reply;
+    try {
+        reply = nlohmann::json::parse(buffer);
+    } catch (const nlohmann::json::exception &e) {
+        // truncated, or not a monitor at all
+        LINYAPS_BOX_LOG_DEBUG("unexpected reply of monitor on {}: {}", socket, e.what());
+        return std::nullopt;
+    }
+
+    if (auto it = reply.find("error"); it != reply.end()) {
+        throw std::system_error(reply.value("errno", EIO),
+                                std::system_category(),
+                                it->get<std::string>());
+    }
+
+    return reply;
+}
+
 auto container_monitor::enable_signal_forwarding() -> void
 {
     sigset_t set;
@@ -86,25 +161,52 @@ auto container_monitor::enable_signal_forwarding() -> void
 
     signal_fd = utils::create_signalfd(set);
 
+    // The pidfd turns readable as soon as the container process exits, no matter
+    // how many SIGCHLD got merged into one signalfd read in the meantime.
+    if (pidfd.valid()) {
+        auto pidfd_pollable = epoll.add(pidfd, EPOLLIN);
+        if (!UNLIKELY(pidfd_pollable)) {
+            throw std::runtime_error("failed to add pidfd to epoll");
+        }
+    }
+
     // Reap any children that exited before signalfd was installed.
     // Without this they'd become zombies — signalfd only delivers SIGCHLD
     // for future events.
+    reap_children();
+
+    auto signalfd_pollable = epoll.add(signal_fd, EPOLLIN);
+    if (!UNLIKELY(signalfd_pollable)) {
+        throw std::runtime_error("failed to add signalfd to epoll");
+    }
+}
+
+auto container_monitor::reap_children() -> void
+{
+    // SIGCHLD coalesces and we are a subreaper, so one notification may stand for
+    // any number of exited descendants. Drain them all.
     while (true) {
         int status{ 0 };
-        auto ret = linyaps_box::os::waitpid(-1, status, WNOHANG);
+        struct rusage ru{ };
+        auto ret = linyaps_box::os::wait4(-1, status, WNOHANG, ru);
         if (!ret || *ret == 0) {
             break;
         }
 
-        if (*ret == pid) {
-            child_exited = true;
-            exit_code = os::throw_if_error(os::get_exit_code(status));
+        if (*ret != pid) {
+            utils::accumulate(descendants_usage, ru);
+            continue;
         }
-    }
 
-    auto signalfd_pollable = epoll.add(signal_fd, EPOLLIN);
-    if (!UNLIKELY(signalfd_pollable)) {
-        throw std::runtime_error("failed to add signalfd to epoll");
+        utils::accumulate(container_usage, ru);
+        child_exited = true;
+        exit_code = os::throw_if_error(os::get_exit_code(status));
+
+        // a reaped pidfd stays readable forever
+        if (pidfd.valid()) {
+            epoll.remove(pidfd);
+            pidfd.close();
+        }
     }
 }
 
@@ -124,16 +226,7 @@ auto container_monitor::handle_signals() -> void
 
         switch (info.ssi_signo) {
         case SIGCHLD: {
-            int status{ 0 };
-            auto res = linyaps_box::os::waitpid(-1, status, WNOHANG);
-            if (!res || *res == 0) {
-                break;
-            }
-
-            if (*res == pid) {
-                child_exited = true;
-                exit_code = os::throw_if_error(os::get_exit_code(status));
-            }
+            reap_children();
         } break;
         case SIGWINCH: {
             if (master && host_tty) {
@@ -142,16 +235,66 @@ auto container_monitor::handle_signals() -> void
         } break;
         default: {
             if (!child_exited) {
-                ::kill(pid, static_cast<int>(info.ssi_signo));
+                send_signal(static_cast<int>(info.ssi_signo));
             }
         } break;
         }
     }
 }
 
+auto container_monitor::enable_memory_reclaim(utils::file_descriptor_ref cgroup_dirfd,
+                                              memory_reclaim_policy policy) -> void
+{
+    reclaimer.emplace(cgroup_dirfd, std::move(policy));
+    if (!epoll.add(reclaimer->trigger_fd(), EPOLLPRI)) {
+        reclaimer.reset();
+        throw std::runtime_error("failed to add PSI trigger to epoll");
+    }
+}
+
+auto container_monitor::handle_memory_pressure(uint32_t events) -> void
+{
+    // the cgroup is gone, the trigger never fires again
+    if ((events & EPOLLERR) != 0) {
+        epoll.remove(reclaimer->trigger_fd());
+        reclaimer.reset();
+        return;
+    }
+
+    if ((events & EPOLLPRI) != 0) {
+        reclaimer->reclaim();
+    }
+}
+
+auto container_monitor::send_signal(int sig) const noexcept -> int
+{
+    // once reaped, the pid may belong to another process
+    if (child_exited) {
+        errno = ESRCH;
+        return -1;
+    }
+
+    if (pidfd.valid()) {
+        auto ret = os::pidfd_send_signal(pidfd, sig);
+        if (LIKELY(ret.has_value())) {
+            return 0;
+        }
+
+        errno = ret.error().value();
+        return -1;
+    }
+
+    return ::kill(pid, sig);
+}
+
 auto container_monitor::kill_child() noexcept -> int
 {
-    auto ret = ::kill(pid, SIGKILL);
+    // already reaped, nothing left to kill or wait for
+    if (child_exited) {
+        return 0;
+    }
+
+    auto ret = send_signal(SIGKILL);
     if (ret < 0) {
         if (LIKELY(errno == ESRCH)) {
             return 0;
@@ -226,8 +369,115 @@ auto container_monitor::enable_io_forwarding(terminal_master pty,
     drive_and_cleanup(out_fwd);
 }
 
+auto container_monitor::enable_control(infra::unix_socket listener, container_status status)
+  -> void
+{
+    listener.fd().set_nonblock(true);
+    if (!epoll.add(listener.fd(), EPOLLIN)) {
+        throw std::runtime_error("failed to add control socket to epoll");
+    }
+
+    control = std::move(listener);
+    this->status = std::move(status);
+}
+
+auto container_monitor::accept_control_clients() -> void
+{
+    try {
+        while (auto conn = control->accept()) {
+            // only the user running the monitor, or root, may control the container
+            if (!conn->peer_is_trusted()) {
+                LINYAPS_BOX_LOG_WARN("reject control connection of another user");
+                continue;
+            }
+
+            conn->fd().set_nonblock(true);
+            if (!epoll.add(conn->fd(), EPOLLIN)) {
+                continue;
+            }
+
+            auto fd = conn->fd().get();
+            control_clients.emplace(fd, std::move(*conn));
+        }
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_WARN("failed to accept control connection: {}", e.what());
+    }
+}
+
+auto container_monitor::handle_control_client(int fd) -> void
+{
+    auto it = control_clients.find(fd);
+    auto &conn = it->second;
+
+    std::string buffer(max_control_request_size, '\0');
+    auto bytes = conn.recv(utils::as_writable_bytes(utils::span(buffer)));
+    if (!bytes && bytes.error() == std::errc::resource_unavailable_try_again) {
+        return;
+    }
+
+    // one request per connection, closing it also drops it from epoll
+    auto done = utils::make_defer([this, it]() noexcept { control_clients.erase(it); });
+
+    if (!bytes || *bytes == 0) {
+        return;
+    }
+
+    nlohmann::json reply;
+    try {
+        buffer.resize(*bytes);
+        reply = handle_control_request(nlohmann::json::parse(buffer));
+    } catch (const std::system_error &e) {
+        reply = { { "error", e.what() }, { "errno", e.code().value() } };
+    } catch (const std::exception &e) {
+        reply = { { "error", e.what() } };
+    }
+
+    if (auto ret = send_json(conn, reply); !ret) {
+        LINYAPS_BOX_LOG_DEBUG("failed to answer control request: {}", ret.error().message());
+    }
+}
+
+auto container_monitor::handle_control_request(const nlohmann::json &request) -> nlohmann::json
+{
+    const auto op = request.at("op").get<std::string>();
+    if (op == "state") {
+        return { { "status", *status } };
+    }
+
+    if (op == "kill") {
+        const auto sig = request.at("signal").get<int>();
+        if (send_signal(sig) == 0) {
+            return nlohmann::json::object();
+        }
+
+        throw std::system_error(errno,
+                                std::system_category(),
+                                fmt::format("failed to kill process {} with signal {}", pid, sig));
+    }
+
+    if (op == "stats") {
+        if (status->cgroup_path.empty()) {
+            throw std::runtime_error("container " + status->id + " has no cgroup");
+        }
+
+        if (!sampler) {
+            sampler.emplace(status->cgroup_path);
+        }
+
+        return { { "stats", sampler->sample() } };
+    }
+
+    throw std::invalid_argument("unknown control request: " + op);
+}
+
 auto container_monitor::wait_container_exit() -> int
 {
+    // Callers are sent back to the status directory once the container is gone.
+    auto close_control = utils::make_defer([this]() noexcept {
+        control_clients.clear();
+        control.reset();
+    });
+
     // After IO forwarding is set up, there may already be data in flight.
     // Spin once with timeout=0 to drain it without blocking.
     bool need_immediate_spin{ true };
@@ -236,33 +486,60 @@ auto container_monitor::wait_container_exit() -> int
         const auto timeout = need_immediate_spin ? 0 : -1;
         const auto events = epoll.wait(timeout);
 
-        // Handle signals before data forwarding to keep latency low.
-        const auto *triggered_signal = std::find_if(events.cbegin(),
-                                                    events.cend(),
-                                                    [signal_fd = signal_fd.get()](const auto &e) {
-                                                        return e.data.fd == signal_fd;
-                                                    });
+        // Handle signals and the container's exit before data forwarding to
+        // keep latency low.
+        const auto signal_fd_no = signal_fd.get();
+        const auto pidfd_no = pidfd.valid() ? pidfd.get() : -1;
+        const auto triggered = [&events](int fd) {
+            return std::any_of(events.cbegin(), events.cend(), [fd](const auto &e) {
+                return e.data.fd == fd;
+            });
+        };
+
+        const auto signaled = triggered(signal_fd_no);
+        const auto exited = pidfd_no >= 0 && triggered(pidfd_no);
+        if (exited) {
+            reap_children();
+        }
 
-        if (triggered_signal != events.cend()) {
+        if (signaled) {
             handle_signals();
+        }
 
-            // Once the child has exited, the PTY will shut down soon.
-            // Mark the forwarders so the event loop can drain remaining
-            // output and then terminate.
-            if (child_exited) {
-                if (in_fwd) {
-                    in_fwd->mark_dst_failed();
-                }
-                if (out_fwd) {
-                    out_fwd->mark_src_eof();
-                }
+        // Once the child has exited, the PTY will shut down soon.
+        // Mark the forwarders so the event loop can drain remaining
+        // output and then terminate.
+        if ((signaled || exited) && child_exited) {
+            if (in_fwd) {
+                in_fwd->mark_dst_failed();
+            }
+            if (out_fwd) {
+                out_fwd->mark_src_eof();
             }
         }
 
+        const auto trigger_no = reclaimer ? reclaimer->trigger_fd().get() : -1;
+        const auto control_no = control ? control->fd().get() : -1;
         for (const auto &ev : events) {
-            if (ev.data.fd == signal_fd.get()) {
+            if (ev.data.fd == signal_fd_no || ev.data.fd == pidfd_no) {
+                continue;
+            }
+
+            if (ev.data.fd == control_no) {
+                accept_control_clients();
+                continue;
+            }
+
+            if (control_clients.count(ev.data.fd) != 0) {
+                handle_control_client(ev.data.fd);
                 continue;
             }
+
+            if (ev.data.fd == trigger_no) {
+                handle_memory_pressure(ev.events);
+                continue;
+            }
+
             handle_fd_error(ev, in_fwd, out_fwd);
         }
 
@@ -4,19 +4,41 @@
 
 #pragma once
 
+#include "linyaps_box/cgroup_stats.h"
+#include "linyaps_box/container_status.h"
+#include "linyaps_box/infra/unix_socket.h"
 #include "linyaps_box/io/epoll.h"
 #include "linyaps_box/io/forwarder.h"
+#include "linyaps_box/memory_reclaim.h"
 #include "linyaps_box/terminal.h"
+#include "linyaps_box/utils/rusage.h"
 
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
 #include <optional>
+#include <unordered_map>
 
 namespace linyaps_box {
+
+// Send one request to the monitor serving socket and return its reply. nullopt if
+// no monitor is listening or it did not answer in time, the caller then falls back
+// to the status directory. A request the monitor failed throws std::system_error.
+//
+// {"op": "state"}               -> {"status": container_status}
+// {"op": "kill", "signal": N}   -> {}
+// {"op": "stats"}               -> {"stats": cgroup_sampler::sample()}
+[[nodiscard]] auto query_monitor(const std::filesystem::path &socket,
+                                 const nlohmann::json &request) -> std::optional<nlohmann::json>;
+
 // TODO: refactor this class
 class container_monitor
 {
 public:
-    explicit container_monitor(pid_t pid) noexcept
-        : pid(pid) { };
+    // pidfd may be invalid on kernels without pidfd support, signals then go by pid.
+    container_monitor(pid_t pid, utils::file_descriptor pidfd) noexcept
+        : pid(pid)
+        , pidfd(std::move(pidfd)) { };
     container_monitor(const container_monitor &) = delete;
     container_monitor &operator=(const container_monitor &) = delete;
     container_monitor(container_monitor &&) = delete;
@@ -27,21 +49,53 @@ public:
     auto enable_io_forwarding(terminal_master pty,
                               const linyaps_box::utils::file_descriptor &in,
                               const linyaps_box::utils::file_descriptor &out) -> void;
+    // Reclaim memory from the container's cgroup whenever the PSI trigger fires.
+    auto enable_memory_reclaim(utils::file_descriptor_ref cgroup_dirfd,
+                               memory_reclaim_policy policy) -> void;
+    // Answer query_monitor requests on listener while waiting for the container,
+    // from the status it was started with and without touching the status directory.
+    auto enable_control(infra::unix_socket listener, container_status status) -> void;
     [[nodiscard]] auto wait_container_exit() -> int;
 
     auto kill_child() noexcept -> int;
 
+    // Filled in as processes are reaped, complete once wait_container_exit returns.
+    [[nodiscard]] auto usage() const noexcept -> const utils::process_usage &
+    {
+        return container_usage;
+    }
+
+    [[nodiscard]] auto descendants() const noexcept -> const utils::process_usage &
+    {
+        return descendants_usage;
+    }
+
 private:
     auto handle_signals() -> void;
+    auto handle_memory_pressure(uint32_t events) -> void;
+    auto reap_children() -> void;
+    auto accept_control_clients() -> void;
+    auto handle_control_client(int fd) -> void;
+    auto handle_control_request(const nlohmann::json &request) -> nlohmann::json;
+    auto send_signal(int sig) const noexcept -> int;
     bool child_exited{ false };
     pid_t pid;
+    utils::file_descriptor pidfd;
     int exit_code{ 0 };
+    utils::process_usage container_usage;
+    utils::process_usage descendants_usage;
     utils::file_descriptor signal_fd;
+    std::optional<memory_reclaimer> reclaimer;
     std::optional<terminal_master> master;
     std::optional<utils::file_descriptor> master_out;
     io::Epoll epoll;
     std::optional<io::Forwarder> in_fwd;
     std::optional<io::Forwarder> out_fwd;
     std::optional<terminal_slave> host_tty;
+    std::optional<infra::unix_socket> control;
+    std::unordered_map<int, infra::unix_socket> control_clients;
+    std::optional<container_status> status;
+    // opened on the first stats request and kept for the next ones
+    std::optional<cgroup_sampler> sampler;
 };
 } // namespace linyaps_box
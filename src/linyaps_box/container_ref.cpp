@@ -4,7 +4,11 @@
 
 #include "linyaps_box/container_ref.h"
 
+#include "linyaps_box/cgroup_stats.h"
+#include "linyaps_box/config/cache.h"
 #include "linyaps_box/container_monitor.h"
+#include "linyaps_box/impl/cgroupfs_manager.h"
+#include "linyaps_box/io/stream.h"
 #include "linyaps_box/log/logger.h"
 #include "linyaps_box/log/macro.h"
 #include "linyaps_box/os/fs.h" // IWYU pragma: keep
@@ -12,12 +16,16 @@
 #include "linyaps_box/protocol/message_channel.h"
 #include "linyaps_box/protocol/sync_socket_forwarder.h"
 #include "linyaps_box/security/privilege.h"
+#include "linyaps_box/security/seccomp.h"
 #include "linyaps_box/terminal.h"
 #include "linyaps_box/utils/close_range.h"
 #include "linyaps_box/utils/defer.h"
+#include "linyaps_box/utils/mempolicy.h"
 #include "linyaps_box/utils/platform.h"
+#include "linyaps_box/utils/sched.h"
 #include "linyaps_box/utils/session.h"
 #include "linyaps_box/utils/setns.h"
+#include "linyaps_box/utils/timing.h"
 #include "linyaps_box/utils/utils.h"
 
 #include <algorithm>
@@ -162,16 +170,23 @@ void child_apply_rlimits(const linyaps_box::oci_config::process_t &proc)
 [[noreturn]] auto exec_child_process(pid_t target_pid,
                                      const linyaps_box::oci_config &config,
                                      const linyaps_box::oci_config::process_t &proc,
+                                     const std::optional<security::seccomp_filter> &seccomp,
                                      int preserve_fds,
                                      protocol::child_message_channel child_chan) -> void
 {
     try {
+        linyaps_box::utils::phase_recorder::instance().rebind(
+          linyaps_box::utils::phase_origin::container);
+
         auto &logger = linyaps_box::log::global_logger::instance();
         logger.set_forwarder(
           std::make_unique<linyaps_box::protocol::sync_socket_forwarder>(child_chan));
 
+        linyaps_box::utils::apply_initial_cpu_affinity(proc);
+
         bool pid_ns{ false };
         if (config.linux && config.linux->namespaces) {
+            const linyaps_box::utils::phase_scope phase{ "join_container_namespaces" };
             linyaps_box::utils::join_container_namespaces(target_pid, *config.linux);
             pid_ns = std::any_of(config.linux->namespaces->cbegin(),
                                  config.linux->namespaces->cend(),
@@ -237,8 +252,8 @@ void child_apply_rlimits(const linyaps_box::oci_config::process_t &proc)
             return proc.capabilities;
         }();
 
-        ctx.set_capabilities(std::move(effective_caps))
-          .set_no_new_privs(proc.no_new_privileges.value_or(false));
+        const auto no_new_privs = proc.no_new_privileges.value_or(false);
+        ctx.set_capabilities(std::move(effective_caps)).set_no_new_privs(no_new_privs);
 
         // change before we drop caps
         for (auto fd : { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO }) {
@@ -249,7 +264,19 @@ void child_apply_rlimits(const linyaps_box::oci_config::process_t &proc)
             }
         }
 
-        ctx.apply();
+        linyaps_box::utils::apply_scheduling(proc, config.annotations);
+        if (config.linux && config.linux->memory_policy) {
+            linyaps_box::utils::apply_memory_policy(*config.linux->memory_policy);
+        }
+
+        {
+            const linyaps_box::utils::phase_scope phase{ "drop_privileges" };
+            // without no_new_privs the filter needs CAP_SYS_ADMIN, which is about to go
+            if (seccomp && !no_new_privs) {
+                security::install_seccomp(*seccomp);
+            }
+            ctx.apply();
+        }
 
         std::vector<const char *> c_args;
         c_args.reserve(proc.args.size() + 1);
@@ -272,10 +299,16 @@ void child_apply_rlimits(const linyaps_box::oci_config::process_t &proc)
             throw std::system_error(errno, std::system_category(), "chdir");
         }
 
+        linyaps_box::utils::apply_final_cpu_affinity(proc);
+
         LINYAPS_BOX_LOG_DEBUG("exec command");
 
         child_chan.send_stage(protocol::stage::type::exec_ready);
 
+        if (seccomp && no_new_privs) {
+            security::install_seccomp(*seccomp);
+        }
+
         ::execvpe(c_args.at(0),
                   const_cast<char *const *>(c_args.data()),
                   const_cast<char *const *>(c_env.data()));
@@ -315,7 +348,13 @@ auto exec_parent_process(protocol::parent_message_channel sync,
                },
                inc.body);
 
-    linyaps_box::container_monitor monitor{ pid };
+    // The reported process is ours to reap, so its pid can not have been reused yet.
+    linyaps_box::utils::file_descriptor pidfd;
+    if (auto ret = linyaps_box::os::pidfd_open(pid); ret) {
+        pidfd = std::move(ret).value();
+    }
+
+    linyaps_box::container_monitor monitor{ pid, std::move(pidfd) };
     monitor.enable_signal_forwarding();
 
     // Unblock the grandchild so it can proceed with terminal setup and exec.
@@ -386,22 +425,42 @@ auto exec_parent_process(protocol::parent_message_channel sync,
 
 } // anonymous namespace
 
-container_ref::container_ref(status_directory status_dir, std::string id)
+container_ref::container_ref(status_directory status_dir, std::string id, bool ask_monitor)
     : id_(std::move(id))
     , status_dir_(std::move(status_dir))
+    , ask_monitor_(ask_monitor)
+{
+}
+
+auto container_ref::query_monitor(const nlohmann::json &request) const
+  -> std::optional<nlohmann::json>
 {
+    if (!ask_monitor_) {
+        return std::nullopt;
+    }
+
+    return linyaps_box::query_monitor(status_dir_.control_socket(), request);
 }
 
 container_ref::~container_ref() noexcept = default;
 
 container_status linyaps_box::container_ref::status() const
 {
+    if (auto reply = query_monitor({ { "op", "state" } })) {
+        return reply->at("status").get<container_status>();
+    }
+
     return status_dir_.read();
 }
 
 void container_ref::kill(int signal) const
 {
-    auto pid = this->status().pid;
+    // the monitor signals through its pidfd, the pid cannot have been reused
+    if (query_monitor({ { "op", "kill" }, { "signal", signal } })) {
+        return;
+    }
+
+    auto pid = status_dir_.read().pid;
 
     if (::kill(pid, signal) == 0) {
         return;
@@ -412,15 +471,195 @@ void container_ref::kill(int signal) const
                             fmt::format("failed to kill process {} with signal {}", pid, signal));
 }
 
+auto container_ref::stats() const -> nlohmann::json
+{
+    if (auto reply = query_monitor({ { "op", "stats" } })) {
+        return std::move(reply->at("stats"));
+    }
+
+    auto status = status_dir_.read();
+    if (status.cgroup_path.empty()) {
+        throw std::runtime_error("container " + id_ + " has no cgroup");
+    }
+
+    cgroup_sampler sampler{ status.cgroup_path };
+    return sampler.sample();
+}
+
+auto to_json(nlohmann::json &j, const start_container_option &option) -> void
+{
+    j = nlohmann::json::object();
+    if (!option.args.empty()) {
+        j["args"] = option.args;
+    }
+    if (option.env) {
+        j["env"] = *option.env;
+    }
+    if (option.cwd) {
+        j["cwd"] = option.cwd->string();
+    }
+}
+
+auto from_json(const nlohmann::json &j, start_container_option &option) -> void
+{
+    if (auto it = j.find("args"); it != j.end()) {
+        it->get_to(option.args);
+    }
+    if (auto it = j.find("env"); it != j.end()) {
+        option.env = it->get<std::vector<std::string>>();
+    }
+    if (auto it = j.find("cwd"); it != j.end()) {
+        option.cwd = it->get<std::string>();
+    }
+}
+
+namespace {
+
+constexpr std::uint32_t max_start_request_size{ 1U << 20U };
+
+} // namespace
+
+void write_start_request(utils::file_descriptor_ref fifo, const start_container_option &option)
+{
+    const auto payload = nlohmann::json(option).dump();
+    if (payload.size() > max_start_request_size) {
+        throw std::runtime_error("start request is too large");
+    }
+
+    const auto size = static_cast<std::uint32_t>(payload.size());
+    std::vector<std::byte> frame(sizeof(size) + payload.size());
+    std::memcpy(frame.data(), &size, sizeof(size));
+    std::memcpy(frame.data() + sizeof(size), payload.data(), payload.size());
+
+    os::throw_if_error(io::write_all(fifo, frame), "failed to write start request");
+}
+
+auto read_start_request(utils::file_descriptor_ref fifo) -> start_container_option
+{
+    std::uint32_t size{ 0 };
+    auto n = os::throw_if_error(
+      io::read_exact(fifo, utils::as_writable_bytes(utils::span{ &size, 1 })),
+      "failed to read start request");
+    if (n != sizeof(size) || size > max_start_request_size) {
+        throw std::runtime_error("malformed start request");
+    }
+
+    std::string payload(size, '\0');
+    n = os::throw_if_error(
+      io::read_exact(fifo, utils::as_writable_bytes(utils::span{ payload.data(), payload.size() })),
+      "failed to read start request");
+    if (n != size) {
+        throw std::runtime_error("malformed start request");
+    }
+
+    return nlohmann::json::parse(payload).get<start_container_option>();
+}
+
+void container_ref::update(const oci_config::linux_t::resources_t &resources) const
+{
+    const auto status = this->status();
+    if (status.cgroup_path.empty()) {
+        throw std::runtime_error(
+          fmt::format("container {} was started without a cgroup manager", status.id));
+    }
+
+    update_cgroup_v2(status.cgroup_path, resources);
+}
+
+namespace {
+
+constexpr std::chrono::seconds freeze_timeout{ 10 };
+
+} // namespace
+
+void container_ref::pause() const
+{
+    const auto status = this->status();
+    if (status.cgroup_path.empty()) {
+        throw std::runtime_error(
+          fmt::format("container {} was started without a cgroup manager", status.id));
+    }
+
+    const auto state = derive_status(status);
+    if (state != runtime_status::RUNNING && state != runtime_status::CREATED) {
+        throw std::runtime_error(fmt::format("container {} is not running", status.id));
+    }
+
+    freeze_cgroup_v2(status.cgroup_path, true, freeze_timeout);
+}
+
+void container_ref::resume() const
+{
+    const auto status = this->status();
+    if (status.cgroup_path.empty() || derive_status(status) != runtime_status::PAUSED) {
+        throw std::runtime_error(fmt::format("container {} is not paused", status.id));
+    }
+
+    freeze_cgroup_v2(status.cgroup_path, false, freeze_timeout);
+}
+
+void container_ref::start(const start_container_option &option) const
+{
+    const auto status = this->status();
+    const auto state = derive_status(status);
+    if (status.exec_fifo.empty()
+        || (state != runtime_status::CREATED && state != runtime_status::PAUSED)) {
+        throw std::runtime_error(fmt::format("container {} is not created", status.id));
+    }
+
+    // non-blocking, so that a process no longer reading the FIFO fails with ENXIO
+    auto fifo = os::open(status.exec_fifo,
+                         { os::sys::open_flag::cloexec | os::sys::open_flag::non_block,
+                           os::sys::access_mode::write_only });
+    if (!fifo) {
+        if (fifo.error() == std::errc::no_such_device_or_address
+            || fifo.error() == std::errc::no_such_file_or_directory) {
+            throw std::runtime_error(
+              fmt::format("container {} is not waiting to be started", status.id));
+        }
+        throw std::system_error(fifo.error(), fmt::format("failed to open {}", status.exec_fifo));
+    }
+
+    // Whoever unlinks the FIFO owns the container: a concurrent start, or the
+    // monitor giving up on an idle pool member, makes this fail.
+    if (::unlink(status.exec_fifo.c_str()) != 0) {
+        if (errno == ENOENT) {
+            throw std::runtime_error(
+              fmt::format("container {} is not waiting to be started", status.id));
+        }
+        throw std::system_error(errno,
+                                std::system_category(),
+                                fmt::format("failed to unlink {}", status.exec_fifo));
+    }
+
+    if (state == runtime_status::PAUSED) {
+        freeze_cgroup_v2(status.cgroup_path, false, freeze_timeout);
+    }
+
+    fifo->set_nonblock(false);
+    write_start_request(fifo->ref(), option);
+}
+
 auto container_ref::exec(exec_container_option option) const -> int
 {
     auto target_pid = this->status().pid;
 
     os::throw_if_error(os::set_child_subreaper(true));
 
-    auto config = oci_config::parse(status_dir_.config());
+    auto config = [this]() {
+        const utils::phase_scope phase{ "parse_config" };
+        return config::parse_cached(status_dir_.config(), status_dir_.config_cache());
+    }();
     auto &proc = resolve_final_process(option, config);
 
+    std::optional<security::seccomp_filter> seccomp;
+    if (config.linux && config.linux->seccomp) {
+        const utils::phase_scope phase{ "compile_seccomp" };
+        seccomp = security::load_or_compile_seccomp(*config.linux->seccomp,
+                                                    security::default_syscall_resolver(),
+                                                    status_dir_.config_cache().parent_path());
+    }
+
     auto [parent_chan, child_chan] = protocol::create_message_socketpair();
 
     auto child = ::fork();
@@ -432,7 +671,12 @@ auto container_ref::exec(exec_container_option option) const -> int
         parent_chan.close();
         option.console_socket.reset();
 
-        exec_child_process(target_pid, config, proc, option.preserve_fds, std::move(child_chan));
+        exec_child_process(target_pid,
+                           config,
+                           proc,
+                           seccomp,
+                           option.preserve_fds,
+                           std::move(child_chan));
     }
 
     child_chan.close();
@@ -9,6 +9,8 @@
 #include "linyaps_box/infra/unix_socket.h"
 #include "linyaps_box/status_directory.h"
 
+#include <nlohmann/json.hpp>
+
 #include <string>
 
 #include <sys/types.h>
@@ -35,10 +37,30 @@ struct exec_container_option
     std::optional<infra::unix_socket> console_socket;
 };
 
+// Sent through the exec FIFO to a created container when it is started.
+struct start_container_option
+{
+    // Replace the configured process fields that are set, the way a container
+    // claimed from a warm pool gets the command line it was launched with.
+    std::vector<std::string> args;
+    std::optional<std::vector<std::string>> env;
+    std::optional<std::filesystem::path> cwd;
+};
+
+auto to_json(nlohmann::json &j, const start_container_option &option) -> void;
+auto from_json(const nlohmann::json &j, start_container_option &option) -> void;
+
+// The exec FIFO carries a native-endian uint32 length followed by that many
+// bytes of start_container_option as JSON.
+void write_start_request(utils::file_descriptor_ref fifo, const start_container_option &option);
+[[nodiscard]] auto read_start_request(utils::file_descriptor_ref fifo) -> start_container_option;
+
 class container_ref
 {
 public:
-    container_ref(status_directory status_dir, std::string id);
+    // With ask_monitor, status, kill and stats go to the monitor's control socket
+    // first. That pays off when acting on one container, not when listing many.
+    container_ref(status_directory status_dir, std::string id, bool ask_monitor = false);
     virtual ~container_ref() noexcept;
 
     container_ref(const container_ref &) = delete;
@@ -47,7 +69,18 @@ public:
     auto operator=(container_ref &&) -> container_ref & = default;
 
     [[nodiscard]] auto status() const -> container_status;
+    // Let a created container execute its process, thawing it first if it
+    // waits frozen in a warm pool.
+    void start(const start_container_option &option = { }) const;
     void kill(int signal) const;
+    // Apply the settings present in resources to the cgroup of a running container.
+    void update(const oci_config::linux_t::resources_t &resources) const;
+    // Freeze every process of a running or created container through its cgroup,
+    // and thaw them.
+    void pause() const;
+    void resume() const;
+    // A cgroup_sampler sample of the container's cgroup.
+    [[nodiscard]] auto stats() const -> nlohmann::json;
     [[nodiscard]] auto exec(exec_container_option option) const -> int;
 
 protected:
@@ -55,8 +88,13 @@ protected:
     [[nodiscard]] auto get_id() const -> const std::string &;
 
 private:
+    // nullopt when not asking the monitor or there is none to answer
+    [[nodiscard]] auto query_monitor(const nlohmann::json &request) const
+      -> std::optional<nlohmann::json>;
+
     std::string id_;
     status_directory status_dir_;
+    bool ask_monitor_;
 };
 
 } // namespace linyaps_box
@@ -4,6 +4,7 @@
 
 #include "linyaps_box/container_status.h"
 
+#include "linyaps_box/utils/cgroups.h"
 #include "linyaps_box/utils/process_stat.h"
 #include "linyaps_box/utils/time.h"
 #include "linyaps_box/utils/utils.h"
@@ -28,6 +29,15 @@ auto to_json(nlohmann::json &j, const container_status &s) -> void
                                  { "owner", s.owner },
                                  { "annotations", s.annotations },
                                  { "ociVersion", s.oci_version } });
+    if (!s.cgroup_path.empty()) {
+        j["cgroup-path"] = s.cgroup_path.string();
+    }
+    if (!s.exec_fifo.empty()) {
+        j["exec-fifo"] = s.exec_fifo.string();
+    }
+    if (!s.pool.empty()) {
+        j["pool"] = s.pool;
+    }
 }
 
 auto from_json(const nlohmann::json &j, container_status &s) -> void
@@ -40,6 +50,15 @@ auto from_json(const nlohmann::json &j, container_status &s) -> void
     j.at("owner").get_to(s.owner);
     j.at("annotations").get_to(s.annotations);
     j.at("ociVersion").get_to(s.oci_version);
+    if (auto it = j.find("cgroup-path"); it != j.end()) {
+        s.cgroup_path = it->get<std::string>();
+    }
+    if (auto it = j.find("exec-fifo"); it != j.end()) {
+        s.exec_fifo = it->get<std::string>();
+    }
+    if (auto it = j.find("pool"); it != j.end()) {
+        it->get_to(s.pool);
+    }
 }
 
 auto to_string_view(runtime_status s) -> std::string_view
@@ -52,6 +71,8 @@ auto to_string_view(runtime_status s) -> std::string_view
         return "created"sv;
     case runtime_status::RUNNING:
         return "running"sv;
+    case runtime_status::PAUSED:
+        return "paused"sv;
     case runtime_status::STOPPED:
         return "stopped"sv;
     }
@@ -92,10 +113,16 @@ auto derive_status(const container_status &s) -> runtime_status
         return runtime_status::STOPPED;
     }
 
-    // Without a start-synchronisation primitive we cannot distinguish created
-    // from running.
-    // A running process is reported as RUNNING; created will be
-    // distinguished when the primitive is added alongside separate create/start.
+    if (!s.cgroup_path.empty() && utils::is_cgroup_frozen(s.cgroup_path)) {
+        return runtime_status::PAUSED;
+    }
+
+    // The FIFO is unlinked by start, a created container is still blocked on it.
+    std::error_code ec;
+    if (!s.exec_fifo.empty() && std::filesystem::exists(s.exec_fifo, ec)) {
+        return runtime_status::CREATED;
+    }
+
     return runtime_status::RUNNING;
 }
 
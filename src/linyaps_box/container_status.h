@@ -26,13 +26,17 @@ struct container_status
     std::string owner; // extension field
     std::uint64_t process_start_time;
     std::chrono::system_clock::time_point created; // extension field
+    std::filesystem::path cgroup_path;             // extension field, empty without a cgroup
+    // extension field, the FIFO a created container blocks on until it is started
+    std::filesystem::path exec_fifo;
+    std::string pool; // extension field, the warm pool a created container belongs to
     pid_t pid;
 };
 
 auto from_json(const nlohmann::json &j, container_status &s) -> void;
 auto to_json(nlohmann::json &j, const container_status &s) -> void;
 
-enum class runtime_status : std::uint8_t { CREATING, CREATED, RUNNING, STOPPED };
+enum class runtime_status : std::uint8_t { CREATING, CREATED, RUNNING, PAUSED, STOPPED };
 
 auto to_string_view(runtime_status s) -> std::string_view;
 auto derive_status(const container_status &s) -> runtime_status;
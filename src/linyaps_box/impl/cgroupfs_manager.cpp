@@ -0,0 +1,574 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/impl/cgroupfs_manager.h"
+
+#include "linyaps_box/io/epoll.h"
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/os/fs.h"
+#include "linyaps_box/utils/cgroups.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <thread>
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace linyaps_box {
+
+namespace {
+
+using resources_t = oci_config::linux_t::resources_t;
+
+auto limit_value(int64_t value) -> std::string
+{
+    return value < 0 ? "max" : std::to_string(value);
+}
+
+auto join(const std::vector<unsigned int> &ids) -> std::string
+{
+    std::string ret;
+    for (auto id : ids) {
+        if (!ret.empty()) {
+            ret += ',';
+        }
+        ret += std::to_string(id);
+    }
+
+    return ret;
+}
+
+// cgroup v1 shares [2, 262144] to cgroup v2 cpu.weight [1, 10000]
+auto shares_to_weight(uint64_t shares) -> uint64_t
+{
+    shares = std::clamp<uint64_t>(shares, 2, 262144);
+    return 1 + ((shares - 2) * 9999) / 262142;
+}
+
+// cgroup v1 blkio.weight [10, 1000] to cgroup v2 io.weight [1, 10000]
+auto blkio_to_io_weight(uint16_t weight) -> uint64_t
+{
+    const auto w = std::clamp<uint64_t>(weight, 10, 1000);
+    return 1 + ((w - 10) * 9999) / 990;
+}
+
+void add_memory(const resources_t::memory_t &memory,
+                std::vector<std::pair<std::string, std::string>> &files)
+{
+    if (memory.reservation) {
+        files.emplace_back("memory.low", limit_value(*memory.reservation));
+    }
+
+    if (memory.limit) {
+        files.emplace_back("memory.max", limit_value(*memory.limit));
+    }
+
+    // OCI swap is memory plus swap, memory.swap.max is swap only
+    if (memory.swap) {
+        if (*memory.swap < 0) {
+            files.emplace_back("memory.swap.max", "max");
+        } else if (!memory.limit || *memory.limit < 0) {
+            throw std::invalid_argument("memory.swap requires memory.limit on cgroup v2");
+        } else if (*memory.swap < *memory.limit) {
+            throw std::invalid_argument("memory.swap must not be less than memory.limit");
+        } else {
+            files.emplace_back("memory.swap.max", std::to_string(*memory.swap - *memory.limit));
+        }
+    }
+}
+
+void add_cpu(const resources_t::cpu_t &cpu, std::vector<std::pair<std::string, std::string>> &files)
+{
+    if (cpu.realtime_runtime.value_or(0) != 0 || cpu.realtime_period.value_or(0) != 0) {
+        throw std::invalid_argument("cgroup v2 does not support realtime cpu scheduling");
+    }
+
+    if (cpu.cpus) {
+        files.emplace_back("cpuset.cpus", join(*cpu.cpus));
+    }
+
+    if (cpu.mems) {
+        files.emplace_back("cpuset.mems", join(*cpu.mems));
+    }
+
+    if (cpu.shares && *cpu.shares != 0) {
+        files.emplace_back("cpu.weight", std::to_string(shares_to_weight(*cpu.shares)));
+    }
+
+    // without a period the kernel keeps the current one, which an update must
+    // not reset to the default
+    if (cpu.quota || cpu.period) {
+        const auto quota = cpu.quota && *cpu.quota > 0 ? std::to_string(*cpu.quota) : "max";
+        files.emplace_back("cpu.max",
+                           cpu.period ? fmt::format("{} {}", quota, *cpu.period) : quota);
+    }
+
+    if (cpu.burst) {
+        files.emplace_back("cpu.max.burst", std::to_string(*cpu.burst));
+    }
+
+    if (cpu.idle) {
+        files.emplace_back("cpu.idle", *cpu.idle == resources_t::cpu_t::idle_t::IDLE ? "1" : "0");
+    }
+}
+
+void add_block_io(const resources_t::block_io_t &block_io,
+                  std::vector<std::pair<std::string, std::string>> &files)
+{
+    if (block_io.weight) {
+        files.emplace_back("io.weight",
+                           fmt::format("default {}", blkio_to_io_weight(*block_io.weight)));
+    }
+
+    if (block_io.weight_devices) {
+        for (const auto &dev : *block_io.weight_devices) {
+            if (!dev.weight) {
+                continue;
+            }
+
+            files.emplace_back(
+              "io.weight",
+              fmt::format("{}:{} {}", dev.major, dev.minor, blkio_to_io_weight(*dev.weight)));
+        }
+    }
+
+    const std::pair<const std::optional<std::vector<resources_t::block_io_t::throttle_device_t>> &,
+                    std::string_view>
+      throttles[] = {
+          { block_io.throttle_read_bps_device, "rbps" },
+          { block_io.throttle_write_bps_device, "wbps" },
+          { block_io.throttle_read_iops_device, "riops" },
+          { block_io.throttle_write_iops_device, "wiops" },
+      };
+
+    for (const auto &[devices, key] : throttles) {
+        if (!devices) {
+            continue;
+        }
+
+        for (const auto &dev : *devices) {
+            files.emplace_back("io.max",
+                               fmt::format("{}:{} {}={}", dev.major, dev.minor, key, dev.rate));
+        }
+    }
+}
+
+// "memory.max" needs the memory controller, "cgroup.*" files need none
+auto controller_of(std::string_view file) -> std::string_view
+{
+    auto controller = file.substr(0, file.find('.'));
+    return controller == "cgroup" ? std::string_view{ } : controller;
+}
+
+auto read_controllers(const std::filesystem::path &file) -> std::set<std::string>
+{
+    std::ifstream stream{ file };
+    if (!stream) {
+        throw std::runtime_error("failed to read " + file.string());
+    }
+
+    return { std::istream_iterator<std::string>{ stream }, std::istream_iterator<std::string>{ } };
+}
+
+// cgroup interface files take one value per write(2)
+void write_file(utils::file_descriptor_ref dirfd,
+                const std::filesystem::path &file,
+                std::string_view value)
+{
+    auto fd = os::throw_if_error(
+      os::openat(dirfd, file, { os::sys::open_flag::cloexec, os::sys::access_mode::write_only }),
+      "open " + file.string());
+    if (::write(fd.get(), value.data(), value.size()) != static_cast<ssize_t>(value.size())) {
+        throw std::system_error(errno,
+                                std::system_category(),
+                                fmt::format("write {} to {}", value, file.string()));
+    }
+}
+
+auto open_cgroup(const std::filesystem::path &path) -> utils::file_descriptor
+{
+    // O_PATH is not enough for CLONE_INTO_CGROUP
+    return os::throw_if_error(
+      os::open(path,
+               { os::sys::open_flag::cloexec | os::sys::open_flag::directory,
+                 os::sys::access_mode::read_only }),
+      "open " + path.string());
+}
+
+void write_files(utils::file_descriptor_ref dirfd,
+                 const std::vector<std::pair<std::string, std::string>> &files)
+{
+    for (const auto &[file, value] : files) {
+        LINYAPS_BOX_LOG_DEBUG("Write {} to {}", value, file);
+        write_file(dirfd, file, value);
+    }
+}
+
+// Creates every missing directory of path below root, and enables the controllers
+// in the cgroup.subtree_control of each parent on the way.
+void create_with_controllers(const std::filesystem::path &root,
+                             const std::filesystem::path &path,
+                             const std::set<std::string> &controllers)
+{
+    auto current = root;
+    for (const auto &component : path) {
+        if (!controllers.empty()) {
+            const auto available = read_controllers(current / "cgroup.controllers");
+            const auto enabled = read_controllers(current / "cgroup.subtree_control");
+            for (const auto &controller : controllers) {
+                if (enabled.count(controller) != 0) {
+                    continue;
+                }
+
+                if (available.count(controller) == 0) {
+                    throw std::runtime_error(fmt::format(
+                      "cgroup controller {} is not available in {}", controller, current.string()));
+                }
+
+                write_file(utils::file_descriptor_ref::cwd(),
+                           current / "cgroup.subtree_control",
+                           "+" + controller);
+            }
+        }
+
+        current /= component;
+        if (::mkdir(current.c_str(), 0755) < 0 && errno != EEXIST) {
+            throw std::system_error(errno, std::system_category(), "mkdir " + current.string());
+        }
+    }
+}
+
+// cgroupsPath is relative to the hierarchy root when absolute. A relative path is
+// placed next to the runtime's own cgroup, like runc does: the own cgroup most
+// likely has processes in it, so controllers could not be enabled below it.
+auto resolve_cgroup_path(const cgroup_options &options) -> std::filesystem::path
+{
+    std::filesystem::path path = options.cgroup_path.empty()
+      ? std::filesystem::path{ options.id }
+      : options.cgroup_path;
+    if (path.is_absolute()) {
+        path = path.relative_path();
+    } else {
+        path = utils::get_own_unified_cgroup().parent_path() / path;
+    }
+
+    path = path.lexically_normal();
+    if (path.empty() || path == "." || *path.begin() == "..") {
+        throw std::invalid_argument("invalid cgroups path " + options.cgroup_path.string());
+    }
+
+    return path;
+}
+
+// Runs change and waits until cgroup.events reports key with value. The kernel
+// modifies cgroup.events on every state change; it is watched before change runs
+// so the transition can not slip by unnoticed.
+template <typename Fn>
+void change_and_wait(const std::filesystem::path &cgroup,
+                     std::string_view key,
+                     std::string_view value,
+                     std::chrono::milliseconds timeout,
+                     Fn &&change)
+{
+    auto ret = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (ret < 0) {
+        throw std::system_error(errno, std::system_category(), "inotify_init1");
+    }
+
+    utils::file_descriptor notify_fd{ ret };
+    const auto events = cgroup / "cgroup.events";
+    if (::inotify_add_watch(notify_fd.get(), events.c_str(), IN_MODIFY) < 0) {
+        throw std::system_error(errno, std::system_category(), "watch " + events.string());
+    }
+
+    io::Epoll epoll;
+    if (!epoll.add(notify_fd, EPOLLIN)) {
+        throw std::runtime_error("failed to add inotify fd to epoll");
+    }
+
+    change();
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (utils::read_cgroup_event(cgroup, key) != value) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            throw std::runtime_error(
+              fmt::format("timed out waiting for {} {} in {}", key, value, events.string()));
+        }
+
+        if (epoll.wait(static_cast<int>(remaining.count())).empty()) {
+            continue;
+        }
+
+        // only the wakeup matters, cgroup.events is re-read above
+        std::array<char, 4096> buf{ };
+        while (::read(notify_fd.get(), buf.data(), buf.size()) > 0) { }
+    }
+}
+
+// The child cgroups below cgroup at any depth, every child ahead of its parent so
+// they can be removed in order. A cgroup removed meanwhile is skipped.
+auto descendants(const std::filesystem::path &cgroup) -> std::vector<std::filesystem::path>
+{
+    std::vector<std::filesystem::path> ret;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it{ cgroup, ec }, end; !ec && it != end;
+         it.increment(ec)) {
+        if (it->is_directory(ec) && !it->is_symlink(ec)) {
+            ret.push_back(it->path());
+        }
+    }
+
+    // pre-order lists a parent before its children
+    std::reverse(ret.begin(), ret.end());
+    return ret;
+}
+
+// A single write to cgroup.kill on Linux 5.14 and later, which covers the whole
+// subtree. Before that, the cgroup is frozen, which freezes its descendants too,
+// and every process listed in cgroup.procs of the cgroup and its descendants
+// killed once: frozen tasks neither fork nor exit on their own, so each pid read
+// still names a member of the subtree when it is signaled. The caller waits for
+// populated 0.
+void kill_all(const std::filesystem::path &cgroup)
+{
+    auto fd = os::openat(utils::file_descriptor_ref::cwd(),
+                         cgroup / "cgroup.kill",
+                         { os::sys::open_flag::cloexec, os::sys::access_mode::write_only });
+    if (fd) {
+        if (::write(fd->get(), "1", 1) != 1) {
+            throw std::system_error(errno, std::system_category(), "write cgroup.kill");
+        }
+
+        return;
+    }
+
+    if (fd.error() != std::errc::no_such_file_or_directory) {
+        throw std::system_error(fd.error(), "open cgroup.kill");
+    }
+
+    constexpr std::chrono::seconds freeze_timeout{ 1 };
+    try {
+        freeze_cgroup_v2(cgroup, true, freeze_timeout);
+    } catch (const std::exception &e) {
+        // e.g. a task stuck in uninterruptible sleep, kill what can be killed
+        LINYAPS_BOX_LOG_DEBUG("failed to freeze {} before killing it: {}", cgroup, e.what());
+    }
+
+    auto cgroups = descendants(cgroup);
+    cgroups.push_back(cgroup);
+    for (const auto &dir : cgroups) {
+        std::ifstream procs{ dir / "cgroup.procs" };
+        pid_t pid{ };
+        while (procs >> pid) {
+            ::kill(pid, SIGKILL);
+        }
+    }
+}
+
+// The last exiting tasks may keep rmdir(2) busy shortly after populated 0.
+void remove_cgroup_dir(const std::filesystem::path &cgroup)
+{
+    constexpr auto retries = 50;
+    for (auto i = 0; i < retries; ++i) {
+        if (::rmdir(cgroup.c_str()) == 0 || errno == ENOENT) {
+            return;
+        }
+
+        if (errno != EBUSY) {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+    }
+
+    throw std::system_error(errno, std::system_category(), "rmdir " + cgroup.string());
+}
+
+} // namespace
+
+auto to_cgroup_v2_files(const resources_t &resources)
+  -> std::vector<std::pair<std::string, std::string>>
+{
+    std::vector<std::pair<std::string, std::string>> files;
+
+    if (resources.cpu) {
+        add_cpu(*resources.cpu, files);
+    }
+
+    if (resources.memory) {
+        add_memory(*resources.memory, files);
+    }
+
+    if (resources.pids && resources.pids->limit) {
+        files.emplace_back("pids.max",
+                           *resources.pids->limit > 0 ? std::to_string(*resources.pids->limit)
+                                                      : "max");
+    }
+
+    if (resources.block_io) {
+        add_block_io(*resources.block_io, files);
+    }
+
+    if (resources.hugepage_limits) {
+        for (const auto &limit : *resources.hugepage_limits) {
+            files.emplace_back(fmt::format("hugetlb.{}.max", limit.page_size),
+                               std::to_string(limit.limit));
+        }
+    }
+
+    // written last, so they take precedence over the converted values
+    if (resources.unified) {
+        for (const auto &[key, value] : *resources.unified) {
+            if (key.empty() || key.front() == '.' || key.find('/') != std::string::npos) {
+                throw std::invalid_argument("invalid unified cgroup key " + key);
+            }
+
+            files.emplace_back(key, value);
+        }
+    }
+
+    return files;
+}
+
+void update_cgroup_v2(const std::filesystem::path &cgroup, const resources_t &resources)
+{
+    auto files = to_cgroup_v2_files(resources);
+    if (files.empty()) {
+        return;
+    }
+
+    // cpu.max sets quota and period at once, an update of only the period must
+    // not reset the quota to max
+    if (resources.cpu && resources.cpu->period && !resources.cpu->quota) {
+        std::ifstream current{ cgroup / "cpu.max" };
+        std::string quota;
+        if (!(current >> quota)) {
+            throw std::runtime_error("failed to read " + (cgroup / "cpu.max").string());
+        }
+
+        auto cpu_max = std::find_if(files.begin(), files.end(), [](const auto &file) {
+            return file.first == "cpu.max";
+        });
+        cpu_max->second = fmt::format("{} {}", quota, *resources.cpu->period);
+    }
+
+    LINYAPS_BOX_LOG_DEBUG("Update cgroup {}", cgroup.string());
+    write_files(open_cgroup(cgroup), files);
+}
+
+auto cgroupfs_manager::type() const -> cgroup_manager_t
+{
+    return cgroup_manager_t::cgroupfs;
+}
+
+auto cgroupfs_manager::precreate_cgroup(const cgroup_options &options,
+                                        utils::file_descriptor &dirfd) -> cgroup_status
+{
+    const auto root = utils::get_unified_cgroup_root();
+    const auto path = root / resolve_cgroup_path(options);
+
+    std::vector<std::pair<std::string, std::string>> files;
+    if (options.resources) {
+        files = to_cgroup_v2_files(*options.resources);
+    }
+
+    std::set<std::string> controllers;
+    for (const auto &file : files) {
+        if (auto controller = controller_of(file.first); !controller.empty()) {
+            controllers.emplace(controller);
+        }
+    }
+
+    LINYAPS_BOX_LOG_DEBUG("Create cgroup {}", path.string());
+    create_with_controllers(root, path.lexically_relative(root), controllers);
+
+    cgroup_status status;
+    set_manager(status, type());
+    set_path(status, path);
+
+    try {
+        dirfd = open_cgroup(path);
+        write_files(dirfd, files);
+    } catch (...) {
+        dirfd = { };
+        ::rmdir(path.c_str());
+        throw;
+    }
+
+    return status;
+}
+
+auto cgroupfs_manager::create_cgroup(const cgroup_options &options) -> cgroup_status
+{
+    utils::file_descriptor dirfd;
+    auto status = precreate_cgroup(options, dirfd);
+    if (options.pid > 0) {
+        write_file(utils::file_descriptor_ref::cwd(),
+                   status.path() / "cgroup.procs",
+                   std::to_string(options.pid));
+    }
+
+    return status;
+}
+
+void cgroupfs_manager::destroy_cgroup(const cgroup_status &status)
+{
+    destroy_cgroup_v2(status.path());
+}
+
+void cgroupfs_manager::update_resource(const cgroup_status &status, const resources_t &resources)
+{
+    update_cgroup_v2(status.path(), resources);
+}
+
+void freeze_cgroup_v2(const std::filesystem::path &cgroup,
+                      bool frozen,
+                      std::chrono::milliseconds timeout)
+{
+    change_and_wait(cgroup, "frozen", frozen ? "1" : "0", timeout, [&cgroup, frozen]() {
+        write_file(utils::file_descriptor_ref::cwd(),
+                   cgroup / "cgroup.freeze",
+                   frozen ? "1" : "0");
+    });
+}
+
+void kill_cgroup_v2(const std::filesystem::path &cgroup, std::chrono::milliseconds timeout)
+{
+    change_and_wait(cgroup, "populated", "0", timeout, [&cgroup]() {
+        kill_all(cgroup);
+    });
+}
+
+void destroy_cgroup_v2(const std::filesystem::path &cgroup)
+{
+    if (cgroup.empty() || !std::filesystem::exists(cgroup)) {
+        return;
+    }
+
+    // Processes that escaped the container process, e.g. daemons, would keep the
+    // cgroup busy; killing the cgroup leaves nothing behind.
+    constexpr std::chrono::seconds kill_timeout{ 10 };
+    kill_cgroup_v2(cgroup, kill_timeout);
+
+    // a cgroup with children can not be removed, e.g. those the container
+    // created for itself with a delegated hierarchy
+    for (const auto &child : descendants(cgroup)) {
+        remove_cgroup_dir(child);
+    }
+
+    remove_cgroup_dir(cgroup);
+}
+
+} // namespace linyaps_box
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include <linyaps_box/cgroup_manager.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace linyaps_box {
+
+// Manages cgroups directly through the cgroup v2 filesystem.
+class cgroupfs_manager : public virtual cgroup_manager
+{
+public:
+    [[nodiscard]] auto type() const -> cgroup_manager_t override;
+
+    auto create_cgroup(const cgroup_options &options) -> cgroup_status override;
+
+    auto precreate_cgroup(const cgroup_options &options, utils::file_descriptor &dirfd)
+      -> cgroup_status override;
+
+    void destroy_cgroup(const cgroup_status &status) override;
+
+    void update_resource(const cgroup_status &status,
+                         const oci_config::linux_t::resources_t &resources) override;
+};
+
+// The cgroup v2 interface files and values that implement linux.resources, in the
+// order they have to be written. A file may appear more than once, e.g. io.max
+// takes one line per device. Throws std::invalid_argument for settings cgroup v2
+// can not express.
+[[nodiscard]] auto to_cgroup_v2_files(const oci_config::linux_t::resources_t &resources)
+  -> std::vector<std::pair<std::string, std::string>>;
+
+// Write the settings present in resources to an existing cgroup v2 directory.
+void update_cgroup_v2(const std::filesystem::path &cgroup,
+                      const oci_config::linux_t::resources_t &resources);
+
+// Write cgroup.freeze and wait until cgroup.events reports the new state, the
+// kernel may need a while to stop every task. Throws when timeout expires first.
+void freeze_cgroup_v2(const std::filesystem::path &cgroup,
+                      bool frozen,
+                      std::chrono::milliseconds timeout);
+
+// Kill every process in a cgroup v2 directory and its descendants and wait until
+// cgroup.events reports it unpopulated. Throws when timeout expires first.
+void kill_cgroup_v2(const std::filesystem::path &cgroup, std::chrono::milliseconds timeout);
+
+// Kill whatever is left in a cgroup v2 directory and remove it together with its
+// child cgroups, a missing directory is fine.
+void destroy_cgroup_v2(const std::filesystem::path &cgroup);
+
+} // namespace linyaps_box
@@ -4,6 +4,8 @@
 
 #include "linyaps_box/impl/disabled_cgroup_manager.h"
 
+#include <stdexcept>
+
 namespace linyaps_box {
 [[nodiscard]] auto disabled_cgroup_manager::type() const -> cgroup_manager_t
 {
@@ -18,10 +20,19 @@ auto disabled_cgroup_manager::create_cgroup([[maybe_unused]] const cgroup_option
     return status;
 }
 
-void disabled_cgroup_manager::precreate_cgroup([[maybe_unused]] const cgroup_options &options,
+auto disabled_cgroup_manager::precreate_cgroup(const cgroup_options &options,
                                                [[maybe_unused]] utils::file_descriptor &dirfd)
+  -> cgroup_status
 {
+    return create_cgroup(options);
 }
 
 void disabled_cgroup_manager::destroy_cgroup([[maybe_unused]] const cgroup_status &status) { }
+
+void disabled_cgroup_manager::update_resource(
+  [[maybe_unused]] const cgroup_status &status,
+  [[maybe_unused]] const oci_config::linux_t::resources_t &resources)
+{
+    throw std::runtime_error("cgroup manager is disabled, resources can not be updated");
+}
 } // namespace linyaps_box
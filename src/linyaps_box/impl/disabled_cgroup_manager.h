@@ -15,10 +15,14 @@ public:
 
     auto create_cgroup([[maybe_unused]] const cgroup_options &options) -> cgroup_status override;
 
-    void precreate_cgroup([[maybe_unused]] const cgroup_options &options,
-                          [[maybe_unused]] utils::file_descriptor &dirfd) override;
+    auto precreate_cgroup([[maybe_unused]] const cgroup_options &options,
+                          [[maybe_unused]] utils::file_descriptor &dirfd)
+      -> cgroup_status override;
 
     void destroy_cgroup([[maybe_unused]] const cgroup_status &status) override;
+
+    void update_resource(const cgroup_status &status,
+                         const oci_config::linux_t::resources_t &resources) override;
 };
 
 } // namespace linyaps_box
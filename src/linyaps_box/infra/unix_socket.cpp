@@ -14,6 +14,7 @@
 #include <stdexcept>
 
 #include <sys/socket.h>
+#include <unistd.h>
 
 namespace linyaps_box::infra {
 
@@ -32,6 +33,42 @@ unix_socket unix_socket::connect(const std::filesystem::path &path)
     return unix_socket{ std::move(fd) };
 }
 
+unix_socket unix_socket::listen(const std::filesystem::path &path)
+{
+    auto ep = os::throw_if_error(os::endpoint::from_path(path));
+    auto fd = os::throw_if_error(os::socket(os::sys::address_family::unix,
+                                            os::sys::socket_type::seqpacket,
+                                            os::sys::socket_flag::cloexec));
+    os::throw_if_error(os::bind(fd.ref(), ep), "bind " + path.string());
+    os::throw_if_error(os::listen(fd.ref()));
+    return unix_socket{ std::move(fd) };
+}
+
+auto unix_socket::accept() const -> std::optional<unix_socket>
+{
+    auto conn = os::accept(fd_.ref(), os::sys::socket_flag::cloexec);
+    if (!conn) {
+        if (conn.error() == std::errc::resource_unavailable_try_again) {
+            return std::nullopt;
+        }
+
+        throw std::system_error(conn.error(), "accept");
+    }
+
+    return unix_socket{ std::move(conn).value() };
+}
+
+auto unix_socket::peer_is_trusted() const noexcept -> bool
+{
+    struct ucred cred{ };
+    socklen_t len = sizeof(cred);
+    if (::getsockopt(fd_.get(), SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+        return false;
+    }
+
+    return cred.uid == 0 || cred.uid == ::geteuid();
+}
+
 auto unix_socket::send(utils::span<const std::byte> data) const -> os::Result<std::size_t>
 {
     return os::send(fd_.ref(), data);
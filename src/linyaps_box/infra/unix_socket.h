@@ -8,6 +8,7 @@
 #include "linyaps_box/utils/file_describer.h"
 
 #include <filesystem>
+#include <optional>
 #include <vector>
 
 namespace linyaps_box::infra {
@@ -24,6 +25,8 @@ class unix_socket
 {
 public:
     static unix_socket connect(const std::filesystem::path &path);
+    // Bind a SOCK_SEQPACKET socket to path and listen on it, path must not exist.
+    static unix_socket listen(const std::filesystem::path &path);
 
     unix_socket(const unix_socket &) = delete;
     auto operator=(const unix_socket &) -> unix_socket & = delete;
@@ -51,6 +54,14 @@ public:
 
     [[nodiscard]] auto recv_fd() const -> utils::file_descriptor;
 
+    // The next pending connection of a listening socket, nullopt if there is none
+    // and the socket is non-blocking.
+    [[nodiscard]] auto accept() const -> std::optional<unix_socket>;
+
+    // Whether the peer runs as root or as our effective user, false if its
+    // credentials can not be read.
+    [[nodiscard]] auto peer_is_trusted() const noexcept -> bool;
+
     // TODO: after removing file_descriptor::auto_close, file_descriptor will
     // have the same layout as int; change this parameter to
     // span<const file_descriptor> so senders pass owning fds directly without
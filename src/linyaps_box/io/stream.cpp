@@ -132,6 +132,26 @@ auto read_to_end(utils::file_descriptor_ref fd, utils::uninit_vector<std::byte>
     return buf.size() - initial_size;
 }
 
+auto read_exact(utils::file_descriptor_ref fd, utils::span<std::byte> buf) noexcept
+  -> os::Result<std::size_t>
+{
+    std::size_t total{ 0 };
+    while (total < buf.size()) {
+        auto ret = os::read(fd, buf.subspan(total));
+        if (UNLIKELY(!ret)) {
+            return os::unexpected{ ret.error() };
+        }
+
+        if (*ret == 0) {
+            break;
+        }
+
+        total += *ret;
+    }
+
+    return total;
+}
+
 auto write_all(utils::file_descriptor_ref fd, utils::span<const std::byte> buf) noexcept
   -> os::Result<void>
 {
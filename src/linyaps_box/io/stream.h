@@ -14,6 +14,10 @@ namespace linyaps_box::io {
 auto read_to_end(utils::file_descriptor_ref fd, utils::uninit_vector<std::byte> &buf) noexcept
   -> os::Result<std::size_t>;
 
+// Read until buf is full or EOF, returns the number of bytes read.
+auto read_exact(utils::file_descriptor_ref fd, utils::span<std::byte> buf) noexcept
+  -> os::Result<std::size_t>;
+
 auto write_all(utils::file_descriptor_ref fd, utils::span<const std::byte> buf) noexcept
   -> os::Result<void>;
 
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/memory_reclaim.h"
+
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/os/fs.h"
+
+#include <fmt/format.h>
+
+#include <cerrno>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <unistd.h>
+
+namespace linyaps_box {
+
+namespace {
+
+constexpr auto trigger_annotation = "cn.org.linyaps.runtime.memory_reclaim.trigger";
+constexpr auto step_annotation = "cn.org.linyaps.runtime.memory_reclaim.step";
+
+auto parse_duration(std::string_view str) -> std::chrono::microseconds
+{
+    std::uint64_t value{ };
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec != std::errc{ } || ptr == str.data()) {
+        throw std::invalid_argument(fmt::format("invalid duration: {}", str));
+    }
+
+    const std::string_view unit{ ptr, static_cast<std::size_t>(str.data() + str.size() - ptr) };
+    if (unit.empty() || unit == "us") {
+        return std::chrono::microseconds{ value };
+    }
+    if (unit == "ms") {
+        return std::chrono::milliseconds{ value };
+    }
+    if (unit == "s") {
+        return std::chrono::seconds{ value };
+    }
+
+    throw std::invalid_argument(fmt::format("invalid duration unit: {}", str));
+}
+
+// memory.reclaim takes a byte count with an optional K, M or G suffix
+void validate_step(std::string_view step)
+{
+    std::uint64_t value{ };
+    auto [ptr, ec] = std::from_chars(step.data(), step.data() + step.size(), value);
+    const std::string_view suffix{ ptr,
+                                   static_cast<std::size_t>(step.data() + step.size() - ptr) };
+    if (ec != std::errc{ } || value == 0
+        || !(suffix.empty() || suffix == "K" || suffix == "M" || suffix == "G")) {
+        throw std::invalid_argument(fmt::format("invalid memory reclaim step: {}", step));
+    }
+}
+
+} // namespace
+
+auto parse_memory_reclaim_policy(const std::unordered_map<std::string, std::string> &annotations)
+  -> std::optional<memory_reclaim_policy>
+{
+    auto it = annotations.find(trigger_annotation);
+    if (it == annotations.end()) {
+        return std::nullopt;
+    }
+
+    memory_reclaim_policy policy;
+    std::istringstream stream{ it->second };
+    std::string kind;
+    std::string stall;
+    std::string window;
+    std::string extra;
+    if (!(stream >> kind >> stall >> window) || stream >> extra
+        || (kind != "some" && kind != "full")) {
+        throw std::invalid_argument(fmt::format("invalid memory reclaim trigger: {}", it->second));
+    }
+
+    policy.full = kind == "full";
+    policy.stall = parse_duration(stall);
+    policy.window = parse_duration(window);
+    if (policy.stall.count() == 0 || policy.stall > policy.window) {
+        throw std::invalid_argument(
+          fmt::format("memory reclaim stall must be within the window: {}", it->second));
+    }
+
+    if (auto step = annotations.find(step_annotation); step != annotations.end()) {
+        validate_step(step->second);
+        policy.step = step->second;
+    }
+
+    return policy;
+}
+
+auto to_psi_trigger(const memory_reclaim_policy &policy) -> std::string
+{
+    return fmt::format("{} {} {}",
+                       policy.full ? "full" : "some",
+                       policy.stall.count(),
+                       policy.window.count());
+}
+
+memory_reclaimer::memory_reclaimer(utils::file_descriptor_ref cgroup_dirfd,
+                                   memory_reclaim_policy policy)
+    : policy(std::move(policy))
+{
+    reclaim_fd = os::throw_if_error(
+      os::openat(cgroup_dirfd,
+                 "memory.reclaim",
+                 { os::sys::open_flag::cloexec, os::sys::access_mode::write_only }),
+      "open memory.reclaim");
+
+    // the trigger lives as long as this fd, writing it arms the fd for EPOLLPRI
+    trigger = os::throw_if_error(
+      os::openat(cgroup_dirfd,
+                 "memory.pressure",
+                 { os::sys::open_flag::cloexec | os::sys::open_flag::non_block,
+                   os::sys::access_mode::read_write }),
+      "open memory.pressure");
+
+    const auto spec = to_psi_trigger(this->policy);
+    // the kernel wants the terminating NUL
+    if (::write(trigger.get(), spec.c_str(), spec.size() + 1) < 0) {
+        throw std::system_error(errno,
+                                std::system_category(),
+                                "register PSI trigger \"" + spec + "\"");
+    }
+}
+
+void memory_reclaimer::reclaim() const noexcept
+{
+    LINYAPS_BOX_LOG_DEBUG("Memory pressure exceeded, reclaim {}", policy.step);
+    if (::write(reclaim_fd.get(), policy.step.data(), policy.step.size()) < 0) {
+        // EAGAIN: less than the step could be reclaimed
+        if (errno != EAGAIN) {
+            LINYAPS_BOX_LOG_WARN_ERRNO(errno, "failed to write memory.reclaim");
+        }
+    }
+}
+
+} // namespace linyaps_box
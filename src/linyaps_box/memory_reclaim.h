@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/utils/file_describer.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace linyaps_box {
+
+// Proactive reclaim of a container's memory, enabled through annotations:
+//   cn.org.linyaps.runtime.memory_reclaim.trigger  "some 150ms 1s", a PSI trigger on
+//                                                   memory.pressure: stall time
+//                                                   within a window, bare numbers
+//                                                   are microseconds; without
+//                                                   CAP_SYS_RESOURCE the kernel
+//                                                   wants a multiple of 2s
+//   cn.org.linyaps.runtime.memory_reclaim.step     bytes written to memory.reclaim
+//                                                   each time it fires, such as 64M
+struct memory_reclaim_policy
+{
+    bool full{ false };
+    std::chrono::microseconds stall{ };
+    std::chrono::microseconds window{ };
+    std::string step{ "64M" };
+};
+
+// Throws std::invalid_argument for malformed annotations.
+[[nodiscard]] auto
+parse_memory_reclaim_policy(const std::unordered_map<std::string, std::string> &annotations)
+  -> std::optional<memory_reclaim_policy>;
+
+// The trigger as written to memory.pressure, e.g. "some 150000 1000000".
+[[nodiscard]] auto to_psi_trigger(const memory_reclaim_policy &policy) -> std::string;
+
+// Holds the PSI trigger registered on a cgroup's memory.pressure. The trigger fd
+// reports EPOLLPRI at most once per window while the stall threshold is exceeded,
+// and EPOLLERR once the cgroup is gone.
+class memory_reclaimer
+{
+public:
+    memory_reclaimer(utils::file_descriptor_ref cgroup_dirfd, memory_reclaim_policy policy);
+
+    [[nodiscard]] auto trigger_fd() const noexcept -> const utils::file_descriptor &
+    {
+        return trigger;
+    }
+
+    // Ask the kernel to reclaim one step from the cgroup. Falling short of the
+    // step is expected under pressure and not an error.
+    void reclaim() const noexcept;
+
+private:
+    memory_reclaim_policy policy;
+    utils::file_descriptor trigger;
+    utils::file_descriptor reclaim_fd;
+};
+
+} // namespace linyaps_box
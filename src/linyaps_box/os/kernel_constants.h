@@ -10,6 +10,9 @@
 
 #include <cstdint>
 
+#include <fcntl.h>
+#include <sched.h>
+
 namespace linyaps_box::os::sys {
 
 // MS_NOSYMFOLLOW since Linux 5.10
@@ -74,4 +77,56 @@ inline constexpr uint64_t mount_attr_nosymfollow = MOUNT_ATTR_NOSYMFOLLOW;
 inline constexpr uint64_t mount_attr_nosymfollow = 0x00200000ULL;
 #endif
 
+#ifdef MOUNT_ATTR_IDMAP
+inline constexpr uint64_t mount_attr_idmap = MOUNT_ATTR_IDMAP;
+#else
+inline constexpr uint64_t mount_attr_idmap = 0x00100000ULL;
+#endif
+
+// MOUNT_ATTR__ATIME: the atime mode is a field, not a bit. It has to be cleared
+// as a whole whenever one of its values is set.
+#ifdef MOUNT_ATTR__ATIME
+inline constexpr uint64_t mount_attr__atime = MOUNT_ATTR__ATIME;
+#else
+inline constexpr uint64_t mount_attr__atime = 0x00000070ULL;
+#endif
+
+// open_tree(2) and move_mount(2) since kernel 5.2
+#ifdef OPEN_TREE_CLONE
+inline constexpr unsigned int open_tree_clone = OPEN_TREE_CLONE;
+#else
+inline constexpr unsigned int open_tree_clone = 1U;
+#endif
+
+#ifdef AT_RECURSIVE
+inline constexpr unsigned int at_recursive = AT_RECURSIVE;
+#else
+inline constexpr unsigned int at_recursive = 0x8000U;
+#endif
+
+#ifdef MOVE_MOUNT_F_EMPTY_PATH
+inline constexpr unsigned int move_mount_f_empty_path = MOVE_MOUNT_F_EMPTY_PATH;
+#else
+inline constexpr unsigned int move_mount_f_empty_path = 0x00000004U;
+#endif
+
+#ifdef MOVE_MOUNT_T_EMPTY_PATH
+inline constexpr unsigned int move_mount_t_empty_path = MOVE_MOUNT_T_EMPTY_PATH;
+#else
+inline constexpr unsigned int move_mount_t_empty_path = 0x00000040U;
+#endif
+
+// CLONE_PIDFD since kernel 5.2, CLONE_INTO_CGROUP (clone3(2) only) since kernel 5.7
+#ifdef CLONE_PIDFD
+inline constexpr uint64_t clone_pidfd = CLONE_PIDFD;
+#else
+inline constexpr uint64_t clone_pidfd = 0x00001000ULL;
+#endif
+
+#ifdef CLONE_INTO_CGROUP
+inline constexpr uint64_t clone_into_cgroup = CLONE_INTO_CGROUP;
+#else
+inline constexpr uint64_t clone_into_cgroup = 0x200000000ULL;
+#endif
+
 } // namespace linyaps_box::os::sys
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/os/mount.h"
+
+#include "linyaps_box/utils/utils.h"
+
+#include <unistd.h>
+
+#include <sys/syscall.h>
+
+#include "linyaps_box/os/kernel_constants.h"
+
+namespace {
+
+constexpr auto open_tree_sys =
+#ifndef __NR_open_tree
+  428;
+#else
+  __NR_open_tree;
+#endif
+
+constexpr auto move_mount_sys =
+#ifndef __NR_move_mount
+  429;
+#else
+  __NR_move_mount;
+#endif
+
+constexpr auto mount_setattr_sys =
+#ifndef __NR_mount_setattr
+  442;
+#else
+  __NR_mount_setattr;
+#endif
+
+} // namespace
+
+namespace linyaps_box::os {
+
+auto new_mount_api_supported() noexcept -> bool
+{
+    // An empty attribute set is a no-op that returns before the path is looked up,
+    // so this only fails with ENOSYS on kernels older than 5.12 (or EPERM under a
+    // seccomp filter, or without CAP_SYS_ADMIN in the current mount namespace).
+    static const auto supported = [] {
+        sys::mount_attr attr{ };
+        return ::syscall(mount_setattr_sys, -1, "", AT_EMPTY_PATH, &attr, sizeof(attr)) == 0;
+    }();
+
+    return supported;
+}
+
+auto open_tree_clone(utils::file_descriptor_ref fd, bool recursive) noexcept
+  -> Result<utils::file_descriptor>
+{
+    auto flags = sys::open_tree_clone | O_CLOEXEC | AT_EMPTY_PATH;
+    if (recursive) {
+        flags |= sys::at_recursive;
+    }
+
+    const auto ret = static_cast<int>(::syscall(open_tree_sys, fd.get(), "", flags));
+    if (UNLIKELY(ret < 0)) {
+        const auto err = errno;
+        return unexpected{ make_error_code(err) };
+    }
+
+    return utils::file_descriptor{ ret };
+}
+
+auto move_mount(utils::file_descriptor_ref from, utils::file_descriptor_ref to) noexcept
+  -> Result<void>
+{
+    if (UNLIKELY(::syscall(move_mount_sys,
+                           from.get(),
+                           "",
+                           to.get(),
+                           "",
+                           sys::move_mount_f_empty_path | sys::move_mount_t_empty_path)
+                 < 0)) {
+        const auto err = errno;
+        return unexpected{ make_error_code(err) };
+    }
+
+    return { };
+}
+
+auto mount_setattr(utils::file_descriptor_ref fd,
+                   const sys::mount_attr &attr,
+                   bool recursive) noexcept -> Result<void>
+{
+    auto flags = static_cast<unsigned int>(AT_EMPTY_PATH);
+    if (recursive) {
+        flags |= sys::at_recursive;
+    }
+
+    // the kernel takes a non-const pointer but never writes through it
+    auto copy = attr;
+    if (UNLIKELY(::syscall(mount_setattr_sys, fd.get(), "", flags, &copy, sizeof(copy)) < 0)) {
+        const auto err = errno;
+        return unexpected{ make_error_code(err) };
+    }
+
+    return { };
+}
+
+} // namespace linyaps_box::os
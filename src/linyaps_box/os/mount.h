@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/os/result.h"
+#include "linyaps_box/utils/file_describer.h"
+
+#include <cstdint>
+
+namespace linyaps_box::os {
+
+namespace sys {
+
+// Same layout as struct mount_attr of mount_setattr(2).
+struct mount_attr
+{
+    uint64_t attr_set{ 0 };
+    uint64_t attr_clr{ 0 };
+    uint64_t propagation{ 0 };
+    uint64_t userns_fd{ 0 };
+};
+
+} // namespace sys
+
+// Whether open_tree(2), move_mount(2) and mount_setattr(2) are all usable,
+// i.e. the kernel is at least 5.12 and no seccomp filter rejects them.
+// The result is probed once per process.
+[[nodiscard]] auto new_mount_api_supported() noexcept -> bool;
+
+// open_tree(fd, "", OPEN_TREE_CLONE | OPEN_TREE_CLOEXEC | AT_EMPTY_PATH): a detached copy
+// of the mount at fd, with all submounts if recursive.
+[[nodiscard]] auto open_tree_clone(utils::file_descriptor_ref fd, bool recursive) noexcept
+  -> Result<utils::file_descriptor>;
+
+// Attach the mount tree at from onto the location referred by to.
+[[nodiscard]] auto move_mount(utils::file_descriptor_ref from,
+                              utils::file_descriptor_ref to) noexcept -> Result<void>;
+
+// Change the attributes of the mount at fd, or of the whole tree below it if recursive.
+[[nodiscard]] auto mount_setattr(utils::file_descriptor_ref fd,
+                                 const sys::mount_attr &attr,
+                                 bool recursive) noexcept -> Result<void>;
+
+} // namespace linyaps_box::os
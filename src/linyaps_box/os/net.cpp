@@ -251,4 +251,39 @@ auto connect(utils::file_descriptor_ref fd, const endpoint &ep) noexcept -> Resu
     }
 }
 
+auto bind(utils::file_descriptor_ref fd, const endpoint &ep) noexcept -> Result<void>
+{
+    if (UNLIKELY(::bind(fd, ep.data(), ep.size()) != 0)) {
+        return unexpected{ make_error_code(errno) };
+    }
+
+    return { };
+}
+
+auto listen(utils::file_descriptor_ref fd, int backlog) noexcept -> Result<void>
+{
+    if (UNLIKELY(::listen(fd, backlog) != 0)) {
+        return unexpected{ make_error_code(errno) };
+    }
+
+    return { };
+}
+
+auto accept(utils::file_descriptor_ref fd, sys::socket_flag flag) noexcept
+  -> Result<utils::file_descriptor>
+{
+    while (true) {
+        auto conn = ::accept4(fd, nullptr, nullptr, static_cast<int>(flag));
+        if (LIKELY(conn >= 0)) {
+            return utils::file_descriptor{ conn };
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        return unexpected{ make_error_code(errno) };
+    }
+}
+
 } // namespace linyaps_box::os
@@ -524,6 +524,13 @@ auto recvmsg(utils::file_descriptor_ref fd,
 
 auto connect(utils::file_descriptor_ref fd, const endpoint &ep) noexcept -> Result<void>;
 
+auto bind(utils::file_descriptor_ref fd, const endpoint &ep) noexcept -> Result<void>;
+
+auto listen(utils::file_descriptor_ref fd, int backlog = SOMAXCONN) noexcept -> Result<void>;
+
+auto accept(utils::file_descriptor_ref fd, sys::socket_flag flag = sys::socket_flag::none) noexcept
+  -> Result<utils::file_descriptor>;
+
 // currently we don't need other protocols, so we only provide a 'int' type for protocol, and we
 // don't provide a wrapper class for it. If we need to support more protocols in the future, we can
 // add a wrapper class for protocol.
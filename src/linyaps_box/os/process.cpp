@@ -8,12 +8,37 @@
 
 #include <sys/prctl.h>
 
+#include <unistd.h>
+
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
 
 namespace linyaps_box::os {
 
 namespace {
+
+constexpr auto pidfd_send_signal_sys =
+#ifndef __NR_pidfd_send_signal
+  424;
+#else
+  __NR_pidfd_send_signal;
+#endif
+
+constexpr auto pidfd_open_sys =
+#ifndef __NR_pidfd_open
+  434;
+#else
+  __NR_pidfd_open;
+#endif
+
+constexpr auto clone3_sys =
+#ifndef __NR_clone3
+  435;
+#else
+  __NR_clone3;
+#endif
+
 auto prctl(int option,
            unsigned long arg2 = 0,
            unsigned long arg3 = 0,
@@ -52,6 +77,58 @@ auto waitpid(pid_t pid, int &status, int options) noexcept -> Result<int>
     __builtin_unreachable();
 }
 
+auto wait4(pid_t pid, int &status, int options, struct rusage &usage) noexcept -> Result<int>
+{
+    status = 0;
+    while (true) {
+        auto ret = ::wait4(pid, &status, options, &usage);
+        if (ret >= 0) {
+            if (WIFSTOPPED(status) || WIFCONTINUED(status)) {
+                continue;
+            }
+
+            return ret;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        return unexpected{ make_error_code(errno) };
+    }
+
+    __builtin_unreachable();
+}
+
+auto clone3(sys::clone_args &args) noexcept -> Result<pid_t>
+{
+    const auto ret = ::syscall(clone3_sys, &args, sizeof(args));
+    if (UNLIKELY(ret < 0)) {
+        return unexpected{ make_error_code(errno) };
+    }
+
+    return static_cast<pid_t>(ret);
+}
+
+auto pidfd_open(pid_t pid) noexcept -> Result<utils::file_descriptor>
+{
+    const auto ret = static_cast<int>(::syscall(pidfd_open_sys, pid, 0));
+    if (UNLIKELY(ret < 0)) {
+        return unexpected{ make_error_code(errno) };
+    }
+
+    return utils::file_descriptor{ ret };
+}
+
+auto pidfd_send_signal(utils::file_descriptor_ref pidfd, int sig) noexcept -> Result<void>
+{
+    if (UNLIKELY(::syscall(pidfd_send_signal_sys, pidfd.get(), sig, nullptr, 0) < 0)) {
+        return unexpected{ make_error_code(errno) };
+    }
+
+    return { };
+}
+
 auto get_exit_code(int status) noexcept -> Result<int>
 {
     if (WIFEXITED(status)) {
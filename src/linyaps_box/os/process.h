@@ -5,13 +5,49 @@
 #pragma once
 
 #include "linyaps_box/os/result.h"
+#include "linyaps_box/utils/file_describer.h"
 
+#include <sys/resource.h>
+
+#include <cstdint>
 #include <filesystem>
 
 namespace linyaps_box::os {
 
+namespace sys {
+
+// Same layout as struct clone_args of clone3(2), up to the cgroup field (CLONE_ARGS_SIZE_VER2).
+struct clone_args
+{
+    uint64_t flags{ 0 };
+    uint64_t pidfd{ 0 };
+    uint64_t child_tid{ 0 };
+    uint64_t parent_tid{ 0 };
+    uint64_t exit_signal{ 0 };
+    uint64_t stack{ 0 };
+    uint64_t stack_size{ 0 };
+    uint64_t tls{ 0 };
+    uint64_t set_tid{ 0 };
+    uint64_t set_tid_size{ 0 };
+    uint64_t cgroup{ 0 };
+};
+
+} // namespace sys
+
+// clone3(2) without a stack behaves like fork(2): it returns the child pid in
+// the parent and 0 in the child, which goes on with a copy of the caller's stack.
+[[nodiscard]] auto clone3(sys::clone_args &args) noexcept -> Result<pid_t>;
+
+[[nodiscard]] auto pidfd_open(pid_t pid) noexcept -> Result<utils::file_descriptor>;
+
+auto pidfd_send_signal(utils::file_descriptor_ref pidfd, int sig) noexcept -> Result<void>;
+
 [[nodiscard]] auto waitpid(pid_t pid, int &status, int options) noexcept -> Result<int>;
 
+// Like waitpid, and fills usage with the resource usage of the reaped child.
+[[nodiscard]] auto wait4(pid_t pid, int &status, int options, struct rusage &usage) noexcept
+  -> Result<int>;
+
 auto set_child_subreaper(bool enabled) noexcept -> Result<void>;
 
 auto set_keep_capabilities(bool enabled) noexcept -> Result<void>;
@@ -75,6 +75,56 @@ auto read_string(utils::span<const std::byte> data, std::size_t &offset) -> std:
     return result;
 }
 
+// origin + begin + end + (name+detail)*uint32
+constexpr auto phase_wire_overhead =
+  sizeof(uint8_t) + (2 * sizeof(std::int64_t)) + (2 * sizeof(uint32_t));
+
+auto append_phases(std::vector<std::byte> &buf, const std::vector<utils::phase_record> &phases)
+  -> void
+{
+    if (UNLIKELY(phases.size() > std::numeric_limits<uint32_t>::max())) {
+        throw std::logic_error("too many phases for wire format");
+    }
+
+    append_pod(buf, static_cast<uint32_t>(phases.size()));
+    for (const auto &p : phases) {
+        append_pod(buf, static_cast<uint8_t>(p.origin));
+        append_string(buf, p.name);
+        append_string(buf, p.detail);
+        append_pod<std::int64_t>(buf, p.begin.count());
+        append_pod<std::int64_t>(buf, p.end.count());
+    }
+}
+
+auto read_phases(utils::span<const std::byte> data, std::size_t &offset)
+  -> std::vector<utils::phase_record>
+{
+    auto count = read_pod<uint32_t>(data, offset);
+    // every phase occupies at least phase_wire_overhead bytes, reject counts
+    // that cannot possibly fit before allocating anything
+    if (UNLIKELY(count > (data.size() - offset) / phase_wire_overhead)) {
+        throw std::runtime_error("payload too short for phase records");
+    }
+
+    std::vector<utils::phase_record> phases;
+    phases.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto origin_raw = read_pod<uint8_t>(data, offset);
+        if (UNLIKELY(origin_raw > static_cast<uint8_t>(utils::phase_origin::container))) {
+            throw std::runtime_error(fmt::format("invalid phase origin: {}", origin_raw));
+        }
+
+        auto &p = phases.emplace_back();
+        p.origin = static_cast<utils::phase_origin>(origin_raw);
+        p.name = read_string(data, offset);
+        p.detail = read_string(data, offset);
+        p.begin = std::chrono::nanoseconds{ read_pod<std::int64_t>(data, offset) };
+        p.end = std::chrono::nanoseconds{ read_pod<std::int64_t>(data, offset) };
+    }
+
+    return phases;
+}
+
 } // namespace
 
 auto datagram::take_fds() -> std::vector<utils::file_descriptor>
@@ -96,9 +146,11 @@ auto serialize(const message &msg) -> std::vector<std::byte>
                         },
                         [](const stage &m) -> std::vector<std::byte> {
                             std::vector<std::byte> buf;
-                            buf.reserve(sizeof(msg_id) + sizeof(m.value));
+                            buf.reserve(sizeof(msg_id) + sizeof(m.value) + sizeof(uint32_t)
+                                        + (m.phases.size() * phase_wire_overhead));
                             append_pod(buf, msg_id::stage);
                             append_pod(buf, m.value);
+                            append_phases(buf, m.phases);
                             return buf;
                         },
                         [](const pid_report &m) -> std::vector<std::byte> {
@@ -120,6 +172,13 @@ auto serialize(const message &msg) -> std::vector<std::byte>
                             append_pod(buf, msg_id::proceed);
                             return buf;
                         },
+                        [](const mount_fd &m) -> std::vector<std::byte> {
+                            std::vector<std::byte> buf;
+                            buf.reserve(sizeof(msg_id) + sizeof(m.index));
+                            append_pod(buf, msg_id::mount_fd);
+                            append_pod(buf, m.index);
+                            return buf;
+                        },
                       },
                       msg);
 }
@@ -173,7 +232,7 @@ auto deserialize(utils::span<const std::byte> wire) -> message
                           static_cast<std::underlying_type_t<protocol::stage::type>>(value)));
         }
 
-        return stage{ value };
+        return stage{ value, read_phases(payload, offset) };
     }
     case msg_id::pid_report: {
         return pid_report{ read_pod<decltype(pid_report::value)>(payload, offset) };
@@ -184,6 +243,9 @@ auto deserialize(utils::span<const std::byte> wire) -> message
     case msg_id::proceed: {
         return proceed{ };
     }
+    case msg_id::mount_fd: {
+        return mount_fd{ read_pod<decltype(mount_fd::index)>(payload, offset) };
+    }
     default: {
         throw std::runtime_error(
           fmt::format("unknown msg_id: {}", static_cast<std::underlying_type_t<msg_id>>(id)));
@@ -7,6 +7,7 @@
 #include "linyaps_box/log/utils.h"
 #include "linyaps_box/utils/file_describer.h"
 #include "linyaps_box/utils/span.h"
+#include "linyaps_box/utils/timing.h"
 
 #include <fmt/std.h>
 
@@ -28,6 +29,7 @@ enum class msg_id : uint8_t {
     pid_report,
     console_fd,
     proceed,
+    mount_fd,
 };
 
 namespace stage {
@@ -40,6 +42,7 @@ enum class type : uint8_t {
     createruntime_ready,
     createruntime_done,
     createcontainer_done,
+    created,
     exec_ready,
 };
 
@@ -61,6 +64,8 @@ enum class type : uint8_t {
         return "createruntime_done"sv;
     case type::createcontainer_done:
         return "createcontainer_done"sv;
+    case type::created:
+        return "created"sv;
     case type::exec_ready:
         return "exec_ready"sv;
     }
@@ -78,6 +83,7 @@ enum class type : uint8_t {
     case type::createruntime_ready:
     case type::createruntime_done:
     case type::createcontainer_done:
+    case type::created:
     case type::exec_ready:
         return true;
     }
@@ -109,6 +115,9 @@ struct log
 struct stage
 {
     protocol::stage::type value{ };
+    // Phases recorded by the sender since its previous stage message,
+    // always empty unless startup timing is enabled.
+    std::vector<utils::phase_record> phases;
 };
 
 struct pid_report
@@ -124,7 +133,14 @@ struct proceed
 {
 };
 
-using message = std::variant<log, stage, pid_report, console_fd, proceed>;
+// A detached mount prepared by the runtime for the mount entry at index,
+// carried as the only fd.
+struct mount_fd
+{
+    std::uint32_t index{ };
+};
+
+using message = std::variant<log, stage, pid_report, console_fd, proceed, mount_fd>;
 
 struct datagram
 {
@@ -170,7 +186,7 @@ struct fmt::formatter<linyaps_box::protocol::msg::stage> : fmt::formatter<std::s
 {
     auto format(const linyaps_box::protocol::msg::stage &s, fmt::format_context &ctx) const
     {
-        return fmt::format_to(ctx.out(), "stage{{value={}}}", s.value);
+        return fmt::format_to(ctx.out(), "stage{{value={}, phases={}}}", s.value, s.phases.size());
     }
 };
 
@@ -203,6 +219,15 @@ struct fmt::formatter<linyaps_box::protocol::msg::proceed> : fmt::formatter<std:
     }
 };
 
+template <>
+struct fmt::formatter<linyaps_box::protocol::msg::mount_fd> : fmt::formatter<std::string>
+{
+    auto format(const linyaps_box::protocol::msg::mount_fd &m, fmt::format_context &ctx) const
+    {
+        return fmt::format_to(ctx.out(), "mount_fd{{index={}}}", m.index);
+    }
+};
+
 template <>
 struct fmt::formatter<linyaps_box::protocol::stage::type> : fmt::formatter<std::string>
 {
@@ -6,6 +6,7 @@
 
 #include "linyaps_box/log/logger.h"
 #include "linyaps_box/utils/span.h"
+#include "linyaps_box/utils/timing.h"
 #include "linyaps_box/utils/utils.h"
 
 #include <fmt/std.h>
@@ -17,6 +18,7 @@
 #include <stdexcept>
 #include <system_error>
 
+#include <poll.h>
 #include <unistd.h>
 
 namespace linyaps_box::protocol {
@@ -33,6 +35,20 @@ auto channel_transport::send(const msg::message &body,
     send_bytes(buffer, fds);
 }
 
+auto channel_transport::readable(std::chrono::milliseconds timeout) const -> bool
+{
+    pollfd pfd{ socket.fd().get(), POLLIN, 0 };
+    auto ret = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (UNLIKELY(ret < 0)) {
+        if (errno == EINTR) {
+            return false;
+        }
+        throw std::system_error(errno, std::system_category(), "poll message_channel socket");
+    }
+
+    return ret > 0;
+}
+
 auto channel_transport::send_bytes(utils::span<const std::byte> buffer,
                                    utils::span<const utils::file_descriptor_ref> fds) -> void
 {
@@ -113,7 +129,7 @@ parent_message_channel::parent_message_channel(infra::unix_socket socket) noexce
 
 auto parent_message_channel::send_stage(stage::type s) -> void
 {
-    transport.send(msg::stage{ s });
+    transport.send(msg::stage{ s, { } });
 }
 
 auto parent_message_channel::send_proceed() -> void
@@ -121,8 +137,16 @@ auto parent_message_channel::send_proceed() -> void
     transport.send(msg::proceed{ });
 }
 
+auto parent_message_channel::send_mount_fd(std::uint32_t index, utils::file_descriptor_ref fd)
+  -> void
+{
+    transport.send(msg::mount_fd{ index }, utils::span<const utils::file_descriptor_ref>{ &fd, 1 });
+}
+
 auto parent_message_channel::wait_for_stage(stage::type expected) -> void
 {
+    const utils::phase_scope phase{ "wait_for_stage", stage::to_string_view(expected) };
+
     while (true) {
         auto inc = transport.recv();
         if (UNLIKELY(!inc)) {
@@ -137,12 +161,13 @@ auto parent_message_channel::wait_for_stage(stage::type expected) -> void
                            log::global_logger::instance().dispatch_context(msg::to_log_context(l));
                            return false;
                        },
-                       [&](const msg::stage &s) {
+                       [&](msg::stage &s) {
                            if (UNLIKELY(s.value != expected)) {
                                throw std::runtime_error(
                                  fmt::format("expected stage {} but got {}", expected, s.value));
                            }
 
+                           utils::phase_recorder::instance().merge(std::move(s.phases));
                            return true;
                        },
                        [&](const auto &) -> bool {
@@ -223,7 +248,8 @@ child_message_channel::child_message_channel(infra::unix_socket socket) noexcept
 
 auto child_message_channel::send_stage(stage::type s) -> void
 {
-    transport.send(msg::stage{ s });
+    // piggyback the phases recorded so far, the runtime merges them on receipt
+    transport.send(msg::stage{ s, utils::phase_recorder::instance().take() });
 }
 
 auto child_message_channel::send_pid_report(pid_t pid) -> void
@@ -280,6 +306,35 @@ auto child_message_channel::expect_proceed() -> void
                inc->body);
 }
 
+auto child_message_channel::expect_mount_fd(std::uint32_t index) -> utils::file_descriptor
+{
+    auto inc = transport.recv();
+    if (UNLIKELY(!inc)) {
+        throw std::runtime_error("socket closed before receiving mount fd");
+    }
+
+    std::visit(utils::Overload{
+                 [&](const msg::mount_fd &m) {
+                     if (UNLIKELY(m.index != index)) {
+                         throw std::runtime_error(fmt::format(
+                           "expected fd of mount {} but got one of mount {}", index, m.index));
+                     }
+                 },
+                 [&](const auto &other) {
+                     throw std::runtime_error(
+                       fmt::format("unexpected message during expect_mount_fd: {}", other));
+                 },
+               },
+               inc->body);
+
+    auto fds = inc->take_fds();
+    if (UNLIKELY(fds.size() != 1)) {
+        throw std::runtime_error(fmt::format("expected one mount fd but got {}", fds.size()));
+    }
+
+    return std::move(fds.front());
+}
+
 auto create_message_socketpair() -> std::pair<parent_message_channel, child_message_channel>
 {
     auto [c1, c2] = infra::unix_socket::create_pair(os::sys::socket_type::seqpacket,
@@ -7,6 +7,7 @@
 #include "linyaps_box/infra/unix_socket.h"
 #include "linyaps_box/protocol/message.h"
 
+#include <chrono>
 #include <optional>
 #include <utility>
 
@@ -30,6 +31,8 @@ public:
       -> void;
 
     [[nodiscard]] auto recv() -> std::optional<msg::datagram>;
+    // Whether recv() would return without blocking within timeout.
+    [[nodiscard]] auto readable(std::chrono::milliseconds timeout) const -> bool;
 
     auto close() & -> void { socket.close(); }
 
@@ -64,9 +67,14 @@ public:
 
     auto send_stage(stage::type s) -> void;
     auto send_proceed() -> void;
+    auto send_mount_fd(std::uint32_t index, utils::file_descriptor_ref fd) -> void;
     auto wait_for_stage(stage::type expected) -> void;
     auto wait_for_close() -> void;
     [[nodiscard]] auto drain_logs() -> msg::datagram;
+    [[nodiscard]] auto readable(std::chrono::milliseconds timeout) const -> bool
+    {
+        return transport.readable(timeout);
+    }
 
     auto close() & -> void { transport.close(); }
 };
@@ -87,7 +95,8 @@ class child_message_channel
     // Logs flow strictly child→parent — the child forwards via the forwarder,
     // the parent drains via wait_for_stage()/drain_logs()/wait_for_close().
     // The child side only sends control messages (stage/pid_report/console_fd)
-    // and receives control messages (expect_stage/expect_proceed); it never
+    // and receives control messages (expect_stage/expect_proceed/
+    // expect_mount_fd); it never
     // drains logs.  Exposing a general raw-bytes sender to all callers would
     // let arbitrary code forge wire frames, so the single legitimate user is
     // friended instead.
@@ -105,6 +114,8 @@ public:
     auto send_console_fd(utils::file_descriptor_ref fd) -> void;
     auto expect_stage(stage::type expected) -> void;
     auto expect_proceed() -> void;
+    // The mount sent for the mount entry at index, see send_mount_fd.
+    [[nodiscard]] auto expect_mount_fd(std::uint32_t index) -> utils::file_descriptor;
 
     auto close() & -> void { transport.close(); }
 };
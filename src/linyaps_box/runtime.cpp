@@ -4,6 +4,10 @@
 
 #include "linyaps_box/runtime.h"
 
+#include "linyaps_box/log/macro.h"
+
+#include <algorithm>
+
 linyaps_box::runtime_t::runtime_t(status_directory_manager status_dir_mgr)
     : status_dir_mgr_(std::move(status_dir_mgr))
 {
@@ -24,8 +28,53 @@ auto linyaps_box::runtime_t::containers()
     return containers;
 }
 
+auto linyaps_box::runtime_t::find_container(std::string_view id)
+  -> std::optional<linyaps_box::container_ref>
+{
+    auto status_dir = status_dir_mgr_.find(id);
+    if (!status_dir) {
+        return std::nullopt;
+    }
+
+    return std::make_optional<container_ref>(std::move(*status_dir), std::string(id), true);
+}
+
 auto linyaps_box::runtime_t::create_container(const create_container_options_t &options)
   -> linyaps_box::container
 {
-    return { status_dir_mgr_.get(options.ID), options };
+    auto opts = options;
+    if (opts.config_cache_dir.empty()) {
+        opts.config_cache_dir = status_dir_mgr_.config_cache_dir();
+    }
+
+    return { status_dir_mgr_.get(opts.ID), opts };
+}
+
+auto linyaps_box::runtime_t::idle_pool_members(std::string_view pool)
+  -> std::vector<container_status>
+{
+    std::vector<container_status> members;
+    for (const auto &[id, container] : containers()) {
+        try {
+            auto status = container.status();
+            if (status.pool != pool || status.exec_fifo.empty()) {
+                continue;
+            }
+
+            // a member waits frozen once it is fully set up
+            const auto state = derive_status(status);
+            std::error_code ec;
+            if ((state == runtime_status::CREATED || state == runtime_status::PAUSED)
+                && std::filesystem::exists(status.exec_fifo, ec)) {
+                members.emplace_back(std::move(status));
+            }
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_DEBUG("skip container {}: {}", id, e.what());
+        }
+    }
+
+    std::sort(members.begin(), members.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.created < rhs.created;
+    });
+    return members;
 }
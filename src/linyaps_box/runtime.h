@@ -8,8 +8,11 @@
 #include "linyaps_box/container_ref.h"
 #include "linyaps_box/status_directory_manager.h"
 
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace linyaps_box {
 
@@ -18,8 +21,12 @@ class runtime_t
 public:
     explicit runtime_t(status_directory_manager status_dir_mgr);
     auto containers() -> std::unordered_map<std::string, container_ref>;
+    // Look up one container without listing the others, its monitor is asked first.
+    auto find_container(std::string_view id) -> std::optional<container_ref>;
 
     auto create_container(const create_container_options_t &options) -> container;
+    // The created containers of a warm pool still waiting to be claimed, oldest first.
+    auto idle_pool_members(std::string_view pool) -> std::vector<container_status>;
 
 private:
     status_directory_manager status_dir_mgr_;
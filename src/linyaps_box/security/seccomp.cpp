@@ -0,0 +1,871 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/security/seccomp.h"
+
+#include "linyaps_box/config/cache.h"
+#include "linyaps_box/io/stream.h"
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/os/fs.h"
+#include "linyaps_box/utils/defer.h"
+#include "linyaps_box/utils/utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+
+#include <linux/audit.h>
+#include <linux/seccomp.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef LINYAPS_BOX_ENABLE_SECCOMP
+#  include <seccomp.h>
+#endif
+
+#ifndef SECCOMP_RET_KILL_PROCESS
+#  define SECCOMP_RET_KILL_PROCESS 0x80000000U
+#endif
+
+#ifndef SECCOMP_RET_LOG
+#  define SECCOMP_RET_LOG 0x7ffc0000U
+#endif
+
+#ifndef SECCOMP_FILTER_FLAG_LOG
+#  define SECCOMP_FILTER_FLAG_LOG (1UL << 1)
+#endif
+
+#ifndef SECCOMP_FILTER_FLAG_SPEC_ALLOW
+#  define SECCOMP_FILTER_FLAG_SPEC_ALLOW (1UL << 2)
+#endif
+
+#ifndef AUDIT_ARCH_RISCV64
+#  define AUDIT_ARCH_RISCV64 (243U | __AUDIT_ARCH_64BIT | __AUDIT_ARCH_LE)
+#endif
+
+#ifndef AUDIT_ARCH_LOONGARCH64
+#  define AUDIT_ARCH_LOONGARCH64 (258U | __AUDIT_ARCH_64BIT | __AUDIT_ARCH_LE)
+#endif
+
+namespace linyaps_box::security {
+
+namespace {
+
+using seccomp_t = oci_config::linux_t::seccomp_t;
+using program_t = std::vector<sock_filter>;
+
+constexpr std::uint32_t x32_syscall_bit = 0x40000000U;
+constexpr std::uint32_t max_syscall_nr = std::numeric_limits<std::uint32_t>::max();
+// what libseccomp does for an architecture that is not part of the filter
+constexpr std::uint32_t bad_arch_ret = SECCOMP_RET_KILL_PROCESS;
+
+struct arch_info
+{
+    // seccomp_data.arch of the tasks
+    std::uint32_t audit;
+    // libseccomp token, differs from audit for x32 only
+    std::uint32_t token;
+    // libseccomp only compares the low 32 bits of arguments on 32 bit ABIs
+    bool wide_args;
+};
+
+auto to_arch_info(seccomp_t::arch_t arch) -> arch_info
+{
+    using arch_t = seccomp_t::arch_t;
+
+    constexpr auto narrow = [](std::uint32_t audit) {
+        return arch_info{ audit, audit, false };
+    };
+    constexpr auto wide = [](std::uint32_t audit) {
+        return arch_info{ audit, audit, true };
+    };
+
+    switch (arch) {
+    case arch_t::X86:
+        return narrow(AUDIT_ARCH_I386);
+    case arch_t::X86_64:
+        return wide(AUDIT_ARCH_X86_64);
+    case arch_t::X32:
+        return { AUDIT_ARCH_X86_64, AUDIT_ARCH_X86_64 & ~__AUDIT_ARCH_64BIT, false };
+    case arch_t::ARM:
+        return narrow(AUDIT_ARCH_ARM);
+    case arch_t::AARCH64:
+        return wide(AUDIT_ARCH_AARCH64);
+    case arch_t::MIPS:
+        return narrow(AUDIT_ARCH_MIPS);
+    case arch_t::MIPS64:
+        return wide(AUDIT_ARCH_MIPS64);
+    case arch_t::MIPS64N32:
+        return narrow(AUDIT_ARCH_MIPS64N32);
+    case arch_t::MIPSEL:
+        return narrow(AUDIT_ARCH_MIPSEL);
+    case arch_t::MIPSEL64:
+        return wide(AUDIT_ARCH_MIPSEL64);
+    case arch_t::MIPSEL64N32:
+        return narrow(AUDIT_ARCH_MIPSEL64N32);
+    case arch_t::PPC:
+        return narrow(AUDIT_ARCH_PPC);
+    case arch_t::PPC64:
+        return wide(AUDIT_ARCH_PPC64);
+    case arch_t::PPC64LE:
+        return wide(AUDIT_ARCH_PPC64LE);
+    case arch_t::S390:
+        return narrow(AUDIT_ARCH_S390);
+    case arch_t::S390X:
+        return wide(AUDIT_ARCH_S390X);
+    case arch_t::PARISC:
+        return narrow(AUDIT_ARCH_PARISC);
+    case arch_t::PARISC64:
+        return wide(AUDIT_ARCH_PARISC64);
+    case arch_t::RISCV64:
+        return wide(AUDIT_ARCH_RISCV64);
+    case arch_t::LOONGARCH64:
+        return wide(AUDIT_ARCH_LOONGARCH64);
+    case arch_t::M68K:
+        return narrow(AUDIT_ARCH_M68K);
+    case arch_t::SH:
+        return narrow(AUDIT_ARCH_SHEL);
+    case arch_t::SHEB:
+        return narrow(AUDIT_ARCH_SH);
+    }
+
+    throw std::invalid_argument("unknown seccomp architecture");
+}
+
+auto native_arch() -> seccomp_t::arch_t
+{
+    using arch_t = seccomp_t::arch_t;
+
+#if defined(__x86_64__) && defined(__ILP32__)
+    return arch_t::X32;
+#elif defined(__x86_64__)
+    return arch_t::X86_64;
+#elif defined(__i386__)
+    return arch_t::X86;
+#elif defined(__aarch64__)
+    return arch_t::AARCH64;
+#elif defined(__arm__)
+    return arch_t::ARM;
+#elif defined(__riscv) && __riscv_xlen == 64
+    return arch_t::RISCV64;
+#elif defined(__loongarch64)
+    return arch_t::LOONGARCH64;
+#elif defined(__powerpc64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return arch_t::PPC64LE;
+#elif defined(__powerpc64__)
+    return arch_t::PPC64;
+#elif defined(__powerpc__)
+    return arch_t::PPC;
+#elif defined(__s390x__)
+    return arch_t::S390X;
+#elif defined(__s390__)
+    return arch_t::S390;
+#else
+    throw std::runtime_error("seccomp is not supported on this architecture");
+#endif
+}
+
+auto to_ret(seccomp_t::action_t action, std::optional<uint> errno_ret) -> std::uint32_t
+{
+    using action_t = seccomp_t::action_t;
+
+    // like runc, errnoRet defaults to EPERM
+    const auto data = static_cast<std::uint32_t>(errno_ret.value_or(EPERM)) & SECCOMP_RET_DATA;
+
+    switch (action) {
+    case action_t::ALLOW:
+        return SECCOMP_RET_ALLOW;
+    case action_t::ERRNO:
+        return SECCOMP_RET_ERRNO | data;
+    case action_t::KILL:
+    case action_t::KILL_THREAD:
+        return SECCOMP_RET_KILL_THREAD;
+    case action_t::KILL_PROCESS:
+        return SECCOMP_RET_KILL_PROCESS;
+    case action_t::LOG:
+        return SECCOMP_RET_LOG;
+    case action_t::TRACE:
+        return SECCOMP_RET_TRACE | data;
+    case action_t::TRAP:
+        return SECCOMP_RET_TRAP;
+    case action_t::NOTIFY:
+        // needs a listener fd handed to listenerPath
+        throw std::runtime_error("seccomp SCMP_ACT_NOTIFY is not supported");
+    }
+
+    throw std::invalid_argument("unknown seccomp action");
+}
+
+struct condition
+{
+    uint index;
+    seccomp_t::syscall_t::arg_t::op_t op;
+    std::uint64_t value;
+    std::uint64_t value_two;
+
+    [[nodiscard]] auto operator==(const condition &other) const noexcept -> bool
+    {
+        return index == other.index && op == other.op && value == other.value
+          && value_two == other.value_two;
+    }
+};
+
+struct rule
+{
+    std::uint32_t ret;
+    // all of them must hold, none means the rule always matches
+    std::vector<condition> conditions;
+
+    [[nodiscard]] auto operator==(const rule &other) const noexcept -> bool
+    {
+        return ret == other.ret && conditions == other.conditions;
+    }
+};
+
+// Rules of one syscall in the order of the config, the first match wins and
+// the default action applies if none does.
+using chain = std::vector<rule>;
+
+auto to_rules(const seccomp_t::syscall_t &syscall, std::uint32_t ret) -> std::vector<rule>
+{
+    if (!syscall.args || syscall.args->empty()) {
+        return { rule{ ret, { } } };
+    }
+
+    std::vector<condition> conditions;
+    std::array<unsigned int, 6> counts{ };
+    bool repeated{ false };
+    for (const auto &arg : *syscall.args) {
+        if (UNLIKELY(arg.index >= counts.size())) {
+            throw std::runtime_error(
+              fmt::format("seccomp argument index {} is out of range", arg.index));
+        }
+
+        repeated = repeated || ++counts[arg.index] > 1;
+        conditions.push_back({ arg.index, arg.op, arg.value, arg.value_two.value_or(0) });
+    }
+
+    if (!repeated) {
+        return { rule{ ret, std::move(conditions) } };
+    }
+
+    std::vector<rule> rules;
+    rules.reserve(conditions.size());
+    for (auto &c : conditions) {
+        rules.push_back(rule{ ret, { c } });
+    }
+
+    return rules;
+}
+
+// One block of the program per value of seccomp_data.arch; x86_64 and x32
+// share one and are told apart by the x32 syscall bit.
+struct arch_block
+{
+    std::uint32_t audit;
+    std::vector<arch_info> archs;
+    std::map<std::uint32_t, chain> rules;
+    // numbers that belong to an ABI of this block which is not in the filter
+    std::optional<std::pair<std::uint32_t, std::uint32_t>> bad_range;
+};
+
+auto make_blocks(const seccomp_t &seccomp, const syscall_resolver &resolver)
+  -> std::vector<arch_block>
+{
+    // libseccomp always includes the native architecture, keep it first as it is
+    // the one that matters for speed
+    std::vector<seccomp_t::arch_t> archs{ native_arch() };
+    if (seccomp.architectures) {
+        archs.insert(archs.end(), seccomp.architectures->cbegin(), seccomp.architectures->cend());
+    }
+
+    std::vector<arch_block> blocks;
+    for (auto arch : archs) {
+        const auto info = to_arch_info(arch);
+        auto block = std::find_if(blocks.begin(), blocks.end(), [&info](const auto &b) {
+            return b.audit == info.audit;
+        });
+        if (block == blocks.end()) {
+            block = blocks.insert(blocks.end(), arch_block{ info.audit, { }, { }, std::nullopt });
+        }
+
+        const auto seen = std::any_of(block->archs.cbegin(),
+                                      block->archs.cend(),
+                                      [&info](const auto &a) { return a.token == info.token; });
+        if (!seen) {
+            block->archs.push_back(info);
+        }
+    }
+
+    const auto default_ret = to_ret(seccomp.default_action, seccomp.default_errno_ret);
+
+    for (auto &block : blocks) {
+        if (block.audit == AUDIT_ARCH_X86_64 && block.archs.size() == 1) {
+            // -1 is what a tracer leaves behind for a skipped syscall, libseccomp
+            // leaves it to the default action as well
+            block.bad_range = block.archs.front().token == AUDIT_ARCH_X86_64
+              ? std::make_pair(x32_syscall_bit, max_syscall_nr - 1)
+              : std::make_pair(0U, x32_syscall_bit - 1);
+        }
+
+        if (!seccomp.syscalls) {
+            continue;
+        }
+
+        for (const auto &syscall : *seccomp.syscalls) {
+            const auto ret = to_ret(syscall.action, syscall.errno_ret);
+            if (ret == default_ret) {
+                // runc drops these as well, they cannot change the outcome
+                continue;
+            }
+
+            const auto rules = to_rules(syscall, ret);
+            for (const auto &arch : block.archs) {
+                for (const auto &name : syscall.names) {
+                    auto nr = resolver.resolve(name, arch.token);
+                    if (!nr) {
+                        LINYAPS_BOX_LOG_DEBUG("skip unknown syscall {} for arch {:#x}",
+                                              name,
+                                              arch.token);
+                        continue;
+                    }
+
+                    if (arch.token != arch.audit) {
+                        *nr |= x32_syscall_bit;
+                    }
+
+                    if (block.bad_range && *nr >= block.bad_range->first
+                        && *nr <= block.bad_range->second) {
+                        continue;
+                    }
+
+                    auto &chain = block.rules[*nr];
+                    for (const auto &r : rules) {
+                        // an unconditional rule shadows everything after it
+                        if (!chain.empty() && chain.back().conditions.empty()) {
+                            break;
+                        }
+                        chain.push_back(r);
+                    }
+                }
+            }
+        }
+    }
+
+    return blocks;
+}
+
+auto stmt(std::uint16_t code, std::uint32_t k) noexcept -> sock_filter
+{
+    return sock_filter{ code, 0, 0, k };
+}
+
+auto jump(std::uint16_t code, std::uint32_t k, std::uint8_t jt, std::uint8_t jf) noexcept
+  -> sock_filter
+{
+    return sock_filter{ code, jt, jf, k };
+}
+
+// A conditional jump whose target is only known later.
+struct fixup
+{
+    std::size_t at;
+    bool taken;
+};
+
+void resolve(program_t &code, const std::vector<fixup> &fixups, std::size_t target)
+{
+    for (const auto &f : fixups) {
+        const auto offset = target - f.at - 1;
+        if (UNLIKELY(offset > std::numeric_limits<std::uint8_t>::max())) {
+            throw std::logic_error("seccomp condition jump out of range");
+        }
+
+        (f.taken ? code[f.at].jt : code[f.at].jf) = static_cast<std::uint8_t>(offset);
+    }
+}
+
+auto arg_offset(uint index, bool high, bool little_endian) noexcept -> std::uint32_t
+{
+    const auto base = offsetof(seccomp_data, args) + index * sizeof(std::uint64_t);
+    return static_cast<std::uint32_t>(base + (high == little_endian ? sizeof(std::uint32_t) : 0));
+}
+
+// Falls through when the condition holds, jumps to one of fails otherwise.
+void emit_condition(program_t &code,
+                    const condition &c,
+                    const arch_info &arch,
+                    std::vector<fixup> &fails)
+{
+    using op_t = seccomp_t::syscall_t::arg_t::op_t;
+
+    const bool little_endian = (arch.token & __AUDIT_ARCH_LE) != 0;
+    const auto lo = static_cast<std::uint32_t>(c.value);
+    const auto hi = static_cast<std::uint32_t>(c.value >> 32);
+    std::vector<fixup> passes;
+
+    const auto on_true = [&code](std::vector<fixup> &to) {
+        to.push_back({ code.size() - 1, true });
+    };
+    const auto on_false = [&code](std::vector<fixup> &to) {
+        to.push_back({ code.size() - 1, false });
+    };
+
+    if (arch.wide_args) {
+        code.push_back(stmt(BPF_LD | BPF_W | BPF_ABS, arg_offset(c.index, true, little_endian)));
+        switch (c.op) {
+        case op_t::EQ:
+            code.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, hi, 0, 0));
+            on_false(fails);
+            break;
+        case op_t::NE:
+            code.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, hi, 0, 0));
+            on_false(passes);
+            break;
+        case op_t::GT:
+        case op_t::GE:
+            code.push_back(jump(BPF_JMP | BPF_JGT | BPF_K, hi, 0, 0));
+            on_true(passes);
+            code.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, hi, 0, 0));
+            on_false(fails);
+            break;
+        case op_t::LT:
+        case op_t::LE:
+            code.push_back(jump(BPF_JMP | BPF_JGT | BPF_K, hi, 0, 0));
+            on_true(fails);
+            code.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, hi, 0, 0));
+            on_false(passes);
+            break;
+        case op_t::MASKED_EQ:
+            code.push_back(stmt(BPF_ALU | BPF_AND | BPF_K, hi));
+            code.push_back(
+              jump(BPF_JMP | BPF_JEQ | BPF_K, static_cast<std::uint32_t>(c.value_two >> 32), 0, 0));
+            on_false(fails);
+            break;
+        }
+    }
+
+    code.push_back(stmt(BPF_LD | BPF_W | BPF_ABS, arg_offset(c.index, false, little_endian)));
+    switch (c.op) {
+    case op_t::EQ:
+        code.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, lo, 0, 0));
+        on_false(fails);
+        break;
+    case op_t::NE:
+        code.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, lo, 0, 0));
+        on_true(fails);
+        break;
+    case op_t::GT:
+        code.push_back(jump(BPF_JMP | BPF_JGT | BPF_K, lo, 0, 0));
+        on_false(fails);
+        break;
+    case op_t::GE:
+        code.push_back(jump(BPF_JMP | BPF_JGE | BPF_K, lo, 0, 0));
+        on_false(fails);
+        break;
+    case op_t::LT:
+        code.push_back(jump(BPF_JMP | BPF_JGE | BPF_K, lo, 0, 0));
+        on_true(fails);
+        break;
+    case op_t::LE:
+        code.push_back(jump(BPF_JMP | BPF_JGT | BPF_K, lo, 0, 0));
+        on_true(fails);
+        break;
+    case op_t::MASKED_EQ:
+        code.push_back(stmt(BPF_ALU | BPF_AND | BPF_K, lo));
+        code.push_back(
+          jump(BPF_JMP | BPF_JEQ | BPF_K, static_cast<std::uint32_t>(c.value_two), 0, 0));
+        on_false(fails);
+        break;
+    }
+
+    resolve(code, passes, code.size());
+}
+
+// Every path through the emitted code ends in a return, so it can be placed
+// anywhere without patching.
+auto emit_chain(const chain &rules, const arch_info &arch, std::uint32_t default_ret)
+  -> program_t
+{
+    program_t code;
+    for (const auto &r : rules) {
+        std::vector<fixup> fails;
+        for (const auto &c : r.conditions) {
+            emit_condition(code, c, arch, fails);
+        }
+
+        code.push_back(stmt(BPF_RET | BPF_K, r.ret));
+        resolve(code, fails, code.size());
+    }
+
+    if (rules.empty() || !rules.back().conditions.empty()) {
+        code.push_back(stmt(BPF_RET | BPF_K, default_ret));
+    }
+
+    return code;
+}
+
+// Jump over skip instructions when the comparison is false, falls through
+// otherwise.
+void emit_guard(program_t &code, std::uint16_t op, std::uint32_t k, std::size_t skip)
+{
+    if (skip <= std::numeric_limits<std::uint8_t>::max()) {
+        code.push_back(jump(BPF_JMP | op | BPF_K, k, 0, static_cast<std::uint8_t>(skip)));
+        return;
+    }
+
+    code.push_back(jump(BPF_JMP | op | BPF_K, k, 1, 0));
+    code.push_back(stmt(BPF_JMP | BPF_JA, static_cast<std::uint32_t>(skip)));
+}
+
+void append(program_t &code, const program_t &other)
+{
+    code.insert(code.end(), other.cbegin(), other.cend());
+}
+
+struct segment
+{
+    std::uint32_t first;
+    std::uint32_t last;
+    chain rules;
+};
+
+// Cover all syscall numbers with ranges, neighbours with the same rules are
+// merged so that an allow list of mostly consecutive syscalls becomes a handful
+// of ranges.
+auto make_segments(const arch_block &block) -> std::vector<segment>
+{
+    std::vector<segment> explicit_ranges;
+    for (const auto &[nr, rules] : block.rules) {
+        explicit_ranges.push_back({ nr, nr, rules });
+    }
+    if (block.bad_range) {
+        explicit_ranges.push_back(
+          { block.bad_range->first, block.bad_range->second, { rule{ bad_arch_ret, { } } } });
+        std::sort(explicit_ranges.begin(),
+                  explicit_ranges.end(),
+                  [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    }
+
+    std::vector<segment> segments;
+    const auto push = [&segments](segment s) {
+        if (!segments.empty() && segments.back().rules == s.rules) {
+            segments.back().last = s.last;
+            return;
+        }
+        segments.push_back(std::move(s));
+    };
+
+    std::uint64_t next{ 0 };
+    for (auto &s : explicit_ranges) {
+        if (s.first > next) {
+            push({ static_cast<std::uint32_t>(next), s.first - 1, { } });
+        }
+        next = std::uint64_t{ s.last } + 1;
+        push(std::move(s));
+    }
+    if (next <= max_syscall_nr) {
+        push({ static_cast<std::uint32_t>(next), max_syscall_nr, { } });
+    }
+
+    return segments;
+}
+
+auto emit_tree(const std::vector<segment> &segments,
+               std::size_t first,
+               std::size_t last,
+               const arch_info &arch,
+               std::uint32_t default_ret) -> program_t
+{
+    if (last - first == 1) {
+        return emit_chain(segments[first].rules, arch, default_ret);
+    }
+
+    const auto mid = first + (last - first) / 2;
+    const auto low = emit_tree(segments, first, mid, arch, default_ret);
+    const auto high = emit_tree(segments, mid, last, arch, default_ret);
+
+    program_t code;
+    code.reserve(low.size() + high.size() + 2);
+    if (low.size() <= std::numeric_limits<std::uint8_t>::max()) {
+        code.push_back(jump(BPF_JMP | BPF_JGE | BPF_K,
+                            segments[mid].first,
+                            static_cast<std::uint8_t>(low.size()),
+                            0));
+    } else {
+        code.push_back(jump(BPF_JMP | BPF_JGE | BPF_K, segments[mid].first, 0, 1));
+        code.push_back(stmt(BPF_JMP | BPF_JA, static_cast<std::uint32_t>(low.size())));
+    }
+    append(code, low);
+    append(code, high);
+    return code;
+}
+
+auto emit_linear(const arch_block &block, const arch_info &arch, std::uint32_t default_ret)
+  -> program_t
+{
+    program_t code;
+    if (block.bad_range) {
+        const auto &[first, last] = *block.bad_range;
+        if (first != 0) {
+            code.push_back(jump(BPF_JMP | BPF_JGE | BPF_K, first, 0, 2));
+        }
+        code.push_back(jump(BPF_JMP | BPF_JGT | BPF_K, last, 1, 0));
+        code.push_back(stmt(BPF_RET | BPF_K, bad_arch_ret));
+    }
+
+    for (const auto &[nr, rules] : block.rules) {
+        const auto body = emit_chain(rules, arch, default_ret);
+        emit_guard(code, BPF_JEQ, nr, body.size());
+        append(code, body);
+    }
+
+    code.push_back(stmt(BPF_RET | BPF_K, default_ret));
+    return code;
+}
+
+auto to_filter_flags(const seccomp_t &seccomp) -> unsigned int
+{
+    using flag_t = seccomp_t::flag_t;
+
+    if (!seccomp.flags) {
+        return 0;
+    }
+
+    unsigned int flags{ 0 };
+    const auto has = [&seccomp](flag_t flag) { return (*seccomp.flags & flag) != flag_t::NONE; };
+    if (has(flag_t::TSYNC)) {
+        flags |= SECCOMP_FILTER_FLAG_TSYNC;
+    }
+    if (has(flag_t::LOG)) {
+        flags |= SECCOMP_FILTER_FLAG_LOG;
+    }
+    if (has(flag_t::SPEC_ALLOW)) {
+        flags |= SECCOMP_FILTER_FLAG_SPEC_ALLOW;
+    }
+    // WAIT_KILLABLE_RECV only applies to a notify listener, which is not supported
+
+    return flags;
+}
+
+// "LBSC" in little endian
+constexpr std::uint32_t seccomp_cache_magic = 0x4353424cU;
+// Bump whenever the program generated for the same input changes.
+constexpr std::uint32_t seccomp_cache_version = 1;
+
+struct seccomp_cache_header
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t key_size;
+    std::uint64_t program_size;
+};
+
+static_assert(std::has_unique_object_representations_v<seccomp_cache_header>);
+
+// Everything the program depends on: the seccomp section, the architecture it
+// is compiled for and the syscall tables.
+auto make_cache_key(const seccomp_t &seccomp, const syscall_resolver &resolver)
+  -> std::vector<std::byte>
+{
+    const auto prefix = fmt::format("{:#x}\n{}\n", to_arch_info(native_arch()).audit, resolver.id);
+    auto key = config::serialize(seccomp);
+    key.insert(key.begin(),
+               reinterpret_cast<const std::byte *>(prefix.data()),
+               reinterpret_cast<const std::byte *>(prefix.data() + prefix.size()));
+    return key;
+}
+
+auto load(const std::filesystem::path &cache, const std::vector<std::byte> &key)
+  -> std::optional<seccomp_filter>
+{
+    auto fd = os::open(cache, { os::sys::open_flag::cloexec, os::sys::access_mode::read_only });
+    if (!fd) {
+        return std::nullopt;
+    }
+
+    utils::uninit_vector<std::byte> buf;
+    std::ignore = os::throw_if_error(io::read_to_end(fd->ref(), buf));
+
+    seccomp_cache_header header{ };
+    if (buf.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+
+    std::memcpy(&header, buf.data(), sizeof(header));
+    const auto *payload = buf.data() + sizeof(header);
+    const auto payload_size = buf.size() - sizeof(header);
+    if (header.magic != seccomp_cache_magic || header.version != seccomp_cache_version
+        || header.key_size != key.size() || header.program_size > BPF_MAXINSNS
+        || payload_size != key.size() + header.program_size * sizeof(sock_filter)
+        || std::memcmp(payload, key.data(), key.size()) != 0) {
+        return std::nullopt;
+    }
+
+    seccomp_filter filter;
+    filter.flags = header.flags;
+    filter.program.resize(header.program_size);
+    std::memcpy(filter.program.data(),
+                payload + key.size(),
+                header.program_size * sizeof(sock_filter));
+    return filter;
+}
+
+auto store(const std::filesystem::path &cache,
+           const std::vector<std::byte> &key,
+           const seccomp_filter &filter) -> void
+{
+    const seccomp_cache_header header{ seccomp_cache_magic,
+                                       seccomp_cache_version,
+                                       filter.flags,
+                                       static_cast<std::uint32_t>(key.size()),
+                                       filter.program.size() };
+
+    std::filesystem::create_directories(cache.parent_path());
+
+    // write to a unique temporary file then rename over the old cache, readers
+    // never observe a partially written cache
+    auto temp = cache;
+    temp += ".tmp-" + utils::gen_random_string(6);
+    auto fd = os::throw_if_error(
+      os::open(temp,
+               { os::sys::open_flag::create | os::sys::open_flag::exclusive
+                   | os::sys::open_flag::cloexec | os::sys::open_flag::no_follow,
+                 os::sys::access_mode::write_only },
+               std::filesystem::perms::owner_read | std::filesystem::perms::owner_write));
+    auto cleanup = utils::make_errdefer([&temp]() noexcept {
+        std::error_code ec;
+        std::filesystem::remove(temp, ec);
+    });
+
+    os::throw_if_error(io::write_all(
+      fd.ref(),
+      utils::span<const std::byte>{ reinterpret_cast<const std::byte *>(&header),
+                                    sizeof(header) }));
+    os::throw_if_error(io::write_all(fd.ref(), key));
+    os::throw_if_error(io::write_all(
+      fd.ref(),
+      utils::span<const std::byte>{ reinterpret_cast<const std::byte *>(filter.program.data()),
+                                    filter.program.size() * sizeof(sock_filter) }));
+    std::filesystem::rename(temp, cache);
+}
+
+} // namespace
+
+auto default_syscall_resolver() -> syscall_resolver
+{
+#ifdef LINYAPS_BOX_ENABLE_SECCOMP
+    const auto *version = seccomp_version();
+    return { fmt::format("libseccomp {}.{}.{}", version->major, version->minor, version->micro),
+             [](std::string_view name, std::uint32_t arch) -> std::optional<std::uint32_t> {
+                 const std::string syscall{ name };
+                 // negative numbers are unknown syscalls or libseccomp pseudo syscalls
+                 const auto nr = seccomp_syscall_resolve_name_arch(arch, syscall.c_str());
+                 if (nr < 0) {
+                     return std::nullopt;
+                 }
+
+                 return static_cast<std::uint32_t>(nr);
+             } };
+#else
+    throw std::runtime_error("seccomp support is not compiled in");
+#endif
+}
+
+auto compile_seccomp(const seccomp_t &seccomp,
+                     const syscall_resolver &resolver,
+                     seccomp_layout layout) -> seccomp_filter
+{
+    const auto default_ret = to_ret(seccomp.default_action, seccomp.default_errno_ret);
+    const auto blocks = make_blocks(seccomp, resolver);
+
+    program_t code;
+    code.push_back(stmt(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, arch)));
+    for (const auto &block : blocks) {
+        // the arguments of both x86_64 ABIs are compared the same way
+        const auto &arch = block.archs.front();
+
+        program_t body;
+        body.push_back(stmt(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)));
+        if (layout == seccomp_layout::tree) {
+            const auto segments = make_segments(block);
+            append(body, emit_tree(segments, 0, segments.size(), arch, default_ret));
+        } else {
+            append(body, emit_linear(block, arch, default_ret));
+        }
+
+        emit_guard(code, BPF_JEQ, block.audit, body.size());
+        append(code, body);
+    }
+    code.push_back(stmt(BPF_RET | BPF_K, bad_arch_ret));
+
+    if (UNLIKELY(code.size() > BPF_MAXINSNS)) {
+        throw std::runtime_error(
+          fmt::format("seccomp program has {} instructions, the kernel allows {}",
+                      code.size(),
+                      BPF_MAXINSNS));
+    }
+
+    LINYAPS_BOX_LOG_DEBUG("compiled seccomp program of {} instructions", code.size());
+    return { std::move(code), to_filter_flags(seccomp) };
+}
+
+auto load_or_compile_seccomp(const seccomp_t &seccomp,
+                             const syscall_resolver &resolver,
+                             const std::filesystem::path &cache_dir,
+                             std::size_t max_entries) -> seccomp_filter
+{
+    if (cache_dir.empty()) {
+        return compile_seccomp(seccomp, resolver);
+    }
+
+    const auto key = make_cache_key(seccomp, resolver);
+    // the name only spreads the programs, the key itself is compared on load
+    const auto cache = cache_dir
+      / fmt::format("seccomp-{:016x}.bpf",
+                    std::hash<std::string_view>{ }(
+                      std::string_view{ reinterpret_cast<const char *>(key.data()), key.size() }));
+
+    try {
+        if (auto filter = load(cache, key); filter) {
+            LINYAPS_BOX_LOG_DEBUG("load seccomp program from cache {}", cache);
+            return std::move(filter).value();
+        }
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_DEBUG("ignore broken seccomp cache {}: {}", cache, e.what());
+    }
+
+    auto filter = compile_seccomp(seccomp, resolver);
+
+    try {
+        store(cache, key, filter);
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_DEBUG("failed to update seccomp cache {}: {}", cache, e.what());
+    }
+
+    if (max_entries != 0) {
+        config::prune_cache_dir(cache_dir, max_entries);
+    }
+
+    return filter;
+}
+
+void install_seccomp(const seccomp_filter &filter)
+{
+    sock_fprog prog{ static_cast<unsigned short>(filter.program.size()),
+                     const_cast<sock_filter *>(filter.program.data()) };
+
+    if (UNLIKELY(::syscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, filter.flags, &prog) < 0)) {
+        throw std::system_error(errno, std::system_category(), "seccomp");
+    }
+}
+
+} // namespace linyaps_box::security
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <linux/filter.h>
+
+namespace linyaps_box::security {
+
+struct syscall_resolver
+{
+    // Identifies the syscall tables behind resolve, part of the key of cached
+    // programs.
+    std::string id;
+    // The number of a syscall on the architecture with the given libseccomp
+    // token (the AUDIT_ARCH_* value, except for x32), nullopt if there is none.
+    std::function<std::optional<std::uint32_t>(std::string_view name, std::uint32_t arch)>
+      resolve;
+};
+
+// The syscall tables of libseccomp. Throws if ll-box is built without seccomp
+// support.
+[[nodiscard]] auto default_syscall_resolver() -> syscall_resolver;
+
+enum class seccomp_layout : std::uint8_t {
+    // Binary search over the ranges of syscall numbers sharing the same rules.
+    tree,
+    // One comparison per syscall in ascending order, the shape of an
+    // unoptimized libseccomp filter. Only kept for comparison.
+    linear,
+};
+
+struct seccomp_filter
+{
+    std::vector<sock_filter> program;
+    // SECCOMP_FILTER_FLAG_*
+    unsigned int flags{ 0 };
+};
+
+// Compile linux.seccomp into a classic BPF program covering the native
+// architecture and linux.seccomp.architectures. Syscalls that an architecture
+// does not know are skipped, like runc does. Arguments follow runc as well:
+// the conditions of one rule are ANDed, unless one argument is compared more
+// than once, then every condition becomes a rule of its own.
+[[nodiscard]] auto compile_seccomp(const oci_config::linux_t::seccomp_t &seccomp,
+                                   const syscall_resolver &resolver,
+                                   seccomp_layout layout = seccomp_layout::tree)
+  -> seccomp_filter;
+
+// Like compile_seccomp, but reuses the program that an earlier launch compiled
+// from the very same seccomp section and stored in cache_dir. An empty
+// cache_dir disables the cache, cache failures only fall back to compiling.
+// A non-zero max_entries prunes a shared cache_dir after a new program is stored,
+// see config::prune_cache_dir.
+[[nodiscard]] auto load_or_compile_seccomp(const oci_config::linux_t::seccomp_t &seccomp,
+                                           const syscall_resolver &resolver,
+                                           const std::filesystem::path &cache_dir,
+                                           std::size_t max_entries = 0) -> seccomp_filter;
+
+// Install the filter on the calling thread, which needs no_new_privs or
+// CAP_SYS_ADMIN.
+void install_seccomp(const seccomp_filter &filter);
+
+} // namespace linyaps_box::security
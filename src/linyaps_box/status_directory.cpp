@@ -133,3 +133,18 @@ auto linyaps_box::status_directory::config() const -> std::filesystem::path
 {
     return path_ / "config.json";
 }
+
+auto linyaps_box::status_directory::config_cache() const -> std::filesystem::path
+{
+    return path_ / "config.bin";
+}
+
+auto linyaps_box::status_directory::exec_fifo() const -> std::filesystem::path
+{
+    return path_ / "exec.fifo";
+}
+
+auto linyaps_box::status_directory::control_socket() const -> std::filesystem::path
+{
+    return path_ / "control.sock";
+}
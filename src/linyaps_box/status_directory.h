@@ -23,6 +23,10 @@ public:
     auto write_config(std::string_view config) const -> void;
     auto save_config(const std::filesystem::path &src) const -> void;
     [[nodiscard]] auto config() const -> std::filesystem::path;
+    [[nodiscard]] auto config_cache() const -> std::filesystem::path;
+    [[nodiscard]] auto exec_fifo() const -> std::filesystem::path;
+    // Served by the monitor of a running container.
+    [[nodiscard]] auto control_socket() const -> std::filesystem::path;
 
 private:
     std::filesystem::path path_;
@@ -73,4 +73,20 @@ auto status_directory_manager::get(std::string_view id) const -> status_director
     return status_directory(root_ / id);
 }
 
+auto status_directory_manager::find(std::string_view id) const -> std::optional<status_directory>
+{
+    validate_id(id);
+    auto path = root_ / id;
+    if (!std::filesystem::exists(path / "status.json")) {
+        return std::nullopt;
+    }
+
+    return status_directory(std::move(path));
+}
+
+auto status_directory_manager::config_cache_dir() const -> std::filesystem::path
+{
+    return root_ / ".config-cache";
+}
+
 } // namespace linyaps_box
@@ -7,6 +7,7 @@
 #include "linyaps_box/status_directory.h"
 
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -20,6 +21,10 @@ public:
 
     [[nodiscard]] auto list() const -> std::vector<std::string>;
     [[nodiscard]] auto get(std::string_view id) const -> status_directory;
+    // Like get, but nullopt instead of creating the directory of an unknown container.
+    [[nodiscard]] auto find(std::string_view id) const -> std::optional<status_directory>;
+    // Shared by all containers, never listed because IDs cannot start with '.'.
+    [[nodiscard]] auto config_cache_dir() const -> std::filesystem::path;
 
 private:
     static auto validate_id(std::string_view id) -> void;
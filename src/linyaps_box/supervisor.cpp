@@ -0,0 +1,844 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/supervisor.h"
+
+#include "linyaps_box/config/cache.h"
+#include "linyaps_box/container.h"
+#include "linyaps_box/impl/cgroupfs_manager.h"
+#include "linyaps_box/log/macro.h"
+#include "linyaps_box/os/process.h"
+#include "linyaps_box/os/tty.h"
+#include "linyaps_box/runtime.h"
+#include "linyaps_box/utils/defer.h"
+#include "linyaps_box/utils/session.h"
+#include "linyaps_box/utils/signal.h"
+#include "linyaps_box/utils/utils.h"
+
+#include <sys/signalfd.h>
+
+#include <algorithm>
+#include <array>
+#include <csignal>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace linyaps_box {
+
+namespace {
+
+auto window_to_json(const struct winsize &size) -> nlohmann::json
+{
+    return { { "rows", size.ws_row }, { "cols", size.ws_col } };
+}
+
+auto window_from_json(const nlohmann::json &j) -> struct winsize
+{
+    struct winsize size{ };
+    size.ws_row = j.at("rows").get<unsigned short>();
+    size.ws_col = j.at("cols").get<unsigned short>();
+    return size;
+}
+
+// Runs in the worker forked for a request: the passed fds become its stdio and
+// preserved fds, the way `ll-box run` would have had them.
+auto launch(const supervised_run_request &request,
+            std::vector<utils::file_descriptor> fds,
+            infra::unix_socket handoff,
+            const status_directory_manager &status_dir_mgr,
+            cgroup_manager_t manager) -> int
+{
+    // move them out of the way first, one may sit on the number of another
+    const auto count = static_cast<int>(fds.size());
+    for (auto &fd : fds) {
+        const auto moved = ::fcntl(fd.get(), F_DUPFD_CLOEXEC, count);
+        if (moved < 0) {
+            throw std::system_error(errno, std::system_category(), "fcntl F_DUPFD_CLOEXEC");
+        }
+        fd = utils::file_descriptor{ moved };
+    }
+    for (auto i = 0; i < count; ++i) {
+        fds[i].duplicate_to(i, 0);
+    }
+    fds.clear();
+
+    utils::setsid();
+
+    runtime_t runtime(status_dir_mgr);
+    auto container = runtime.create_container(
+      create_container_options_t{ manager, request.id, request.bundle, request.config, { } });
+
+    const auto &cfg = container.get_config();
+    if (UNLIKELY(!cfg.process || !cfg.root)) {
+        throw std::runtime_error("'process' and 'root' are required for run a container");
+    }
+
+    run_container_options_t run_options;
+    run_options.preserve_fds = request.preserve_fds;
+    run_options.startup_timing = request.startup_timing;
+    run_options.handoff = std::move(handoff);
+
+    const auto terminal = cfg.process->terminal.value_or(false);
+    if (terminal && request.console_socket) {
+        run_options.console_socket = infra::unix_socket::connect(*request.console_socket);
+    }
+
+    if (terminal && request.detach && !request.console_socket) {
+        throw std::runtime_error("--console-socket is required for a container with terminal");
+    }
+
+    return container.run(std::move(run_options));
+}
+
+// What the monitor of container::run does after the container process exited.
+void remove_container(const status_directory_manager &status_dir_mgr,
+                      const std::string &id) noexcept
+{
+    try {
+        const auto dir = status_dir_mgr.get(id);
+        const container_ref ref{ dir, id };
+        const auto state = ref.status();
+
+        try {
+            run_poststop_hooks(config::parse_cached(dir.config(), dir.config_cache()), state);
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_ERROR("failed to run poststop hooks of {}: {}", id, e.what());
+        }
+
+        try {
+            destroy_cgroup_v2(state.cgroup_path);
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_WARN("failed to destroy cgroup: {}", e.what());
+        }
+
+        dir.remove();
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_ERROR("failed to remove container {}: {}", id, e.what());
+    }
+}
+
+} // namespace
+
+auto send_supervisor_message(const infra::unix_socket &socket,
+                             const nlohmann::json &body,
+                             utils::span<const utils::file_descriptor_ref> fds)
+  -> os::Result<std::size_t>
+{
+    const auto data = body.dump();
+    return socket.send_data_with_fds(
+      { reinterpret_cast<const std::byte *>(data.data()), data.size() },
+      fds);
+}
+
+auto recv_supervisor_message(const infra::unix_socket &socket, std::vector<std::byte> &buffer)
+  -> os::Result<supervisor_message>
+{
+    buffer.resize(max_supervisor_message_size);
+    auto ret = socket.recv_data_with_fds(buffer);
+    if (!ret) {
+        return os::unexpected(ret.error());
+    }
+
+    supervisor_message msg;
+    msg.fds = std::move(ret->fds);
+    if (ret->bytes != 0) {
+        const auto *data = reinterpret_cast<const char *>(buffer.data());
+        msg.body = nlohmann::json::parse(data, data + ret->bytes);
+    }
+
+    return msg;
+}
+
+auto workers_first(std::vector<child_exit> exits, const std::function<bool(pid_t)> &is_worker)
+  -> std::vector<child_exit>
+{
+    std::stable_partition(exits.begin(), exits.end(), [&is_worker](const child_exit &e) {
+        return is_worker(e.pid);
+    });
+    return exits;
+}
+
+auto to_json(nlohmann::json &j, const supervised_run_request &request) -> void
+{
+    j = nlohmann::json{ { "id", request.id },
+                        { "bundle", request.bundle.string() },
+                        { "config", request.config.string() },
+                        { "preserve_fds", request.preserve_fds },
+                        { "detach", request.detach } };
+    if (request.console_socket) {
+        j["console_socket"] = request.console_socket->string();
+    }
+    if (request.startup_timing) {
+        j["startup_timing"] = request.startup_timing->string();
+    }
+}
+
+auto from_json(const nlohmann::json &j, supervised_run_request &request) -> void
+{
+    j.at("id").get_to(request.id);
+    request.bundle = j.at("bundle").get<std::string>();
+    request.config = j.at("config").get<std::string>();
+    j.at("preserve_fds").get_to(request.preserve_fds);
+    j.at("detach").get_to(request.detach);
+    if (auto it = j.find("console_socket"); it != j.end()) {
+        request.console_socket = it->get<std::string>();
+    }
+    if (auto it = j.find("startup_timing"); it != j.end()) {
+        request.startup_timing = it->get<std::string>();
+    }
+}
+
+auto run_in_supervisor(const std::filesystem::path &socket, const supervised_run_request &request)
+  -> int
+{
+    if (request.preserve_fds < 0
+        || static_cast<std::size_t>(request.preserve_fds) + 3 > infra::kMaxScmFds) {
+        throw std::runtime_error(
+          fmt::format("at most {} fds can be preserved with a supervisor", infra::kMaxScmFds - 3));
+    }
+
+    auto conn = infra::unix_socket::connect(socket);
+
+    sigset_t set;
+    utils::sigfillset(set);
+    utils::sigprocmask(SIG_BLOCK, set, nullptr);
+    auto signal_fd = utils::create_signalfd(set);
+
+    std::vector<utils::file_descriptor> stdio;
+    std::vector<utils::file_descriptor_ref> fds;
+    stdio.reserve(request.preserve_fds + 3);
+    for (auto fd = 0; fd < request.preserve_fds + 3; ++fd) {
+        fds.push_back(stdio.emplace_back(fd, false).ref());
+    }
+    os::throw_if_error(send_supervisor_message(conn, request, fds),
+                       "failed to send request to supervisor");
+
+    // the supervisor turns them non-blocking to forward a terminal
+    const auto in_flags = stdio[STDIN_FILENO].flags();
+    const auto out_flags = stdio[STDOUT_FILENO].flags();
+    auto restore = utils::make_defer([&stdio, in_flags, out_flags]() noexcept {
+        try {
+            stdio[STDIN_FILENO].set_flags(in_flags);
+            stdio[STDOUT_FILENO].set_flags(out_flags);
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_ERROR("failed to restore stdin/stdout flags: {}", e.what());
+        }
+    });
+
+    std::optional<terminal_slave> host_tty;
+    auto send_window = [&conn, &host_tty]() {
+        if (host_tty) {
+            const nlohmann::json window{ { "window", window_to_json(host_tty->get_size()) } };
+            std::ignore = send_supervisor_message(conn, window);
+        }
+    };
+
+    std::vector<std::byte> buffer;
+    std::array<struct pollfd, 2> pfds{ { { conn.fd().get(), POLLIN, 0 },
+                                         { signal_fd.get(), POLLIN, 0 } } };
+    while (true) {
+        if (::poll(pfds.data(), pfds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::system_category(), "poll");
+        }
+
+        if (pfds[1].revents != 0) {
+            while (true) {
+                struct signalfd_siginfo info{ };
+                auto [status, bytes] = signal_fd.read(info);
+                if (status != utils::IOStatus::Success) {
+                    break;
+                }
+
+                switch (info.ssi_signo) {
+                case SIGCHLD:
+                    break;
+                case SIGWINCH:
+                    send_window();
+                    break;
+                default:
+                    std::ignore =
+                      send_supervisor_message(conn, { { "signal", info.ssi_signo } });
+                    break;
+                }
+            }
+        }
+
+        if (pfds[0].revents == 0) {
+            continue;
+        }
+
+        auto msg = os::throw_if_error(recv_supervisor_message(conn, buffer));
+        if (msg.body.is_null()) {
+            throw std::runtime_error("the supervisor closed the connection");
+        }
+
+        const auto event = msg.body.at("event").get<std::string>();
+        if (event == "started") {
+            if (request.detach) {
+                return EXIT_SUCCESS;
+            }
+
+            if (msg.body.value("terminal", false)
+                && os::isatty(stdio[STDIN_FILENO]).value_or(false)) {
+                host_tty.emplace(utils::file_descriptor{ STDIN_FILENO, false });
+                host_tty->set_raw();
+                send_window();
+            }
+        } else if (event == "exited") {
+            return msg.body.at("exit_code").get<int>();
+        } else if (event == "failed") {
+            throw std::runtime_error(msg.body.value("error", "failed to run container"));
+        }
+    }
+}
+
+supervisor::supervisor(std::filesystem::path root, cgroup_manager_t manager)
+    : status_dir_mgr_(std::move(root))
+    , manager_(manager)
+{
+}
+
+supervisor::~supervisor() noexcept = default;
+
+auto supervisor::serve(const std::filesystem::path &socket) -> int
+{
+    os::throw_if_error(os::set_child_subreaper(true));
+
+    sigset_t set;
+    utils::sigfillset(set);
+    utils::sigprocmask(SIG_BLOCK, set, nullptr);
+    signal_fd = utils::create_signalfd(set);
+    if (!epoll.add(signal_fd, EPOLLIN)) {
+        throw std::runtime_error("failed to add signalfd to epoll");
+    }
+
+    listener = infra::unix_socket::listen(socket);
+    auto unlink_socket = utils::make_defer([&socket]() noexcept {
+        std::error_code ec;
+        std::filesystem::remove(socket, ec);
+    });
+    listener->fd().set_nonblock(true);
+    if (!epoll.add(listener->fd(), EPOLLIN)) {
+        throw std::runtime_error("failed to add listening socket to epoll");
+    }
+
+    LINYAPS_BOX_LOG_INFO("Supervisor listening on {}", socket);
+
+    // forwarders that stopped on their quota instead of blocking
+    std::unordered_set<supervised_container *> busy;
+    while (!stopping || !containers.empty()) {
+        const auto events = epoll.wait(busy.empty() && touched.empty() ? -1 : 0);
+        touched.insert(busy.begin(), busy.end());
+        busy.clear();
+
+        // Entries only go away at the end of a round, the pointers stay valid.
+        for (const auto &ev : events) {
+            const auto fd = ev.data.fd;
+            if (fd == signal_fd.get()) {
+                handle_signals();
+                continue;
+            }
+
+            if (listener && fd == listener->fd().get()) {
+                accept_clients();
+                continue;
+            }
+
+            auto it = by_fd.find(fd);
+            if (it == by_fd.end()) {
+                continue;
+            }
+
+            auto &entry = *it->second;
+            if (entry.client && fd == entry.client->fd().get()) {
+                handle_client(entry);
+                continue;
+            }
+
+            if ((ev.events & (EPOLLERR | EPOLLHUP)) != 0) {
+                for (auto *fwd : { &entry.in_fwd, &entry.out_fwd }) {
+                    if (!*fwd) {
+                        continue;
+                    }
+                    if ((*fwd)->src().get() == fd) {
+                        (*fwd)->mark_src_eof();
+                    }
+                    if ((*fwd)->dst().get() == fd) {
+                        (*fwd)->mark_dst_failed();
+                    }
+                }
+            }
+            touched.insert(&entry);
+        }
+
+        // Exits are torn down together after the events of the round.
+        bool finished{ false };
+        for (auto *entry : touched) {
+            if (drive(*entry)) {
+                busy.insert(entry);
+            }
+
+            if (entry->exit_code && !entry->out_fwd && entry->cleaner < 0 && !entry->done) {
+                finish(*entry);
+            }
+            finished = finished || entry->done;
+        }
+        touched.clear();
+
+        if (!finished) {
+            continue;
+        }
+
+        for (auto it = containers.begin(); it != containers.end();) {
+            if (!it->second->done) {
+                ++it;
+                continue;
+            }
+
+            busy.erase(it->second.get());
+            forget(*it->second);
+            it = containers.erase(it);
+        }
+
+        // hooks run here when no cleanup worker could be forked may have waited
+        // for SIGCHLD of their own and swallowed ours
+        reap_children();
+    }
+
+    return EXIT_SUCCESS;
+}
+
+auto supervisor::accept_clients() -> void
+{
+    while (auto conn = listener->accept()) {
+        // a request runs a bundle with our credentials
+        if (!conn->peer_is_trusted()) {
+            LINYAPS_BOX_LOG_WARN("reject supervisor connection of another user");
+            continue;
+        }
+
+        auto entry = std::make_unique<supervised_container>();
+        conn->fd().set_nonblock(true);
+        if (!epoll.add(conn->fd(), EPOLLIN)) {
+            throw std::runtime_error("failed to add client to epoll");
+        }
+
+        by_fd.emplace(conn->fd().get(), entry.get());
+        entry->client = std::move(conn);
+        containers.emplace(entry.get(), std::move(entry));
+    }
+}
+
+auto supervisor::handle_signals() -> void
+{
+    while (true) {
+        struct signalfd_siginfo info{ };
+        auto [status, bytes] = signal_fd.read(info);
+        if (status == utils::IOStatus::TryAgain) {
+            break;
+        }
+
+        if (status != utils::IOStatus::Success) {
+            throw std::runtime_error("failed to read signalfd");
+        }
+
+        switch (info.ssi_signo) {
+        case SIGCHLD: {
+            reap_children();
+        } break;
+        case SIGINT:
+        case SIGTERM: {
+            stop();
+        } break;
+        default:
+            break;
+        }
+    }
+}
+
+auto supervisor::handle_client(supervised_container &entry) -> void
+{
+    while (entry.client && !entry.done) {
+        auto ret = recv_supervisor_message(*entry.client, buffer);
+        if (!ret) {
+            if (ret.error() == std::errc::resource_unavailable_try_again) {
+                return;
+            }
+
+            LINYAPS_BOX_LOG_WARN("failed to receive from client: {}", ret.error().message());
+            ret = supervisor_message{ };
+        }
+
+        auto &msg = *ret;
+        if (msg.body.is_null()) {
+            // a started container keeps running, there is only nobody to tell
+            by_fd.erase(entry.client->fd().get());
+            epoll.remove(entry.client->fd());
+            entry.client.reset();
+            if (!entry.requested) {
+                entry.done = true;
+                touched.insert(&entry);
+            }
+            return;
+        }
+
+        try {
+            if (!entry.requested) {
+                entry.requested = true;
+                handle_request(entry, std::move(msg.body), std::move(msg.fds));
+            } else if (auto it = msg.body.find("signal"); it != msg.body.end()) {
+                forward_signal(entry, it->get<int>());
+            } else if (auto it = msg.body.find("window"); it != msg.body.end()) {
+                resize(entry, window_from_json(*it));
+            }
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_ERROR("bad request: {}", e.what());
+            if (entry.worker < 0 && entry.pid < 0) {
+                notify(entry, { { "event", "failed" }, { "error", e.what() } });
+                entry.done = true;
+                touched.insert(&entry);
+            }
+        }
+    }
+}
+
+auto supervisor::handle_request(supervised_container &entry,
+                                nlohmann::json body,
+                                std::vector<utils::file_descriptor> fds) -> void
+{
+    auto request = body.get<supervised_run_request>();
+    if (stopping) {
+        throw std::runtime_error("the supervisor is shutting down");
+    }
+
+    if (request.preserve_fds < 0
+        || fds.size() != static_cast<std::size_t>(request.preserve_fds) + 3) {
+        throw std::runtime_error("expected stdio and preserved fds with the request");
+    }
+
+    LINYAPS_BOX_LOG_DEBUG("Run container {} from bundle {}", request.id, request.bundle);
+
+    auto [local, remote] = infra::unix_socket::create_pair(os::sys::socket_type::seqpacket,
+                                                           os::sys::socket_flag::cloexec);
+    auto worker = ::fork();
+    if (worker < 0) {
+        throw std::system_error(errno, std::system_category(), "fork");
+    }
+
+    if (worker == 0) {
+        int ret{ EXIT_FAILURE };
+        try {
+            local.close();
+            ret = launch(request, std::move(fds), std::move(remote), status_dir_mgr_, manager_);
+        } catch (const std::exception &e) {
+            LINYAPS_BOX_LOG_ERROR("failed to run container {}: {}", request.id, e.what());
+        }
+        _exit(ret);
+    }
+
+    // the handoff is sent before the worker exits, it is read once it did
+    local.fd().set_nonblock(true);
+    entry.handoff = std::move(local);
+    entry.id = std::move(request.id);
+    entry.detach = request.detach;
+    entry.worker = worker;
+    entry.in = std::move(fds[STDIN_FILENO]);
+    entry.out = std::move(fds[STDOUT_FILENO]);
+    by_pid.emplace(worker, &entry);
+}
+
+auto supervisor::reap_children() -> void
+{
+    std::vector<child_exit> exits;
+    while (true) {
+        int status{ 0 };
+        auto ret = os::waitpid(-1, status, WNOHANG);
+        if (!ret || *ret == 0) {
+            break;
+        }
+
+        exits.push_back({ *ret, status });
+    }
+
+    // the containers of a batch are only known once their workers are handled
+    exits = workers_first(std::move(exits), [this](pid_t pid) {
+        auto it = by_pid.find(pid);
+        return it != by_pid.end() && it->second->worker == pid;
+    });
+
+    for (const auto &[pid, status] : exits) {
+        auto it = by_pid.find(pid);
+        if (it == by_pid.end()) {
+            // processes left behind by containers end up here as well
+            continue;
+        }
+
+        auto &entry = *it->second;
+        if (pid == entry.worker) {
+            worker_exited(entry);
+        } else if (pid == entry.pid) {
+            container_exited(entry, os::get_exit_code(status).value_or(EXIT_FAILURE));
+        } else if (pid == entry.cleaner) {
+            cleaned(entry);
+            touched.insert(&entry);
+        }
+    }
+}
+
+auto supervisor::worker_exited(supervised_container &entry) -> void
+{
+    by_pid.erase(entry.worker);
+    entry.worker = -1;
+    touched.insert(&entry);
+
+    std::optional<supervisor_message> handed;
+    try {
+        auto ret = recv_supervisor_message(*entry.handoff, buffer);
+        if (ret && !ret->body.is_null()) {
+            handed = std::move(ret).value();
+        }
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_ERROR("bad handoff of container {}: {}", entry.id, e.what());
+    }
+    entry.handoff.reset();
+
+    if (!handed) {
+        // the worker cleaned up after itself and logged why to the caller
+        notify(entry,
+               { { "event", "failed" },
+                 { "error", fmt::format("failed to run container {}", entry.id) } });
+        entry.done = true;
+        return;
+    }
+
+    try {
+        adopt(entry, handed->body.at("pid").get<pid_t>(), std::move(handed->fds));
+    } catch (const std::exception &e) {
+        LINYAPS_BOX_LOG_ERROR("failed to adopt container {}: {}", entry.id, e.what());
+        if (entry.pid > 0) {
+            ::kill(entry.pid, SIGKILL);
+        }
+    }
+}
+
+auto supervisor::adopt(supervised_container &entry,
+                       pid_t pid,
+                       std::vector<utils::file_descriptor> fds) -> void
+{
+    LINYAPS_BOX_LOG_DEBUG("Adopt container {} with process {}", entry.id, pid);
+
+    entry.pid = pid;
+    by_pid.emplace(pid, &entry);
+
+    if (!fds.empty()) {
+        entry.master.emplace(std::move(fds.front()));
+    }
+
+    notify(entry,
+           { { "event", "started" }, { "pid", pid }, { "terminal", entry.master.has_value() } });
+
+    if (stopping) {
+        ::kill(pid, SIGKILL);
+    }
+
+    for (const auto sig : std::exchange(entry.pending_signals, { })) {
+        forward_signal(entry, sig);
+    }
+
+    if (entry.master && !entry.detach) {
+        enable_io_forwarding(entry);
+        if (entry.window) {
+            entry.master->resize(*entry.window);
+        }
+    } else {
+        entry.master.reset();
+        entry.in.close();
+        entry.out.close();
+    }
+}
+
+auto supervisor::container_exited(supervised_container &entry, int exit_code) -> void
+{
+    LINYAPS_BOX_LOG_DEBUG("Container {} exited with {}", entry.id, exit_code);
+
+    by_pid.erase(entry.pid);
+    entry.exit_code = exit_code;
+    touched.insert(&entry);
+
+    // let the output drain, nothing is read from the terminal any more
+    if (entry.in_fwd) {
+        entry.in_fwd->mark_dst_failed();
+    }
+    if (entry.out_fwd) {
+        entry.out_fwd->mark_src_eof();
+    }
+}
+
+auto supervisor::forward_signal(supervised_container &entry, int sig) -> void
+{
+    if (entry.exit_code) {
+        return;
+    }
+
+    // the container process is our unreaped child, its pid can not be reused
+    if (entry.pid > 0) {
+        if (::kill(entry.pid, sig) != 0 && errno != ESRCH) {
+            LINYAPS_BOX_LOG_WARN("failed to send signal {} to container {}", sig, entry.id);
+        }
+        return;
+    }
+
+    entry.pending_signals.push_back(sig);
+}
+
+auto supervisor::resize(supervised_container &entry, struct winsize size) -> void
+{
+    entry.window = size;
+    if (entry.master) {
+        entry.master->resize(size);
+    }
+}
+
+auto supervisor::enable_io_forwarding(supervised_container &entry) -> void
+{
+    entry.master->fd().set_nonblock(true);
+    entry.master_out = entry.master->fd().duplicate();
+    entry.master_out->set_nonblock(true);
+    entry.in.set_nonblock(true);
+    entry.out.set_nonblock(true);
+
+    // see container_monitor::enable_io_forwarding
+    constexpr auto buffer_size{ 8 * 1024 };
+    entry.in_fwd.emplace(epoll, buffer_size);
+    entry.in_fwd->set_src(entry.in);
+    entry.in_fwd->set_dst(entry.master->fd());
+
+    entry.out_fwd.emplace(epoll, buffer_size);
+    entry.out_fwd->set_src(*entry.master_out);
+    entry.out_fwd->set_dst(entry.out);
+
+    for (const auto *fd : { &entry.in, &entry.out, &entry.master->fd(), &*entry.master_out }) {
+        by_fd.emplace(fd->get(), &entry);
+    }
+}
+
+auto supervisor::drive(supervised_container &entry) -> bool
+{
+    bool work{ false };
+    for (auto *fwd : { &entry.in_fwd, &entry.out_fwd }) {
+        if (!*fwd) {
+            continue;
+        }
+
+        work = (*fwd)->drive() || work;
+        if ((*fwd)->is_finished()) {
+            by_fd.erase((*fwd)->src().get());
+            by_fd.erase((*fwd)->dst().get());
+            fwd->reset();
+        }
+    }
+
+    return work && (entry.in_fwd || entry.out_fwd);
+}
+
+auto supervisor::notify(supervised_container &entry, const nlohmann::json &event) -> void
+{
+    if (!entry.client) {
+        return;
+    }
+
+    auto ret = send_supervisor_message(*entry.client, event);
+    if (!ret) {
+        LINYAPS_BOX_LOG_DEBUG("failed to notify client of {}: {}", entry.id, ret.error().message());
+    }
+}
+
+auto supervisor::finish(supervised_container &entry) -> void
+{
+    // hooks and killing what is left in the cgroup may take seconds, the other
+    // containers are served meanwhile
+    auto cleaner = ::fork();
+    if (cleaner == 0) {
+        remove_container(status_dir_mgr_, entry.id);
+        _exit(EXIT_SUCCESS);
+    }
+
+    if (cleaner < 0) {
+        LINYAPS_BOX_LOG_WARN("failed to fork cleanup worker of {}: {}",
+                             entry.id,
+                             std::error_code(errno, std::system_category()).message());
+        remove_container(status_dir_mgr_, entry.id);
+        cleaned(entry);
+        return;
+    }
+
+    entry.cleaner = cleaner;
+    by_pid.emplace(cleaner, &entry);
+}
+
+auto supervisor::cleaned(supervised_container &entry) -> void
+{
+    by_pid.erase(entry.cleaner);
+    entry.cleaner = -1;
+    notify(entry, { { "event", "exited" }, { "exit_code", *entry.exit_code } });
+    entry.done = true;
+}
+
+auto supervisor::forget(supervised_container &entry) -> void
+{
+    entry.in_fwd.reset();
+    entry.out_fwd.reset();
+
+    auto erase = [this, &entry](const utils::file_descriptor &fd) {
+        auto it = by_fd.find(fd.get());
+        if (it != by_fd.end() && it->second == &entry) {
+            by_fd.erase(it);
+        }
+    };
+
+    erase(entry.in);
+    erase(entry.out);
+    if (entry.master) {
+        erase(entry.master->fd());
+    }
+    if (entry.master_out) {
+        erase(*entry.master_out);
+    }
+    if (entry.client) {
+        erase(entry.client->fd());
+        epoll.remove(entry.client->fd());
+    }
+}
+
+auto supervisor::stop() -> void
+{
+    if (stopping) {
+        return;
+    }
+
+    LINYAPS_BOX_LOG_INFO("Supervisor stopping, killing {} container(s)", containers.size());
+    stopping = true;
+    if (listener) {
+        epoll.remove(listener->fd());
+        listener.reset();
+    }
+
+    // workers kill theirs once it is handed over
+    for (auto &[key, entry] : containers) {
+        if (!entry->requested) {
+            entry->done = true;
+            touched.insert(entry.get());
+        } else if (entry->pid > 0 && !entry->exit_code) {
+            ::kill(entry->pid, SIGKILL);
+        }
+    }
+}
+
+} // namespace linyaps_box
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/cgroup.h"
+#include "linyaps_box/infra/unix_socket.h"
+#include "linyaps_box/io/epoll.h"
+#include "linyaps_box/io/forwarder.h"
+#include "linyaps_box/status_directory_manager.h"
+#include "linyaps_box/terminal.h"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/ioctl.h>
+
+namespace linyaps_box {
+
+// Sent by `ll-box run --supervisor` together with its stdin, stdout, stderr and
+// preserve_fds more fds. Paths are absolute, the supervisor has its own cwd.
+struct supervised_run_request
+{
+    std::string id;
+    std::filesystem::path bundle;
+    std::filesystem::path config;
+    std::optional<std::filesystem::path> console_socket;
+    std::optional<std::filesystem::path> startup_timing;
+    int preserve_fds{ 0 };
+    // Only wait until the container started.
+    bool detach{ false };
+};
+
+auto to_json(nlohmann::json &j, const supervised_run_request &request) -> void;
+auto from_json(const nlohmann::json &j, supervised_run_request &request) -> void;
+
+// Requests and events are single SOCK_SEQPACKET messages of JSON.
+inline constexpr std::size_t max_supervisor_message_size{ 64 * 1024 };
+
+struct supervisor_message
+{
+    // null once the peer hung up
+    nlohmann::json body;
+    std::vector<utils::file_descriptor> fds;
+};
+
+auto send_supervisor_message(const infra::unix_socket &socket,
+                             const nlohmann::json &body,
+                             utils::span<const utils::file_descriptor_ref> fds = { })
+  -> os::Result<std::size_t>;
+
+auto recv_supervisor_message(const infra::unix_socket &socket, std::vector<std::byte> &buffer)
+  -> os::Result<supervisor_message>;
+
+struct child_exit
+{
+    pid_t pid;
+    int status;
+};
+
+// A worker becomes a zombie in the same step its children are reparented to the
+// supervisor, so one round of waitpid may return a container before the worker
+// that hands it over. Order the exits of workers first, the rest keep theirs.
+[[nodiscard]] auto workers_first(std::vector<child_exit> exits,
+                                 const std::function<bool(pid_t)> &is_worker)
+  -> std::vector<child_exit>;
+
+// Run a container in the supervisor listening on socket and return its exit
+// code, forwarding signals and terminal resizes of the caller meanwhile.
+[[nodiscard]] auto run_in_supervisor(const std::filesystem::path &socket,
+                                     const supervised_run_request &request) -> int;
+
+// One process watching many containers. Every request is set up by a short-lived
+// worker running container::run, which hands the started container over and
+// exits; its container process is then inherited by the supervisor. Exits are
+// reaped by the supervisor and torn down by a cleanup worker forked for each:
+// poststop hooks, cgroup and status directory.
+class supervisor
+{
+public:
+    supervisor(std::filesystem::path root, cgroup_manager_t manager);
+
+    supervisor(const supervisor &) = delete;
+    auto operator=(const supervisor &) -> supervisor & = delete;
+    supervisor(supervisor &&) = delete;
+    auto operator=(supervisor &&) -> supervisor & = delete;
+
+    ~supervisor() noexcept;
+
+    // Serve requests on socket until SIGINT or SIGTERM, then kill the containers
+    // still running and return once all of them are cleaned up.
+    auto serve(const std::filesystem::path &socket) -> int;
+
+private:
+    struct supervised_container
+    {
+        std::optional<infra::unix_socket> client;
+        bool requested{ false };
+        bool detach{ false };
+        std::string id;
+        pid_t worker{ -1 };
+        // The worker's end is handed over with {"pid": N} and the PTY master.
+        std::optional<infra::unix_socket> handoff;
+        pid_t pid{ -1 };
+        std::optional<int> exit_code;
+        // Runs the poststop hooks and removes the cgroup and status directory.
+        pid_t cleaner{ -1 };
+        std::vector<int> pending_signals;
+        std::optional<struct winsize> window;
+        // The caller's stdin and stdout, only used to forward a terminal.
+        utils::file_descriptor in;
+        utils::file_descriptor out;
+        std::optional<terminal_master> master;
+        std::optional<utils::file_descriptor> master_out;
+        std::optional<io::Forwarder> in_fwd;
+        std::optional<io::Forwarder> out_fwd;
+        bool done{ false };
+    };
+
+    auto accept_clients() -> void;
+    auto handle_signals() -> void;
+    auto handle_client(supervised_container &entry) -> void;
+    auto handle_request(supervised_container &entry,
+                        nlohmann::json body,
+                        std::vector<utils::file_descriptor> fds) -> void;
+    auto reap_children() -> void;
+    auto worker_exited(supervised_container &entry) -> void;
+    auto adopt(supervised_container &entry,
+               pid_t pid,
+               std::vector<utils::file_descriptor> fds) -> void;
+    auto container_exited(supervised_container &entry, int exit_code) -> void;
+    auto forward_signal(supervised_container &entry, int sig) -> void;
+    auto resize(supervised_container &entry, struct winsize size) -> void;
+    auto enable_io_forwarding(supervised_container &entry) -> void;
+    auto drive(supervised_container &entry) -> bool;
+    auto notify(supervised_container &entry, const nlohmann::json &event) -> void;
+    auto finish(supervised_container &entry) -> void;
+    auto cleaned(supervised_container &entry) -> void;
+    auto forget(supervised_container &entry) -> void;
+    auto stop() -> void;
+
+    status_directory_manager status_dir_mgr_;
+    cgroup_manager_t manager_;
+    io::Epoll epoll;
+    utils::file_descriptor signal_fd;
+    std::optional<infra::unix_socket> listener;
+    bool stopping{ false };
+    std::vector<std::byte> buffer;
+    std::unordered_map<const supervised_container *, std::unique_ptr<supervised_container>>
+      containers;
+    // Client sockets and forwarded fds, worker and container pids.
+    std::unordered_map<int, supervised_container *> by_fd;
+    std::unordered_map<pid_t, supervised_container *> by_pid;
+    // Entries to drive and check once the events of a round are handled.
+    std::unordered_set<supervised_container *> touched;
+};
+
+} // namespace linyaps_box
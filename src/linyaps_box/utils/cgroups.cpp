@@ -7,9 +7,11 @@
 #include <sys/statfs.h>
 
 #include <filesystem>
+#include <fstream>
+#include <string>
 #include <system_error>
 
-constexpr auto cgroup_root = "/sys/fs/cgroups";
+constexpr auto cgroup_root = "/sys/fs/cgroup";
 
 auto linyaps_box::utils::get_cgroup_type() -> linyaps_box::utils::cgroup_t
 {
@@ -52,3 +54,51 @@ auto linyaps_box::utils::get_cgroup_type() -> linyaps_box::utils::cgroup_t
 
     return cgroup_type;
 }
+
+auto linyaps_box::utils::get_unified_cgroup_root() -> std::filesystem::path
+{
+    switch (get_cgroup_type()) {
+    case cgroup_t::unified:
+        return cgroup_root;
+    case cgroup_t::hybrid:
+        return std::filesystem::path{ cgroup_root } / "unified";
+    case cgroup_t::legacy:
+        break;
+    }
+
+    throw std::runtime_error("cgroup v2 is not mounted");
+}
+
+auto linyaps_box::utils::get_own_unified_cgroup() -> std::filesystem::path
+{
+    // the cgroup v2 entry is "0::/path"
+    std::ifstream stream{ "/proc/self/cgroup" };
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.rfind("0::", 0) == 0) {
+            return std::filesystem::path{ line.substr(3) }.relative_path();
+        }
+    }
+
+    throw std::runtime_error("failed to find the cgroup v2 entry in /proc/self/cgroup");
+}
+
+auto linyaps_box::utils::read_cgroup_event(const std::filesystem::path &cgroup,
+                                           std::string_view key) -> std::optional<std::string>
+{
+    std::ifstream stream{ cgroup / "cgroup.events" };
+    std::string name;
+    std::string value;
+    while (stream >> name >> value) {
+        if (name == key) {
+            return value;
+        }
+    }
+
+    return std::nullopt;
+}
+
+auto linyaps_box::utils::is_cgroup_frozen(const std::filesystem::path &cgroup) -> bool
+{
+    return read_cgroup_event(cgroup, "frozen") == "1";
+}
@@ -5,6 +5,10 @@
 #pragma once
 
 #include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
 
 namespace linyaps_box::utils {
 
@@ -12,4 +16,19 @@ enum class cgroup_t : std::uint8_t { unified, legacy, hybrid };
 
 auto get_cgroup_type() -> cgroup_t;
 
+// Mount point of the cgroup v2 hierarchy, /sys/fs/cgroup or /sys/fs/cgroup/unified
+// in hybrid mode. Throws on a legacy only system.
+auto get_unified_cgroup_root() -> std::filesystem::path;
+
+// The cgroup v2 path of the calling process, relative to the hierarchy root.
+auto get_own_unified_cgroup() -> std::filesystem::path;
+
+// The value of key in cgroup.events of a cgroup v2 directory, nullopt when it can
+// not be read, e.g. the cgroup is gone.
+auto read_cgroup_event(const std::filesystem::path &cgroup, std::string_view key)
+  -> std::optional<std::string>;
+
+// Whether cgroup.events reports "frozen 1".
+auto is_cgroup_frozen(const std::filesystem::path &cgroup) -> bool;
+
 } // namespace linyaps_box::utils
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/utils/idmap.h"
+
+#include "linyaps_box/infra/unix_socket.h"
+#include "linyaps_box/os/fs.h"
+#include "linyaps_box/utils/defer.h"
+
+#include <fmt/format.h>
+
+#include <csignal>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace linyaps_box::utils {
+
+auto format_id_mappings(const std::vector<oci_config::id_mapping_t> &mappings) -> std::string
+{
+    std::string content;
+    for (const auto &mapping : mappings) {
+        fmt::format_to(std::back_inserter(content),
+                       "{} {} {}\n",
+                       mapping.container_id,
+                       mapping.host_id,
+                       mapping.size);
+    }
+
+    return content;
+}
+
+auto create_idmap_userns(const std::string &uid_map, const std::string &gid_map) -> file_descriptor
+{
+    auto [parent, child] = infra::unix_socket::create_pair(os::sys::socket_type::seqpacket,
+                                                           os::sys::socket_flag::cloexec);
+
+    auto pid = ::fork();
+    if (pid < 0) {
+        throw std::system_error(errno, std::system_category(), "fork");
+    }
+
+    if (pid == 0) {
+        parent.close();
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        const char ready = ::unshare(CLONE_NEWUSER) == 0 ? 1 : 0;
+        std::ignore = child.fd().write(ready);
+
+        // wait for the parent to be done with us
+        char done{ };
+        std::ignore = child.fd().read(done);
+        _exit(EXIT_SUCCESS);
+    }
+
+    child.close();
+    auto reap = make_defer([pid]() noexcept {
+        ::kill(pid, SIGKILL);
+        while (::waitpid(pid, nullptr, 0) < 0 && errno == EINTR) { }
+    });
+
+    char ready{ 0 };
+    if (parent.fd().read(ready).status != IOStatus::Success || ready == 0) {
+        throw std::runtime_error("failed to create user namespace for idmapped mount");
+    }
+
+    const auto proc = std::filesystem::path{ "/proc" } / std::to_string(pid);
+    for (const auto &[file, content] : { std::pair{ "uid_map", &uid_map },
+                                         std::pair{ "gid_map", &gid_map } }) {
+        auto fd = os::throw_if_error(
+          os::open(proc / file, { os::sys::open_flag::cloexec, os::sys::access_mode::write_only }));
+        if (::write(fd.get(), content->data(), content->size())
+            != static_cast<ssize_t>(content->size())) {
+            throw std::system_error(errno,
+                                    std::system_category(),
+                                    "write to " + (proc / file).string());
+        }
+    }
+
+    return os::throw_if_error(
+      os::open(proc / "ns/user", { os::sys::open_flag::cloexec, os::sys::access_mode::read_only }));
+}
+
+} // namespace linyaps_box::utils
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+#include "linyaps_box/utils/file_describer.h"
+
+#include <string>
+#include <vector>
+
+namespace linyaps_box::utils {
+
+// "container_id host_id size" lines, as written to /proc/<pid>/uid_map.
+[[nodiscard]] auto format_id_mappings(const std::vector<oci_config::id_mapping_t> &mappings)
+  -> std::string;
+
+// A user namespace carrying the mappings of an idmapped mount. Host ids are
+// resolved in the user namespace of the caller, so it has to run on the runtime
+// side, not in the container. The namespace is created by a child which is
+// killed as soon as the namespace fd is open, the fd alone keeps it alive.
+[[nodiscard]] auto create_idmap_userns(const std::string &uid_map, const std::string &gid_map)
+  -> file_descriptor;
+
+} // namespace linyaps_box::utils
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/utils/mempolicy.h"
+
+#include "linyaps_box/config/parse_helpers.h"
+#include "linyaps_box/log/macro.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace linyaps_box::utils {
+
+namespace {
+
+using memory_policy_t = oci_config::linux_t::memory_policy_t;
+
+// linux/mempolicy.h, not every libc ships it
+constexpr int mpol_default = 0;
+constexpr int mpol_preferred = 1;
+constexpr int mpol_bind = 2;
+constexpr int mpol_interleave = 3;
+constexpr int mpol_local = 4;
+constexpr int mpol_preferred_many = 5;
+constexpr int mpol_weighted_interleave = 6;
+
+constexpr int mpol_f_numa_balancing = 1 << 13;
+constexpr int mpol_f_relative_nodes = 1 << 14;
+constexpr int mpol_f_static_nodes = 1 << 15;
+
+auto has_flag(const memory_policy_t &policy, memory_policy_t::flag_t flag) -> bool
+{
+    return policy.flags && (*policy.flags & flag) == flag;
+}
+
+} // namespace
+
+auto to_mempolicy_mode(const memory_policy_t &policy) -> int
+{
+    int mode{ mpol_default };
+    switch (policy.mode) {
+    case memory_policy_t::mode_t::DEFAULT:
+        mode = mpol_default;
+        break;
+    case memory_policy_t::mode_t::BIND:
+        mode = mpol_bind;
+        break;
+    case memory_policy_t::mode_t::INTERLEAVE:
+        mode = mpol_interleave;
+        break;
+    case memory_policy_t::mode_t::WEIGHTED_INTERLEAVE:
+        mode = mpol_weighted_interleave;
+        break;
+    case memory_policy_t::mode_t::PREFERRED:
+        mode = mpol_preferred;
+        break;
+    case memory_policy_t::mode_t::PREFERRED_MANY:
+        mode = mpol_preferred_many;
+        break;
+    case memory_policy_t::mode_t::LOCAL:
+        mode = mpol_local;
+        break;
+    }
+
+    if (has_flag(policy, memory_policy_t::flag_t::NUMA_BALANCING)) {
+        mode |= mpol_f_numa_balancing;
+    }
+    if (has_flag(policy, memory_policy_t::flag_t::RELATIVE_NODES)) {
+        mode |= mpol_f_relative_nodes;
+    }
+    if (has_flag(policy, memory_policy_t::flag_t::STATIC_NODES)) {
+        mode |= mpol_f_static_nodes;
+    }
+
+    return mode;
+}
+
+auto online_numa_nodes() -> std::vector<unsigned int>
+{
+    std::ifstream stream{ "/sys/devices/system/node/online" };
+    std::string line;
+    if (!std::getline(stream, line)) {
+        return { 0 };
+    }
+
+    return config::parse_range_list(line);
+}
+
+auto apply_memory_policy(const memory_policy_t &policy) -> void
+{
+    constexpr auto bits_per_word = sizeof(unsigned long) * CHAR_BIT;
+
+    // relative nodes are indices into the allowed set, not node ids
+    if (policy.nodes && !has_flag(policy, memory_policy_t::flag_t::RELATIVE_NODES)) {
+        const auto online = online_numa_nodes();
+        for (auto node : *policy.nodes) {
+            if (std::find(online.cbegin(), online.cend(), node) == online.cend()) {
+                throw std::runtime_error(fmt::format("memoryPolicy node {} is not online", node));
+            }
+        }
+    }
+
+    std::vector<unsigned long> mask;
+    if (policy.nodes && !policy.nodes->empty()) {
+        const auto max_node = *std::max_element(policy.nodes->cbegin(), policy.nodes->cend());
+        mask.resize(max_node / bits_per_word + 1);
+        for (auto node : *policy.nodes) {
+            mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+        }
+    }
+
+    const auto mode = to_mempolicy_mode(policy);
+    LINYAPS_BOX_LOG_DEBUG("Set memory policy {:#x}", mode);
+
+    // the kernel drops the last bit of maxnode
+    const auto maxnode = mask.size() * bits_per_word + 1;
+    if (::syscall(SYS_set_mempolicy, mode, mask.empty() ? nullptr : mask.data(), maxnode) != 0) {
+        throw std::system_error(errno, std::system_category(), "set_mempolicy");
+    }
+}
+
+} // namespace linyaps_box::utils
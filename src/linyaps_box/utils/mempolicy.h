@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+
+#include <vector>
+
+namespace linyaps_box::utils {
+
+// The mode argument of set_mempolicy(2), MPOL_* or'ed with the MPOL_F_* flags.
+[[nodiscard]] auto to_mempolicy_mode(const oci_config::linux_t::memory_policy_t &policy) -> int;
+
+// NUMA nodes listed in /sys/devices/system/node/online, only node 0 on kernels
+// without NUMA support.
+[[nodiscard]] auto online_numa_nodes() -> std::vector<unsigned int>;
+
+// set_mempolicy(2) for the calling process, inherited across fork and exec.
+auto apply_memory_policy(const oci_config::linux_t::memory_policy_t &policy) -> void;
+
+} // namespace linyaps_box::utils
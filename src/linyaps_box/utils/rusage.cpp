@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/utils/rusage.h"
+
+#include "linyaps_box/os/fs.h"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#  include <malloc.h>
+#endif
+
+namespace linyaps_box::utils {
+
+namespace {
+
+auto to_microseconds(const struct timeval &tv) noexcept -> std::chrono::microseconds
+{
+    return std::chrono::seconds{ tv.tv_sec } + std::chrono::microseconds{ tv.tv_usec };
+}
+
+auto read_small_file(file_descriptor_ref dirfd, const char *name) -> std::optional<std::string>
+{
+    auto fd =
+      os::openat(dirfd, name, { os::sys::open_flag::cloexec, os::sys::access_mode::read_only });
+    if (!fd) {
+        return std::nullopt;
+    }
+
+    std::string content;
+    std::array<char, 1024> buf{ };
+    while (true) {
+        const auto n = ::read(fd->get(), buf.data(), buf.size());
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return std::nullopt;
+        }
+
+        if (n == 0) {
+            return content;
+        }
+
+        content.append(buf.data(), static_cast<std::size_t>(n));
+    }
+}
+
+auto to_json(const process_usage &usage) -> nlohmann::json
+{
+    return nlohmann::json{
+        { "processes", usage.processes },
+        { "user_cpu_us", usage.user_cpu.count() },
+        { "system_cpu_us", usage.system_cpu.count() },
+        { "max_rss_kib", usage.max_rss_kib },
+        { "voluntary_context_switches", usage.voluntary_switches },
+        { "involuntary_context_switches", usage.involuntary_switches },
+        { "block_input", usage.block_input },
+        { "block_output", usage.block_output },
+    };
+}
+
+} // namespace
+
+auto accumulate(process_usage &usage, const struct rusage &ru) noexcept -> void
+{
+    usage.user_cpu += to_microseconds(ru.ru_utime);
+    usage.system_cpu += to_microseconds(ru.ru_stime);
+    usage.max_rss_kib = std::max<std::int64_t>(usage.max_rss_kib, ru.ru_maxrss);
+    usage.voluntary_switches += ru.ru_nvcsw;
+    usage.involuntary_switches += ru.ru_nivcsw;
+    usage.block_input += ru.ru_inblock;
+    usage.block_output += ru.ru_oublock;
+    ++usage.processes;
+}
+
+auto read_cgroup_usage(file_descriptor_ref cgroup_dirfd) -> cgroup_usage
+{
+    cgroup_usage usage;
+
+    // "usage_usec 1234\nuser_usec 1000\n..."
+    if (auto content = read_small_file(cgroup_dirfd, "cpu.stat"); content) {
+        std::istringstream stream{ *content };
+        std::string key;
+        std::uint64_t value{ 0 };
+        while (stream >> key >> value) {
+            usage.cpu_stat.emplace(std::move(key), value);
+        }
+    }
+
+    // since kernel 5.19
+    if (auto content = read_small_file(cgroup_dirfd, "memory.peak"); content) {
+        char *end{ nullptr };
+        const auto value = std::strtoull(content->c_str(), &end, 10);
+        if (end != content->c_str()) {
+            usage.memory_peak = value;
+        }
+    }
+
+    return usage;
+}
+
+auto to_string(const usage_report &report) -> std::string
+{
+    const auto &c = report.container;
+    const auto &d = report.descendants;
+    auto ret = fmt::format("exit_code={} user_cpu_us={} system_cpu_us={} max_rss_kib={} "
+                           "nvcsw={} nivcsw={} inblock={} oublock={} descendants={}",
+                           report.exit_code,
+                           (c.user_cpu + d.user_cpu).count(),
+                           (c.system_cpu + d.system_cpu).count(),
+                           std::max(c.max_rss_kib, d.max_rss_kib),
+                           c.voluntary_switches + d.voluntary_switches,
+                           c.involuntary_switches + d.involuntary_switches,
+                           c.block_input + d.block_input,
+                           c.block_output + d.block_output,
+                           d.processes);
+    if (report.cgroup && report.cgroup->memory_peak) {
+        ret += fmt::format(" memory_peak={}", *report.cgroup->memory_peak);
+    }
+
+    return ret;
+}
+
+auto write_usage_report(const std::filesystem::path &path, const usage_report &report) -> void
+{
+    auto content = nlohmann::json{
+        { "exit_code", report.exit_code },
+        { "container", to_json(report.container) },
+        { "descendants", to_json(report.descendants) },
+    };
+
+    if (report.cgroup) {
+        auto cgroup = nlohmann::json{ { "cpu_stat", report.cgroup->cpu_stat } };
+        if (report.cgroup->memory_peak) {
+            cgroup["memory_peak"] = *report.cgroup->memory_peak;
+        }
+        content["cgroup"] = std::move(cgroup);
+    }
+
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs) {
+        throw std::system_error(errno, std::system_category(), "failed to open " + path.string());
+    }
+
+    ofs << content.dump(4) << '\n';
+    if (!ofs) {
+        throw std::system_error(errno, std::system_category(), "failed to write " + path.string());
+    }
+}
+
+auto current_rss_kib() -> std::optional<std::int64_t>
+{
+    // statm is in pages: size resident shared text lib data dt
+    std::ifstream statm("/proc/self/statm");
+    std::int64_t size{ 0 };
+    std::int64_t resident{ 0 };
+    if (!(statm >> size >> resident)) {
+        return std::nullopt;
+    }
+
+    return resident * (::sysconf(_SC_PAGESIZE) / 1024);
+}
+
+auto trim_heap() noexcept -> void
+{
+#ifdef __GLIBC__
+    ::malloc_trim(0);
+#endif
+}
+
+} // namespace linyaps_box::utils
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/utils/file_describer.h"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace linyaps_box::utils {
+
+// Resource usage of one or more reaped processes, as reported by wait4(2).
+struct process_usage
+{
+    std::chrono::microseconds user_cpu{ };
+    std::chrono::microseconds system_cpu{ };
+    // the largest max RSS among the accumulated processes
+    std::int64_t max_rss_kib{ 0 };
+    std::int64_t voluntary_switches{ 0 };
+    std::int64_t involuntary_switches{ 0 };
+    // in 512 byte blocks
+    std::int64_t block_input{ 0 };
+    std::int64_t block_output{ 0 };
+    std::uint64_t processes{ 0 };
+};
+
+auto accumulate(process_usage &usage, const struct rusage &ru) noexcept -> void;
+
+// Final counters of the container's cgroup, only what the kernel provides is set.
+struct cgroup_usage
+{
+    std::map<std::string, std::uint64_t> cpu_stat;
+    std::optional<std::uint64_t> memory_peak;
+};
+
+// Best effort, missing or unreadable files leave the fields empty.
+[[nodiscard]] auto read_cgroup_usage(file_descriptor_ref cgroup_dirfd) -> cgroup_usage;
+
+struct usage_report
+{
+    int exit_code{ 0 };
+    // the container process, including the children it waited for itself
+    process_usage container;
+    // orphans reparented to the runtime and reaped by it
+    process_usage descendants;
+    std::optional<cgroup_usage> cgroup;
+};
+
+// One line summary, for the log.
+[[nodiscard]] auto to_string(const usage_report &report) -> std::string;
+
+auto write_usage_report(const std::filesystem::path &path, const usage_report &report) -> void;
+
+// Resident set size of the calling process, nullopt if /proc is unavailable.
+[[nodiscard]] auto current_rss_kib() -> std::optional<std::int64_t>;
+
+// Return the free pages of the heap to the kernel, a no-op without glibc.
+auto trim_heap() noexcept -> void;
+
+} // namespace linyaps_box::utils
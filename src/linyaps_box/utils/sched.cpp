@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/utils/sched.h"
+
+#include "linyaps_box/config/parse_helpers.h"
+#include "linyaps_box/log/macro.h"
+
+#include <fmt/format.h>
+
+#include <cerrno>
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace linyaps_box::utils {
+
+namespace {
+
+using scheduler_t = oci_config::process_t::scheduler_t;
+
+constexpr std::uint32_t sched_capacity_scale = 1024;
+constexpr std::uint64_t sched_flag_util_clamp_min = 0x20;
+constexpr std::uint64_t sched_flag_util_clamp_max = 0x40;
+
+auto parse_util_value(const std::unordered_map<std::string, std::string> &annotations,
+                      const std::string &key) -> std::optional<std::uint32_t>
+{
+    auto it = annotations.find(key);
+    if (it == annotations.end()) {
+        return std::nullopt;
+    }
+
+    const auto &str = it->second;
+    std::uint32_t value{ };
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec != std::errc{ } || ptr != str.data() + str.size() || value > sched_capacity_scale) {
+        throw std::invalid_argument(fmt::format("invalid {}: {}", key, str));
+    }
+
+    return value;
+}
+
+auto to_policy(scheduler_t::policy_t policy) -> std::uint32_t
+{
+    switch (policy) {
+    case scheduler_t::policy_t::OTHER:
+        return SCHED_OTHER;
+    case scheduler_t::policy_t::FIFO:
+        return SCHED_FIFO;
+    case scheduler_t::policy_t::RR:
+        return SCHED_RR;
+    case scheduler_t::policy_t::BATCH:
+        return SCHED_BATCH;
+    case scheduler_t::policy_t::ISO:
+        return 4; // reserved by the kernel, sched_setattr rejects it
+    case scheduler_t::policy_t::IDLE:
+        return SCHED_IDLE;
+    case scheduler_t::policy_t::DEADLINE:
+        return 6; // SCHED_DEADLINE
+    }
+
+    __builtin_unreachable();
+}
+
+} // namespace
+
+auto
+parse_util_clamp(const std::optional<std::unordered_map<std::string, std::string>> &annotations)
+  -> util_clamp
+{
+    if (!annotations) {
+        return { };
+    }
+
+    return { parse_util_value(*annotations, "cn.org.linyaps.runtime.sched_util_min"),
+             parse_util_value(*annotations, "cn.org.linyaps.runtime.sched_util_max") };
+}
+
+auto to_sched_attr(const scheduler_t &scheduler, const util_clamp &clamp) -> sched_attr
+{
+    sched_attr attr{ };
+    attr.size = sizeof(sched_attr);
+    attr.sched_policy = to_policy(scheduler.policy);
+    attr.sched_flags = scheduler.flags ? static_cast<std::uint64_t>(*scheduler.flags) : 0;
+    attr.sched_nice = scheduler.nice.value_or(0);
+    attr.sched_priority = static_cast<std::uint32_t>(scheduler.priority.value_or(0));
+    attr.sched_runtime = scheduler.runtime.value_or(0);
+    attr.sched_deadline = scheduler.deadline.value_or(0);
+    attr.sched_period = scheduler.period.value_or(0);
+
+    attr.sched_util_min = clamp.min.value_or(0);
+    attr.sched_util_max = clamp.max.value_or(sched_capacity_scale);
+    if (clamp.min) {
+        attr.sched_flags |= sched_flag_util_clamp_min;
+    }
+    if (clamp.max) {
+        attr.sched_flags |= sched_flag_util_clamp_max;
+    }
+
+    return attr;
+}
+
+auto to_ioprio(const oci_config::process_t::io_priority_t &priority) -> int
+{
+    constexpr auto ioprio_class_shift = 13;
+    int io_class{ };
+    switch (priority.class_) {
+    case oci_config::process_t::io_priority_t::class_t::RT:
+        io_class = 1;
+        break;
+    case oci_config::process_t::io_priority_t::class_t::BEST_EFFORT:
+        io_class = 2;
+        break;
+    case oci_config::process_t::io_priority_t::class_t::IDLE:
+        io_class = 3;
+        break;
+    }
+
+    return (io_class << ioprio_class_shift) | priority.priority;
+}
+
+auto apply_scheduling(
+  const oci_config::process_t &process,
+  const std::optional<std::unordered_map<std::string, std::string>> &annotations) -> void
+{
+    if (process.scheduler) {
+        auto attr = to_sched_attr(*process.scheduler, parse_util_clamp(annotations));
+        LINYAPS_BOX_LOG_DEBUG("Set scheduler policy {} flags {:#x}",
+                              attr.sched_policy,
+                              attr.sched_flags);
+        if (::syscall(SYS_sched_setattr, 0, &attr, 0) != 0) {
+            throw std::system_error(errno, std::system_category(), "sched_setattr");
+        }
+    }
+
+    if (process.io_priority) {
+        constexpr auto ioprio_who_process = 1;
+        const auto value = to_ioprio(*process.io_priority);
+        LINYAPS_BOX_LOG_DEBUG("Set IO priority {:#x}", value);
+        if (::syscall(SYS_ioprio_set, ioprio_who_process, 0, value) != 0) {
+            throw std::system_error(errno, std::system_category(), "ioprio_set");
+        }
+    }
+}
+
+auto set_cpu_affinity(std::string_view cpus) -> void
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpus.empty()) {
+        // the kernel intersects this with the cpuset of the cgroup
+        for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &set);
+        }
+    } else {
+        for (auto cpu : config::parse_range_list(cpus)) {
+            if (cpu >= CPU_SETSIZE) {
+                throw std::invalid_argument(fmt::format("cpu {} is out of range", cpu));
+            }
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+        throw std::system_error(errno,
+                                std::system_category(),
+                                fmt::format("sched_setaffinity {}", cpus));
+    }
+}
+
+auto apply_initial_cpu_affinity(const oci_config::process_t &process) -> void
+{
+    if (process.exec_cpu_affinity && process.exec_cpu_affinity->initial) {
+        set_cpu_affinity(*process.exec_cpu_affinity->initial);
+    }
+}
+
+auto apply_final_cpu_affinity(const oci_config::process_t &process) -> void
+{
+    if (process.exec_cpu_affinity) {
+        set_cpu_affinity(process.exec_cpu_affinity->final.value_or(""));
+    }
+}
+
+} // namespace linyaps_box::utils
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/config.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace linyaps_box::utils {
+
+// struct sched_attr of sched_setattr(2), SCHED_ATTR_SIZE_VER1
+struct sched_attr
+{
+    std::uint32_t size;
+    std::uint32_t sched_policy;
+    std::uint64_t sched_flags;
+    std::int32_t sched_nice;
+    std::uint32_t sched_priority;
+    std::uint64_t sched_runtime;
+    std::uint64_t sched_deadline;
+    std::uint64_t sched_period;
+    std::uint32_t sched_util_min;
+    std::uint32_t sched_util_max;
+};
+
+// The runtime spec has flags for util clamping but no values, linyaps takes them
+// from the annotations cn.org.linyaps.runtime.sched_util_min and sched_util_max,
+// each in [0, 1024]. A value implies its flag.
+struct util_clamp
+{
+    std::optional<std::uint32_t> min;
+    std::optional<std::uint32_t> max;
+};
+
+[[nodiscard]] auto
+parse_util_clamp(const std::optional<std::unordered_map<std::string, std::string>> &annotations)
+  -> util_clamp;
+
+[[nodiscard]] auto to_sched_attr(const oci_config::process_t::scheduler_t &scheduler,
+                                 const util_clamp &clamp) -> sched_attr;
+
+// The ioprio_set(2) value of an ioPriority.
+[[nodiscard]] auto to_ioprio(const oci_config::process_t::io_priority_t &priority) -> int;
+
+// process.scheduler and process.ioPriority for the calling process. Both may need
+// CAP_SYS_NICE or CAP_SYS_ADMIN, so this runs before privileges are dropped.
+auto apply_scheduling(
+  const oci_config::process_t &process,
+  const std::optional<std::unordered_map<std::string, std::string>> &annotations) -> void;
+
+// cpus is a list such as "0-3,7", empty allows every CPU the cgroup's cpuset allows.
+auto set_cpu_affinity(std::string_view cpus) -> void;
+
+// execCPUAffinity.initial, for the setup work the runtime does in the container.
+auto apply_initial_cpu_affinity(const oci_config::process_t &process) -> void;
+
+// execCPUAffinity.final, right before exec. Without it an initial affinity is
+// lifted again.
+auto apply_final_cpu_affinity(const oci_config::process_t &process) -> void;
+
+} // namespace linyaps_box::utils
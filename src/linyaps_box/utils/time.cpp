@@ -9,8 +9,12 @@
 #include <fmt/chrono.h>
 
 #include <cassert>
+#include <cerrno>
 #include <charconv>
 #include <stdexcept>
+#include <system_error>
+
+#include <sys/timerfd.h>
 
 namespace linyaps_box::utils {
 
@@ -95,4 +99,30 @@ auto from_created_time(const std::string &str) -> std::chrono::system_clock::tim
     return tp;
 }
 
+auto create_timerfd(std::chrono::nanoseconds interval, bool nonblock) -> file_descriptor
+{
+    int flags = TFD_CLOEXEC;
+    if (nonblock) {
+        flags |= TFD_NONBLOCK;
+    }
+
+    auto ret = ::timerfd_create(CLOCK_MONOTONIC, flags);
+    if (ret < 0) {
+        throw std::system_error(errno, std::system_category(), "timerfd_create");
+    }
+
+    file_descriptor fd{ ret };
+
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(interval);
+    struct itimerspec spec{ };
+    spec.it_interval.tv_sec = secs.count();
+    spec.it_interval.tv_nsec = (interval - secs).count();
+    spec.it_value = spec.it_interval;
+    if (::timerfd_settime(fd.get(), 0, &spec, nullptr) < 0) {
+        throw std::system_error(errno, std::system_category(), "timerfd_settime");
+    }
+
+    return fd;
+}
+
 } // namespace linyaps_box::utils
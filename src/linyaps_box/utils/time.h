@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "linyaps_box/utils/file_describer.h"
 #include "linyaps_box/utils/span.h"
 
 #include <chrono>
@@ -25,4 +26,7 @@ to_created_time(span<char> buf,
 
 auto from_created_time(const std::string &str) -> std::chrono::system_clock::time_point;
 
+// A CLOCK_MONOTONIC timerfd expiring every interval, first after one interval.
+auto create_timerfd(std::chrono::nanoseconds interval, bool nonblock = true) -> file_descriptor;
+
 } // namespace linyaps_box::utils
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "linyaps_box/utils/timing.h"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include <time.h>
+
+namespace linyaps_box::utils {
+
+namespace {
+
+auto write_json(const std::filesystem::path &path, const nlohmann::json &content) -> void
+{
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs) {
+        throw std::system_error(errno,
+                                std::system_category(),
+                                "failed to open " + path.string());
+    }
+
+    ofs << content.dump(4) << '\n';
+    if (!ofs) {
+        throw std::system_error(errno,
+                                std::system_category(),
+                                "failed to write " + path.string());
+    }
+}
+
+auto sorted_records(const phase_recorder &recorder) -> std::vector<const phase_record *>
+{
+    auto records = recorder.records();
+    std::vector<const phase_record *> sorted;
+    sorted.reserve(records.size());
+    for (const auto &r : records) {
+        sorted.push_back(&r);
+    }
+
+    // parents must precede their children for trace viewers to nest spans,
+    // so order by begin and put the longer span first on ties
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto *lhs, const auto *rhs) {
+        if (lhs->begin != rhs->begin) {
+            return lhs->begin < rhs->begin;
+        }
+
+        return lhs->end > rhs->end;
+    });
+
+    return sorted;
+}
+
+} // namespace
+
+auto monotonic_now() noexcept -> std::chrono::nanoseconds
+{
+    struct timespec ts{ };
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return std::chrono::seconds{ ts.tv_sec } + std::chrono::nanoseconds{ ts.tv_nsec };
+}
+
+auto phase_recorder::instance() noexcept -> phase_recorder &
+{
+    static phase_recorder recorder;
+    return recorder;
+}
+
+auto phase_recorder::enable() noexcept -> void
+{
+    if (enabled_) {
+        return;
+    }
+
+    enabled_ = true;
+    epoch_ = monotonic_now();
+}
+
+auto phase_recorder::rebind(phase_origin origin) noexcept -> void
+{
+    records_.clear();
+    origin_ = origin;
+}
+
+auto phase_recorder::record(std::string_view name,
+                            std::string_view detail,
+                            std::chrono::nanoseconds begin,
+                            std::chrono::nanoseconds end) noexcept -> void
+{
+    if (!enabled_) {
+        return;
+    }
+
+    try {
+        records_.push_back(
+          phase_record{ std::string{ name }, std::string{ detail }, begin, end, origin_ });
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+        // timing is best effort, never break the startup because of it
+    }
+}
+
+auto phase_recorder::merge(std::vector<phase_record> records) noexcept -> void
+{
+    if (!enabled_ || records.empty()) {
+        return;
+    }
+
+    try {
+        records_.insert(records_.end(),
+                        std::make_move_iterator(records.begin()),
+                        std::make_move_iterator(records.end()));
+    } catch (...) { // NOLINT(bugprone-empty-catch)
+    }
+}
+
+auto phase_recorder::take() noexcept -> std::vector<phase_record>
+{
+    return std::exchange(records_, { });
+}
+
+phase_scope::phase_scope(std::string_view name, std::string_view detail) noexcept
+    : name(name)
+    , detail(detail)
+{
+    if (phase_recorder::instance().enabled()) {
+        begin = monotonic_now();
+    }
+}
+
+phase_scope::~phase_scope() noexcept
+{
+    auto &recorder = phase_recorder::instance();
+    if (!recorder.enabled()) {
+        return;
+    }
+
+    recorder.record(name, detail, begin, monotonic_now());
+}
+
+auto write_phase_report(const std::filesystem::path &path, const phase_recorder &recorder) -> void
+{
+    const auto epoch = recorder.epoch();
+    auto last = epoch;
+    auto phases = nlohmann::json::array();
+    for (const auto *r : sorted_records(recorder)) {
+        last = std::max(last, r->end);
+
+        auto phase = nlohmann::json{
+            { "name", r->name },
+            { "process", to_string_view(r->origin) },
+            { "start_ns", (r->begin - epoch).count() },
+            { "duration_ns", (r->end - r->begin).count() },
+        };
+        if (!r->detail.empty()) {
+            phase["detail"] = r->detail;
+        }
+
+        phases.push_back(std::move(phase));
+    }
+
+    write_json(path,
+               nlohmann::json{
+                 { "clock", "monotonic" },
+                 { "total_ns", (last - epoch).count() },
+                 { "phases", std::move(phases) },
+               });
+}
+
+auto write_trace_events(const std::filesystem::path &path, const phase_recorder &recorder) -> void
+{
+    // trace-event timestamps are microseconds, fractional values keep ns precision
+    const auto epoch = recorder.epoch();
+    const auto to_us = [](std::chrono::nanoseconds ns) {
+        return std::chrono::duration<double, std::micro>{ ns }.count();
+    };
+    const auto to_pid = [](phase_origin o) {
+        return static_cast<int>(o) + 1;
+    };
+
+    auto events = nlohmann::json::array();
+    for (auto origin : { phase_origin::runtime, phase_origin::container }) {
+        events.push_back(nlohmann::json{
+          { "name", "process_name" },
+          { "ph", "M" },
+          { "pid", to_pid(origin) },
+          { "args", { { "name", fmt::format("ll-box {}", to_string_view(origin)) } } },
+        });
+    }
+
+    for (const auto *r : sorted_records(recorder)) {
+        auto event = nlohmann::json{
+            { "name", r->name },
+            { "cat", to_string_view(r->origin) },
+            { "ph", "X" },
+            { "ts", to_us(r->begin - epoch) },
+            { "dur", to_us(r->end - r->begin) },
+            { "pid", to_pid(r->origin) },
+            { "tid", to_pid(r->origin) },
+        };
+        if (!r->detail.empty()) {
+            event["args"] = { { "detail", r->detail } };
+        }
+
+        events.push_back(std::move(event));
+    }
+
+    write_json(path,
+               nlohmann::json{
+                 { "displayTimeUnit", "ns" },
+                 { "traceEvents", std::move(events) },
+               });
+}
+
+} // namespace linyaps_box::utils
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#pragma once
+
+#include "linyaps_box/utils/span.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linyaps_box::utils {
+
+enum class phase_origin : std::uint8_t {
+    runtime,
+    container,
+};
+
+[[nodiscard]] constexpr auto to_string_view(phase_origin o) noexcept -> std::string_view
+{
+    switch (o) {
+    case phase_origin::runtime:
+        return "runtime";
+    case phase_origin::container:
+        return "container";
+    }
+
+    return "<invalid>";
+}
+
+// Timestamps are CLOCK_MONOTONIC, which is shared by the runtime and the
+// container process (no time namespace is involved), so records taken on
+// both sides of the clone can be compared directly.
+struct phase_record
+{
+    std::string name;
+    std::string detail;
+    std::chrono::nanoseconds begin{ };
+    std::chrono::nanoseconds end{ };
+    phase_origin origin{ phase_origin::runtime };
+};
+
+[[nodiscard]] auto monotonic_now() noexcept -> std::chrono::nanoseconds;
+
+// NOTE: Like global_logger, the recorder is per-process and NOT thread-safe.
+// The container process inherits a copy of the runtime's recorder through
+// clone(2) and must call rebind() before recording anything of its own.
+class phase_recorder
+{
+public:
+    phase_recorder(const phase_recorder &) = delete;
+    phase_recorder(phase_recorder &&) noexcept = delete;
+    phase_recorder &operator=(const phase_recorder &) = delete;
+    phase_recorder &operator=(phase_recorder &&) = delete;
+    ~phase_recorder() noexcept = default;
+
+    static auto instance() noexcept -> phase_recorder &;
+
+    auto enable() noexcept -> void;
+
+    [[nodiscard]] auto enabled() const noexcept -> bool { return enabled_; }
+
+    [[nodiscard]] auto epoch() const noexcept -> std::chrono::nanoseconds { return epoch_; }
+
+    // Drop inherited records and tag all further records with origin.
+    auto rebind(phase_origin origin) noexcept -> void;
+
+    auto record(std::string_view name,
+                std::string_view detail,
+                std::chrono::nanoseconds begin,
+                std::chrono::nanoseconds end) noexcept -> void;
+
+    auto merge(std::vector<phase_record> records) noexcept -> void;
+
+    // Move out everything recorded so far, used to ship child records to the runtime.
+    [[nodiscard]] auto take() noexcept -> std::vector<phase_record>;
+
+    [[nodiscard]] auto records() const noexcept -> span<const phase_record> { return records_; }
+
+private:
+    phase_recorder() noexcept = default;
+
+    std::vector<phase_record> records_;
+    std::chrono::nanoseconds epoch_{ };
+    phase_origin origin_{ phase_origin::runtime };
+    bool enabled_{ false };
+};
+
+// Records [construction, destruction) as one phase when the recorder is enabled.
+// name and detail must outlive the scope.
+class phase_scope
+{
+public:
+    explicit phase_scope(std::string_view name, std::string_view detail = { }) noexcept;
+
+    phase_scope(const phase_scope &) = delete;
+    phase_scope(phase_scope &&) noexcept = delete;
+    phase_scope &operator=(const phase_scope &) = delete;
+    phase_scope &operator=(phase_scope &&) = delete;
+
+    ~phase_scope() noexcept;
+
+private:
+    std::string_view name;
+    std::string_view detail;
+    std::chrono::nanoseconds begin{ };
+};
+
+// Write the startup breakdown as JSON, phases are sorted by their begin time
+// and expressed relative to the recorder epoch.
+auto write_phase_report(const std::filesystem::path &path, const phase_recorder &recorder) -> void;
+
+// Write every recorded phase as a Chrome trace-event file (JSON object format),
+// loadable by chrome://tracing and Perfetto. Runtime and container phases are
+// reported as two processes so nested spans line up per side.
+auto write_trace_events(const std::filesystem::path &path, const phase_recorder &recorder) -> void;
+
+} // namespace linyaps_box::utils
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/cgroup_stats.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+using linyaps_box::cgroup_sampler;
+using linyaps_box::parse_flat_keyed;
+using linyaps_box::parse_nested_keyed;
+
+TEST(CgroupStats, FlatKeyed)
+{
+    const auto j = parse_flat_keyed("usage_usec 1200\nuser_usec 1000\nsystem_usec 200\n");
+    EXPECT_EQ(j["usage_usec"], 1200U);
+    EXPECT_EQ(j["user_usec"], 1000U);
+    EXPECT_EQ(j["system_usec"], 200U);
+    EXPECT_EQ(j.size(), 3U);
+}
+
+TEST(CgroupStats, NestedKeyed)
+{
+    const auto io = parse_nested_keyed("8:0 rbytes=4096 wbytes=0 rios=1 wios=0\n"
+                                       "253:1 rbytes=0 wbytes=512 rios=0 wios=1\n");
+    EXPECT_EQ(io["8:0"]["rbytes"], 4096U);
+    EXPECT_EQ(io["253:1"]["wios"], 1U);
+
+    const auto pressure = parse_nested_keyed("some avg10=1.50 avg60=0.00 avg300=0.00 total=42\n"
+                                             "full avg10=0.00 avg60=0.00 avg300=0.00 total=7\n");
+    EXPECT_DOUBLE_EQ(pressure["some"]["avg10"].get<double>(), 1.5);
+    EXPECT_EQ(pressure["some"]["total"], 42U);
+    EXPECT_EQ(pressure["full"]["total"], 7U);
+}
+
+TEST(CgroupStats, SamplerRereadsOpenFiles)
+{
+    const auto dir = std::filesystem::temp_directory_path()
+      / ("ll-box-cgroup-stats-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+
+    const auto write = [&dir](const char *name, std::string_view content) {
+        std::ofstream ofs(dir / name, std::ios::out | std::ios::trunc);
+        ofs << content;
+    };
+
+    write("memory.current", "4096\n");
+    write("cpu.stat", "usage_usec 10\n");
+
+    cgroup_sampler sampler{ dir };
+    auto j = sampler.sample();
+    EXPECT_EQ(j["memory"]["current"], 4096U);
+    EXPECT_EQ(j["cpu"]["usage_usec"], 10U);
+    EXPECT_FALSE(j.contains("pids"));
+
+    // truncated in place, the sampler keeps its descriptors
+    write("memory.current", "8192\n");
+    write("pids.current", "3\n");
+    j = sampler.sample();
+    EXPECT_EQ(j["memory"]["current"], 8192U);
+    EXPECT_FALSE(j.contains("pids"));
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/config/parser.h"
+#include "linyaps_box/impl/cgroupfs_manager.h"
+#include "linyaps_box/utils/cgroups.h"
+
+#include <array>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using files_t = std::vector<std::pair<std::string, std::string>>;
+
+auto convert(std::string_view resources) -> files_t
+{
+    const auto config = linyaps_box::config::parse_streaming(
+      R"({"ociVersion": "1.0.2", "linux": {"resources": )" + std::string{ resources } + "}}");
+    return linyaps_box::to_cgroup_v2_files(config.linux->resources.value());
+}
+
+} // namespace
+
+TEST(Cgroupfs, ConvertResources)
+{
+    const auto files = convert(R"({
+        "memory": {"limit": 536870912, "reservation": 268435456, "swap": 1073741824},
+        "cpu": {"shares": 1024, "quota": 50000, "period": 100000, "cpus": "0-2,5", "mems": "0"},
+        "pids": {"limit": 32},
+        "blockIO": {"weight": 500,
+                    "weightDevice": [{"major": 8, "minor": 0, "weight": 1000}],
+                    "throttleReadBpsDevice": [{"major": 8, "minor": 0, "rate": 600}],
+                    "throttleWriteIOPSDevice": [{"major": 8, "minor": 16, "rate": 30}]},
+        "hugepageLimits": [{"pageSize": "2MB", "limit": 209715200}]
+    })");
+
+    const files_t expected = {
+        { "cpuset.cpus", "0,1,2,5" },
+        { "cpuset.mems", "0" },
+        { "cpu.weight", "39" },
+        { "cpu.max", "50000 100000" },
+        { "memory.low", "268435456" },
+        { "memory.max", "536870912" },
+        { "memory.swap.max", "536870912" },
+        { "pids.max", "32" },
+        { "io.weight", "default 4950" },
+        { "io.weight", "8:0 10000" },
+        { "io.max", "8:0 rbps=600" },
+        { "io.max", "8:16 wiops=30" },
+        { "hugetlb.2MB.max", "209715200" },
+    };
+    EXPECT_EQ(files, expected);
+}
+
+TEST(Cgroupfs, UnlimitedValues)
+{
+    const auto files = convert(R"({
+        "memory": {"limit": -1, "swap": -1},
+        "cpu": {"quota": -1},
+        "pids": {"limit": 0}
+    })");
+
+    const files_t expected = {
+        { "cpu.max", "max" },
+        { "memory.max", "max" },
+        { "memory.swap.max", "max" },
+        { "pids.max", "max" },
+    };
+    EXPECT_EQ(files, expected);
+}
+
+TEST(Cgroupfs, UnifiedComesLast)
+{
+    const auto files = convert(R"({"unified": {"memory.high": "max"}, "pids": {"limit": 1}})");
+    ASSERT_EQ(files.size(), 2U);
+    EXPECT_EQ(files.back(), (std::pair<std::string, std::string>{ "memory.high", "max" }));
+}
+
+TEST(Cgroupfs, RejectsWhatV2CanNotExpress)
+{
+    EXPECT_THROW(std::ignore = convert(R"({"memory": {"swap": 100}})"), std::invalid_argument);
+    EXPECT_THROW(std::ignore = convert(R"({"memory": {"limit": 200, "swap": 100}})"),
+                 std::invalid_argument);
+    EXPECT_THROW(std::ignore = convert(R"({"cpu": {"realtimeRuntime": 100}})"),
+                 std::invalid_argument);
+    EXPECT_THROW(std::ignore = convert(R"({"unified": {"../memory.max": "1"}})"),
+                 std::invalid_argument);
+}
+
+TEST(Cgroupfs, ReadsFrozenState)
+{
+    const auto dir = std::filesystem::temp_directory_path()
+      / ("ll-box-cgroupfs-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+
+    EXPECT_FALSE(linyaps_box::utils::is_cgroup_frozen(dir));
+
+    std::ofstream{ dir / "cgroup.events" } << "populated 1\nfrozen 1\n";
+    EXPECT_TRUE(linyaps_box::utils::is_cgroup_frozen(dir));
+
+    std::ofstream{ dir / "cgroup.events" } << "populated 1\nfrozen 0\n";
+    EXPECT_FALSE(linyaps_box::utils::is_cgroup_frozen(dir));
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+TEST(Cgroupfs, UpdateOfPeriodKeepsQuota)
+{
+    const auto dir = std::filesystem::temp_directory_path()
+      / ("ll-box-cgroupfs-update-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    std::ofstream{ dir / "cpu.max" } << "50000 100000\n";
+
+    linyaps_box::oci_config::linux_t::resources_t resources;
+    resources.cpu.emplace();
+    resources.cpu->period = 200000;
+    linyaps_box::update_cgroup_v2(dir, resources);
+
+    std::string content;
+    std::getline(std::ifstream{ dir / "cpu.max" }, content);
+    EXPECT_EQ(content, "50000 200000");
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+TEST(Cgroupfs, UpdateOfQuotaKeepsPeriod)
+{
+    const auto dir = std::filesystem::temp_directory_path()
+      / ("ll-box-cgroupfs-update-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    std::ofstream{ dir / "cpu.max" } << "50000 200000\n";
+
+    linyaps_box::oci_config::linux_t::resources_t resources;
+    resources.cpu.emplace();
+    resources.cpu->quota = 30000;
+    linyaps_box::update_cgroup_v2(dir, resources);
+
+    // Only the quota is written. Like the kernel, the file is not truncated,
+    // so the period stays as long as nothing overwrites it.
+    std::string content;
+    std::getline(std::ifstream{ dir / "cpu.max" }, content);
+    EXPECT_EQ(content, "30000 200000");
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+// A process in a grandchild cgroup must not keep the cgroup alive, and the child
+// cgroups have to go before their parents.
+TEST(Cgroupfs, DestroyRemovesNestedCgroups)
+{
+    std::filesystem::path cgroup;
+    try {
+        cgroup = linyaps_box::utils::get_unified_cgroup_root()
+          / linyaps_box::utils::get_own_unified_cgroup().relative_path()
+          / ("ll-box-destroy-" + std::to_string(::getpid()));
+    } catch (const std::exception &e) {
+        GTEST_SKIP() << "no cgroup v2 hierarchy: " << e.what();
+    }
+
+    if (::mkdir(cgroup.c_str(), 0755) != 0) {
+        GTEST_SKIP() << "can not create " << cgroup << ": " << std::strerror(errno);
+    }
+
+    const auto leaf = cgroup / "a" / "b";
+    std::filesystem::create_directories(leaf);
+    std::filesystem::create_directories(cgroup / "c");
+
+    std::array<int, 2> ready{ };
+    ASSERT_EQ(::pipe(ready.data()), 0);
+    const auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        std::ofstream{ leaf / "cgroup.procs" } << ::getpid() << std::flush;
+        std::ignore = ::write(ready[1], "x", 1);
+        while (true) {
+            ::pause();
+        }
+    }
+
+    ::close(ready[1]);
+    char ch{ };
+    ASSERT_EQ(::read(ready[0], &ch, 1), 1);
+    ::close(ready[0]);
+
+    EXPECT_NO_THROW(linyaps_box::destroy_cgroup_v2(cgroup));
+    EXPECT_FALSE(std::filesystem::exists(cgroup));
+
+    ::kill(pid, SIGKILL);
+    int status{ };
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFSIGNALED(status));
+
+    std::error_code ec;
+    for (const auto &dir : { leaf, leaf.parent_path(), cgroup / "c", cgroup }) {
+        std::filesystem::remove(dir, ec);
+    }
+}
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/config/cache.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+
+namespace config = linyaps_box::config;
+using linyaps_box::oci_config;
+
+constexpr auto sample_config = R"({
+    "ociVersion": "1.0.2",
+    "hostname": "box",
+    "process": {
+        "terminal": false,
+        "cwd": "/",
+        "args": ["/bin/sh", "-c", "true"],
+        "env": ["PATH=/usr/bin"],
+        "user": { "uid": 0, "gid": 0, "additionalGids": [1, 2] },
+        "rlimits": [ { "type": "RLIMIT_NOFILE", "hard": 1024, "soft": 512 } ]
+    },
+    "root": { "path": "rootfs", "readonly": true },
+    "mounts": [
+        { "destination": "/proc", "type": "proc", "source": "proc" },
+        { "destination": "/tmp", "type": "tmpfs", "source": "tmpfs",
+          "options": ["nosuid", "size=65536k", "rprivate"] }
+    ],
+    "linux": {
+        "namespaces": [ { "type": "mount" }, { "type": "pid" }, { "type": "network" } ],
+        "maskedPaths": ["/proc/kcore"],
+        "sysctl": { "net.ipv4.ip_forward": "1" }
+    },
+    "annotations": { "org.example.key": "value" }
+})";
+
+class ConfigCacheTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override
+    {
+        dir = std::filesystem::temp_directory_path()
+          / ("ll-box-config-cache-" + std::to_string(::getpid()));
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    auto write_config(std::string_view content) const -> std::filesystem::path
+    {
+        auto path = dir / "config.json";
+        std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+        ofs << content;
+        ofs.close();
+
+        // keep the cache strictly newer than the config on coarse timestamps
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+        return path;
+    }
+};
+
+} // namespace
+
+TEST_F(ConfigCacheTest, RoundTrip)
+{
+    const auto expected = oci_config::parse(std::string_view{ sample_config });
+    const auto bytes = config::serialize(expected);
+    const auto actual = config::deserialize(bytes);
+
+    EXPECT_EQ(config::serialize(actual), bytes);
+
+    ASSERT_TRUE(actual.process.has_value());
+    EXPECT_EQ(actual.process->args, expected.process->args);
+    EXPECT_EQ(actual.process->user.additional_gids, expected.process->user.additional_gids);
+    ASSERT_TRUE(actual.process->rlimits.has_value());
+    EXPECT_EQ(actual.process->rlimits->front().soft, 512U);
+    EXPECT_EQ(actual.hostname, "box");
+    ASSERT_EQ(actual.mounts.size(), expected.mounts.size());
+    EXPECT_EQ(actual.mounts[1].destination, "/tmp");
+    EXPECT_EQ(actual.mounts[1].vfs_flags, expected.mounts[1].vfs_flags);
+    EXPECT_EQ(actual.mounts[1].data, expected.mounts[1].data);
+    ASSERT_TRUE(actual.linux.has_value());
+    EXPECT_EQ(actual.linux->sysctl, expected.linux->sysctl);
+    ASSERT_TRUE(actual.root.has_value());
+    EXPECT_TRUE(actual.root->readonly);
+    EXPECT_EQ(actual.annotations, expected.annotations);
+}
+
+TEST_F(ConfigCacheTest, MalformedDataThrows)
+{
+    const auto bytes =
+      config::serialize(oci_config::parse(std::string_view{ sample_config }));
+
+    for (auto size : { std::size_t{ 0 }, std::size_t{ 1 }, bytes.size() / 2, bytes.size() - 1 }) {
+        EXPECT_THROW(std::ignore = config::deserialize({ bytes.data(), size }), std::runtime_error)
+          << "size " << size;
+    }
+
+    auto trailing = bytes;
+    trailing.push_back(std::byte{ 0 });
+    EXPECT_THROW(std::ignore = config::deserialize(trailing), std::runtime_error);
+}
+
+TEST_F(ConfigCacheTest, ParseCachedReusesCache)
+{
+    const auto path = write_config(sample_config);
+    const auto cache = dir / "cache" / "config.bin";
+
+    auto first = config::parse_cached(path, cache);
+    ASSERT_TRUE(std::filesystem::exists(cache));
+    const auto cached_at = std::filesystem::last_write_time(cache);
+
+    auto second = config::parse_cached(path, cache);
+    EXPECT_EQ(std::filesystem::last_write_time(cache), cached_at);
+    EXPECT_EQ(config::serialize(first), config::serialize(second));
+}
+
+TEST_F(ConfigCacheTest, ParseCachedDetectsChange)
+{
+    const auto cache = dir / "config.bin";
+    std::ignore = config::parse_cached(write_config(sample_config), cache);
+
+    std::string changed{ sample_config };
+    changed.replace(changed.find("\"box\""), 5, "\"other\"");
+    const auto result = config::parse_cached(write_config(changed), cache);
+    EXPECT_EQ(result.hostname, "other");
+}
+
+TEST_F(ConfigCacheTest, ParseCachedIgnoresBrokenCache)
+{
+    const auto cache = dir / "config.bin";
+    {
+        std::ofstream ofs(cache);
+        ofs << "garbage";
+    }
+
+    const auto result = config::parse_cached(write_config(sample_config), cache);
+    EXPECT_EQ(result.hostname, "box");
+}
+
+TEST_F(ConfigCacheTest, ParseCachedRejectsInvalidConfig)
+{
+    const auto cache = dir / "config.bin";
+    EXPECT_ANY_THROW(std::ignore = config::parse_cached(write_config("{}"), cache));
+    EXPECT_FALSE(std::filesystem::exists(cache));
+}
+
+TEST_F(ConfigCacheTest, SharedCacheIsPruned)
+{
+    const auto shared = dir / "shared";
+    std::filesystem::create_directories(shared);
+    const auto now = std::filesystem::file_time_type::clock::now();
+    for (int i = 0; i < 4; ++i) {
+        const auto stale = shared / ("stale-" + std::to_string(i) + ".bin");
+        std::ofstream(stale) << "x";
+        std::filesystem::last_write_time(stale, now - std::chrono::hours{ 4 - i });
+    }
+
+    // storing a new entry evicts the least recently written ones
+    std::ignore = config::parse_cached(write_config(sample_config), shared / "config.bin", 3);
+    EXPECT_TRUE(std::filesystem::exists(shared / "config.bin"));
+    EXPECT_TRUE(std::filesystem::exists(shared / "stale-3.bin"));
+    EXPECT_TRUE(std::filesystem::exists(shared / "stale-2.bin"));
+    EXPECT_FALSE(std::filesystem::exists(shared / "stale-1.bin"));
+    EXPECT_FALSE(std::filesystem::exists(shared / "stale-0.bin"));
+
+    // a cache hit stores nothing and leaves the directory alone
+    std::ofstream(shared / "late.bin") << "x";
+    std::ignore = config::parse_cached(dir / "config.json", shared / "config.bin", 3);
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator{ shared },
+                            std::filesystem::directory_iterator{ }),
+              4);
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/container_status.h"
+#include "linyaps_box/utils/process_stat.h"
+
+#include <filesystem>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using linyaps_box::container_status;
+using linyaps_box::runtime_status;
+
+auto self_status() -> container_status
+{
+    container_status status{ };
+    status.id = "test";
+    status.pid = ::getpid();
+    status.process_start_time = linyaps_box::utils::read_process_start_time(status.pid).value();
+    return status;
+}
+
+} // namespace
+
+TEST(ContainerStatus, ExecFifoRoundTrip)
+{
+    auto status = self_status();
+    status.exec_fifo = "/run/ll-box/test/exec.fifo";
+
+    const auto actual = nlohmann::json(status).get<container_status>();
+    EXPECT_EQ(actual.exec_fifo, status.exec_fifo);
+
+    status.exec_fifo.clear();
+    const auto json = nlohmann::json(status);
+    EXPECT_FALSE(json.contains("exec-fifo"));
+    EXPECT_TRUE(json.get<container_status>().exec_fifo.empty());
+}
+
+TEST(ContainerStatus, CreatedUntilExecFifoIsRemoved)
+{
+    auto status = self_status();
+    EXPECT_EQ(linyaps_box::derive_status(status), runtime_status::RUNNING);
+
+    status.exec_fifo = std::filesystem::temp_directory_path()
+      / ("ll-box-exec-fifo-" + std::to_string(::getpid()));
+    ASSERT_EQ(::mkfifo(status.exec_fifo.c_str(), 0600), 0);
+    EXPECT_EQ(linyaps_box::derive_status(status), runtime_status::CREATED);
+
+    std::filesystem::remove(status.exec_fifo);
+    EXPECT_EQ(linyaps_box::derive_status(status), runtime_status::RUNNING);
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/container_monitor.h"
+
+#include <cerrno>
+#include <csignal>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+
+using linyaps_box::query_monitor;
+using linyaps_box::infra::unix_socket;
+
+class QueryMonitorTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override
+    {
+        dir = std::filesystem::temp_directory_path()
+          / ("ll-box-control-" + std::to_string(::getpid()));
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    // Accept one connection on socket and answer its request with reply.
+    [[nodiscard]] static auto serve_once(const unix_socket &listener, std::string reply)
+      -> std::thread
+    {
+        return std::thread([&listener, reply = std::move(reply)]() {
+            auto conn = listener.accept();
+            std::string buffer(4096, '\0');
+            auto bytes = conn->recv(linyaps_box::utils::as_writable_bytes(
+              linyaps_box::utils::span(buffer)));
+            ASSERT_TRUE(bytes && *bytes > 0);
+            buffer.resize(*bytes);
+            EXPECT_EQ(nlohmann::json::parse(buffer).at("op"), "kill");
+            std::ignore = conn->send(linyaps_box::utils::as_bytes(linyaps_box::utils::span(reply)));
+        });
+    }
+};
+
+} // namespace
+
+TEST_F(QueryMonitorTest, NoMonitor)
+{
+    EXPECT_FALSE(query_monitor(dir / "control.sock", { { "op", "state" } }));
+
+    // left behind by a monitor that died
+    {
+        auto listener = unix_socket::listen(dir / "control.sock");
+    }
+    EXPECT_FALSE(query_monitor(dir / "control.sock", { { "op", "state" } }));
+}
+
+TEST_F(QueryMonitorTest, Reply)
+{
+    auto listener = unix_socket::listen(dir / "control.sock");
+    auto server = serve_once(listener, "{}");
+
+    auto reply = query_monitor(dir / "control.sock", { { "op", "kill" }, { "signal", 0 } });
+    server.join();
+
+    ASSERT_TRUE(reply);
+    EXPECT_EQ(*reply, nlohmann::json::object());
+}
+
+TEST_F(QueryMonitorTest, GarbageReply)
+{
+    auto listener = unix_socket::listen(dir / "control.sock");
+    auto server = serve_once(listener, R"({"status": {"id": "trunc)");
+
+    EXPECT_FALSE(query_monitor(dir / "control.sock", { { "op", "kill" }, { "signal", 0 } }));
+    server.join();
+}
+
+TEST_F(QueryMonitorTest, Error)
+{
+    auto listener = unix_socket::listen(dir / "control.sock");
+    auto server = serve_once(listener, R"({"error": "no such process", "errno": 3})");
+
+    try {
+        std::ignore =
+          query_monitor(dir / "control.sock", { { "op", "kill" }, { "signal", SIGTERM } });
+        ADD_FAILURE() << "expected std::system_error";
+    } catch (const std::system_error &e) {
+        EXPECT_EQ(e.code().value(), ESRCH);
+    }
+    server.join();
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/os/kernel_constants.h"
+#include "linyaps_box/os/mount.h"
+#include "linyaps_box/utils/idmap.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+TEST(Idmap, FormatIdMappings)
+{
+    const std::vector<linyaps_box::oci_config::id_mapping_t> mappings{ { 1000, 0, 1 },
+                                                                       { 100000, 1, 65536 } };
+    EXPECT_EQ(linyaps_box::utils::format_id_mappings(mappings), "0 1000 1\n1 100000 65536\n");
+    EXPECT_EQ(linyaps_box::utils::format_id_mappings({ }), "");
+}
+
+// The host ids of the mappings are ours: a file owned by root shows up with
+// host id 1000 through a mount idmapped with "0 1000 1".
+TEST(Idmap, IdmappedTreeUsesHostIds)
+{
+    if (::geteuid() != 0 || !linyaps_box::os::new_mount_api_supported()) {
+        GTEST_SKIP() << "needs root and the new mount API";
+    }
+
+    const auto dir = std::filesystem::temp_directory_path()
+      / ("ll-box-idmap-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "file") << "x";
+    ASSERT_EQ(::chown((dir / "file").c_str(), 0, 0), 0);
+
+    linyaps_box::utils::file_descriptor userns;
+    try {
+        userns = linyaps_box::utils::create_idmap_userns("0 1000 1\n", "0 2000 1\n");
+    } catch (const std::exception &e) {
+        std::filesystem::remove_all(dir);
+        GTEST_SKIP() << "no user namespaces: " << e.what();
+    }
+
+    linyaps_box::utils::file_descriptor source{ ::open(dir.c_str(), O_PATH | O_CLOEXEC), true };
+    ASSERT_GE(source.get(), 0);
+    auto tree = linyaps_box::os::open_tree_clone(source.ref(), false);
+    ASSERT_TRUE(tree);
+
+    linyaps_box::os::sys::mount_attr attr{ };
+    attr.attr_set = linyaps_box::os::sys::mount_attr_idmap;
+    attr.userns_fd = static_cast<uint64_t>(userns.get());
+    auto ret = linyaps_box::os::mount_setattr(tree->ref(), attr, false);
+    if (!ret) {
+        std::filesystem::remove_all(dir);
+        GTEST_SKIP() << "the filesystem can not be idmapped: " << ret.error().message();
+    }
+
+    struct stat st{ };
+    EXPECT_EQ(::fstatat(tree->get(), "file", &st, 0), 0);
+    EXPECT_EQ(st.st_uid, 1000U);
+    EXPECT_EQ(st.st_gid, 2000U);
+
+    std::filesystem::remove_all(dir);
+}
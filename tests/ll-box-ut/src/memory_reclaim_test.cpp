@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/memory_reclaim.h"
+
+namespace {
+
+using annotations_t = std::unordered_map<std::string, std::string>;
+
+constexpr auto trigger = "cn.org.linyaps.runtime.memory_reclaim.trigger";
+constexpr auto step = "cn.org.linyaps.runtime.memory_reclaim.step";
+
+} // namespace
+
+TEST(MemoryReclaim, DisabledWithoutTrigger)
+{
+    EXPECT_FALSE(linyaps_box::parse_memory_reclaim_policy({ }).has_value());
+    EXPECT_FALSE(
+      linyaps_box::parse_memory_reclaim_policy(annotations_t{ { step, "1M" } }).has_value());
+}
+
+TEST(MemoryReclaim, ParsePolicy)
+{
+    auto policy =
+      linyaps_box::parse_memory_reclaim_policy(annotations_t{ { trigger, "some 150ms 1s" } });
+    ASSERT_TRUE(policy.has_value());
+    EXPECT_EQ(linyaps_box::to_psi_trigger(*policy), "some 150000 1000000");
+    EXPECT_EQ(policy->step, "64M");
+
+    policy = linyaps_box::parse_memory_reclaim_policy(
+      annotations_t{ { trigger, "full 50000 2s" }, { step, "128M" } });
+    ASSERT_TRUE(policy.has_value());
+    EXPECT_EQ(linyaps_box::to_psi_trigger(*policy), "full 50000 2000000");
+    EXPECT_EQ(policy->step, "128M");
+}
+
+TEST(MemoryReclaim, RejectsMalformedPolicy)
+{
+    for (const auto *value : { "", "some", "some 1s", "any 1ms 1s", "some 2s 1s", "some 0 1s",
+                               "some 1h 2h", "some 1ms 1s extra" }) {
+        EXPECT_THROW(std::ignore = linyaps_box::parse_memory_reclaim_policy(
+                       annotations_t{ { trigger, value } }),
+                     std::invalid_argument)
+          << value;
+    }
+
+    for (const auto *value : { "", "0", "1T", "M", "-1" }) {
+        EXPECT_THROW(std::ignore = linyaps_box::parse_memory_reclaim_policy(
+                       annotations_t{ { trigger, "some 150ms 1s" }, { step, value } }),
+                     std::invalid_argument)
+          << value;
+    }
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/config.h"
+#include "linyaps_box/config/parser.h"
+#include "linyaps_box/utils/mempolicy.h"
+
+#include <string>
+
+namespace {
+
+auto config_with(std::string_view policy) -> std::string
+{
+    return R"({"ociVersion": "1.0.2", "root": {"path": "rootfs"}, "linux": {"memoryPolicy": )"
+      + std::string{ policy } + "}}";
+}
+
+auto mode_of(std::string_view policy) -> int
+{
+    const auto config = linyaps_box::config::parse_streaming(config_with(policy));
+    return linyaps_box::utils::to_mempolicy_mode(config.linux->memory_policy.value());
+}
+
+} // namespace
+
+TEST(MemPolicy, ModeAndFlags)
+{
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_DEFAULT"})"), 0);
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_PREFERRED", "nodes": "0"})"), 1);
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_BIND", "nodes": "0",
+                          "flags": ["MPOL_F_NUMA_BALANCING"]})"),
+              2 | (1 << 13));
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_INTERLEAVE", "nodes": "0",
+                          "flags": ["MPOL_F_STATIC_NODES"]})"),
+              3 | (1 << 15));
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_LOCAL"})"), 4);
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_PREFERRED_MANY", "nodes": "0",
+                          "flags": ["MPOL_F_RELATIVE_NODES"]})"),
+              5 | (1 << 14));
+    EXPECT_EQ(mode_of(R"({"mode": "MPOL_WEIGHTED_INTERLEAVE", "nodes": "0"})"), 6);
+}
+
+TEST(MemPolicy, Validate)
+{
+    const auto parse = [](std::string_view policy) {
+        std::ignore = linyaps_box::oci_config::parse(std::string_view{ config_with(policy) });
+    };
+
+    // node 0 is online everywhere
+    EXPECT_NO_THROW(parse(R"({"mode": "MPOL_BIND", "nodes": "0"})"));
+    EXPECT_NO_THROW(parse(R"({"mode": "MPOL_PREFERRED"})"));
+
+    EXPECT_ANY_THROW(parse(R"({"mode": "MPOL_BIND"})"));
+    EXPECT_ANY_THROW(parse(R"({"mode": "MPOL_DEFAULT", "nodes": "0"})"));
+    // checked when applied, not by the validation a cached config skips
+    EXPECT_NO_THROW(parse(R"({"mode": "MPOL_BIND", "nodes": "1023"})"));
+    EXPECT_ANY_THROW(parse(R"({"mode": "MPOL_BIND", "nodes": "0",
+                               "flags": ["MPOL_F_STATIC_NODES", "MPOL_F_RELATIVE_NODES"]})"));
+    EXPECT_ANY_THROW(parse(R"({"mode": "MPOL_INTERLEAVE", "nodes": "0",
+                               "flags": ["MPOL_F_NUMA_BALANCING"]})"));
+}
+
+TEST(MemPolicy, ApplyRejectsOfflineNodes)
+{
+    const auto config = linyaps_box::config::parse_streaming(
+      config_with(R"({"mode": "MPOL_BIND", "nodes": "1023"})"));
+
+    // refused before set_mempolicy(2), the policy of the test stays untouched
+    EXPECT_THROW(linyaps_box::utils::apply_memory_policy(config.linux->memory_policy.value()),
+                 std::runtime_error);
+}
@@ -14,6 +14,8 @@
 #include "linyaps_box/utils/span.h"
 
 #include <chrono>
+#include <cstring>
+#include <limits>
 #include <optional>
 #include <thread>
 
@@ -155,15 +157,16 @@ class SerializeStageTest : public ::testing::TestWithParam<proto::stage::type>
 
 TEST_P(SerializeStageTest, RoundTrip)
 {
-    msg::stage original{ GetParam() };
+    msg::stage original{ GetParam(), { } };
     auto bytes = msg::serialize(msg::message{ original });
     auto deserialized = msg::deserialize(bytes);
 
     ASSERT_TRUE(std::holds_alternative<msg::stage>(deserialized));
     EXPECT_EQ(std::get<msg::stage>(deserialized).value, GetParam());
 
-    // wire format: [msg_id(1)][stage_value(1)]
-    EXPECT_EQ(bytes.size(), sizeof(proto::msg_id) + sizeof(proto::stage::type));
+    // wire format: [msg_id(1)][stage_value(1)][phase_count(4)]
+    EXPECT_EQ(bytes.size(),
+              sizeof(proto::msg_id) + sizeof(proto::stage::type) + sizeof(uint32_t));
     EXPECT_EQ(bytes[0], static_cast<std::byte>(proto::msg_id::stage));
     EXPECT_EQ(
       bytes[1],
@@ -179,8 +182,53 @@ INSTANTIATE_TEST_SUITE_P(All,
                                            proto::stage::type::createruntime_ready,
                                            proto::stage::type::createruntime_done,
                                            proto::stage::type::createcontainer_done,
+                                           proto::stage::type::created,
                                            proto::stage::type::exec_ready));
 
+TEST(MessageChannel, SerializeStageWithPhases)
+{
+    msg::stage original{ proto::stage::type::exec_ready, { } };
+    original.phases.push_back({ "mount",
+                                "/proc",
+                                std::chrono::nanoseconds{ 100 },
+                                std::chrono::nanoseconds{ 250 },
+                                linyaps_box::utils::phase_origin::container });
+    original.phases.push_back({ "pivot_root",
+                                "",
+                                std::chrono::nanoseconds{ 300 },
+                                std::chrono::nanoseconds{ 400 },
+                                linyaps_box::utils::phase_origin::container });
+
+    auto bytes = msg::serialize(msg::message{ original });
+    auto deserialized = msg::deserialize(bytes);
+
+    ASSERT_TRUE(std::holds_alternative<msg::stage>(deserialized));
+    const auto &d = std::get<msg::stage>(deserialized);
+    EXPECT_EQ(d.value, proto::stage::type::exec_ready);
+    ASSERT_EQ(d.phases.size(), 2U);
+    EXPECT_EQ(d.phases[0].name, "mount");
+    EXPECT_EQ(d.phases[0].detail, "/proc");
+    EXPECT_EQ(d.phases[0].begin, std::chrono::nanoseconds{ 100 });
+    EXPECT_EQ(d.phases[0].end, std::chrono::nanoseconds{ 250 });
+    EXPECT_EQ(d.phases[0].origin, linyaps_box::utils::phase_origin::container);
+    EXPECT_EQ(d.phases[1].name, "pivot_root");
+    EXPECT_TRUE(d.phases[1].detail.empty());
+    EXPECT_EQ(d.phases[1].end, std::chrono::nanoseconds{ 400 });
+}
+
+TEST(MessageChannel, StagePhaseCountOverflowThrows)
+{
+    msg::stage original{ proto::stage::type::namespace_ready, { } };
+    auto bytes = msg::serialize(msg::message{ original });
+
+    // claim far more phases than the payload can hold
+    const auto count = std::numeric_limits<uint32_t>::max();
+    std::memcpy(bytes.data() + sizeof(proto::msg_id) + sizeof(proto::stage::type),
+                &count,
+                sizeof(count));
+    EXPECT_THROW(std::ignore = msg::deserialize(bytes), std::runtime_error);
+}
+
 TEST(MessageChannel, SerializeLog)
 {
     auto now = std::chrono::system_clock::now().time_since_epoch();
@@ -265,7 +313,7 @@ TEST(MessageChannel, SerializePidReport)
 TEST(MessageChannel, TakeFdEmptyThrows)
 {
     msg::datagram inc;
-    inc.body = msg::stage{ proto::stage::type::namespace_ready };
+    inc.body = msg::stage{ proto::stage::type::namespace_ready, { } };
     EXPECT_THROW(std::ignore = inc.take_fds(), std::runtime_error);
 }
 
@@ -309,6 +357,19 @@ TEST(MessageChannel, SerializeProceed)
     EXPECT_EQ(bytes[0], static_cast<std::byte>(proto::msg_id::proceed));
 }
 
+TEST(MessageChannel, SerializeMountFd)
+{
+    msg::mount_fd original{ 7 };
+    auto bytes = msg::serialize(msg::message{ original });
+    auto deserialized = msg::deserialize(bytes);
+
+    ASSERT_TRUE(std::holds_alternative<msg::mount_fd>(deserialized));
+    EXPECT_EQ(std::get<msg::mount_fd>(deserialized).index, 7U);
+
+    EXPECT_EQ(bytes.size(), sizeof(proto::msg_id) + sizeof(std::uint32_t));
+    EXPECT_EQ(bytes[0], static_cast<std::byte>(proto::msg_id::mount_fd));
+}
+
 // ── socketpair tests ───────────────────────────────────────────────
 
 TEST_F(ChannelTest, ChildToParentPidReport)
@@ -406,6 +467,19 @@ TEST_F(ChannelTest, WaitForExecWithExecReady)
     EXPECT_NO_THROW(parent.wait_for_close());
 }
 
+TEST_F(ChannelTest, ReadableOnStageOrClose)
+{
+    auto [parent, child] = proto::create_message_socketpair();
+    EXPECT_FALSE(parent.readable(std::chrono::milliseconds{ 10 }));
+
+    child.send_stage(proto::stage::type::exec_ready);
+    EXPECT_TRUE(parent.readable(std::chrono::milliseconds{ 0 }));
+    EXPECT_NO_THROW(parent.wait_for_stage(proto::stage::type::exec_ready));
+
+    child.close();
+    EXPECT_TRUE(parent.readable(std::chrono::milliseconds{ 0 }));
+}
+
 TEST_F(ChannelTest, WaitForExecFailedAfterReady)
 {
     auto saved = setup_logger_sink();
@@ -469,7 +543,7 @@ TEST(MessageChannel, FdsExceedLimitThrows)
         refs.emplace_back(fd.ref());
     }
 
-    msg::stage m{ proto::stage::type::namespace_ready };
+    msg::stage m{ proto::stage::type::namespace_ready, { } };
     EXPECT_THROW(t1.send(m, refs), std::logic_error);
 }
 
@@ -489,6 +563,22 @@ TEST_F(ChannelTest, SendRecvConsoleFd)
     ASSERT_FALSE(inc.fds.empty());
 }
 
+TEST_F(ChannelTest, SendRecvMountFd)
+{
+    linyaps_box::utils::file_descriptor dir{ ::open("/", O_PATH | O_CLOEXEC), true };
+    ASSERT_GE(dir.get(), 0);
+    parent->send_mount_fd(3, dir.ref());
+    parent->send_mount_fd(5, dir.ref());
+
+    auto fd = child->expect_mount_fd(3);
+    struct stat st{ };
+    ASSERT_EQ(fstat(fd.get(), &st), 0);
+    EXPECT_TRUE(S_ISDIR(st.st_mode));
+
+    // the entries are sent in the order of the mounts
+    EXPECT_THROW(std::ignore = child->expect_mount_fd(4), std::runtime_error);
+}
+
 TEST_F(ChannelTest, SendOnClosedSocketThrows)
 {
     auto [parent, child] = proto::create_message_socketpair();
@@ -513,7 +603,7 @@ TEST(MessageChannel, MaxFdsTransfer)
         refs.emplace_back(fd.ref());
     }
 
-    t1.send(msg::stage{ proto::stage::type::namespace_ready }, refs);
+    t1.send(msg::stage{ proto::stage::type::namespace_ready, { } }, refs);
 
     auto inc = t2.recv();
     ASSERT_TRUE(inc.has_value());
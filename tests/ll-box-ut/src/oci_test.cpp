@@ -1,67 +1,304 @@
-/*
- * SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
- *
- * SPDX-License-Identifier: LGPL-3.0-or-later
- */
+// SPDX-FileCopyrightText: 2022-2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include <gtest/gtest.h>
 
-#include "util/oci_runtime.h"
+#include "linyaps_box/config.h"
+#include "linyaps_box/config/cache.h"
+#include "linyaps_box/config/parser.h"
 
-using namespace linglong;
+#include <nlohmann/json.hpp>
 
-TEST(OCI, Runtime)
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
+namespace {
+
+namespace config = linyaps_box::config;
+using linyaps_box::oci_config;
+
+// The DOM based from_json overloads are the reference implementation.
+auto parse_dom(std::string_view content) -> oci_config
+{
+    auto ret = nlohmann::json::parse(content).get<oci_config>();
+
+    // never read by ll-box, the streaming parser skips them
+    if (ret.linux) {
+        ret.linux->intel_rdt.reset();
+        if (ret.linux->resources) {
+            ret.linux->resources->rdma.reset();
+        }
+    }
+
+    return ret;
+}
+
+auto try_parse_dom(std::string_view content) -> std::optional<oci_config>
+{
+    try {
+        return parse_dom(content);
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+// oci_config has no operator==, its canonical cache encoding covers every member.
+auto expect_same(std::string_view content) -> void
+{
+    const auto expected = parse_dom(content);
+    const auto actual = config::parse_streaming(content);
+    EXPECT_EQ(config::serialize(actual), config::serialize(expected)) << content;
+}
+
+auto read_file(const std::filesystem::path &path) -> std::string
+{
+    std::ifstream ifs(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{ } };
+}
+
+constexpr auto minimal = R"({"ociVersion": "1.0.2", "root": {"path": "rootfs"}})";
+
+} // namespace
+
+TEST(OCI, DemoConfigsMatchDom)
 {
-    auto r = linglong::fromFile("data/demo/config-mini.json");
+    const auto dir = std::filesystem::path{ LINYAPS_BOX_TEST_DATA_DIR } / "demo";
+    auto checked = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() != ".json") {
+            continue;
+        }
 
-    EXPECT_EQ(r.version, "1.0.1");
-    EXPECT_EQ(r.process.args[0], "/bin/bash");
-    EXPECT_EQ(r.process.env[1], "TERM=xterm");
+        SCOPED_TRACE(entry.path().filename().string());
+        const auto content = read_file(entry.path());
+        const auto expected = try_parse_dom(content);
+        if (!expected) {
+            EXPECT_ANY_THROW(std::ignore = config::parse_streaming(content));
+            continue;
+        }
 
-    EXPECT_EQ(r.mounts.has_value(), true);
-    EXPECT_TRUE(std::find(r.mounts->at(1).data.begin(), r.mounts->at(1).data.end(), "mode=755")
-                != r.mounts->at(1).data.end());
-    EXPECT_TRUE(std::find(r.mounts->at(1).data.begin(), r.mounts->at(1).data.end(), "size=65536k")
-                != r.mounts->at(1).data.end());
+        EXPECT_EQ(config::serialize(config::parse_streaming(content)),
+                  config::serialize(*expected));
+        ++checked;
+    }
 
-    EXPECT_EQ(r.hooks, std::nullopt);
+    EXPECT_GT(checked, 0);
+}
 
-    EXPECT_EQ(r.linux.namespaces.size(), 5);
+TEST(OCI, KeyOrderDoesNotMatter)
+{
+    // consoleSize precedes terminal, options precede uidMappings
+    expect_same(R"({
+        "process": {
+            "consoleSize": {"height": 24, "width": 80},
+            "terminal": true,
+            "user": {"uid": 1, "gid": 2, "umask": 18},
+            "args": ["sh"],
+            "cwd": "/"
+        },
+        "mounts": [{
+            "options": ["rbind", "ro", "nosuid", "rprivate", "mode=755"],
+            "uidMappings": [{"hostID": 1000, "containerID": 0, "size": 1}],
+            "destination": "/data",
+            "source": "/srv"
+        }],
+        "ociVersion": "1.0.2"
+    })");
 
-    EXPECT_EQ(r.linux.uidMappings.size(), 2);
-    EXPECT_EQ(r.linux.uidMappings.at(1).hostID, 1000);
-    EXPECT_EQ(r.linux.uidMappings.at(1).containerID, 1000);
-    EXPECT_EQ(r.linux.uidMappings.at(1).size, 1);
+    expect_same(R"({
+        "ociVersion": "1.0.2",
+        "process": {"consoleSize": {"height": 24, "width": 80}, "args": [], "cwd": "/"}
+    })");
+}
 
-    EXPECT_EQ(r.linux.gidMappings.size(), 2);
-    EXPECT_EQ(r.linux.gidMappings.at(0).hostID, 65534);
-    EXPECT_EQ(r.linux.gidMappings.at(0).containerID, 0);
-    EXPECT_EQ(r.linux.gidMappings.at(0).size, 1);
+TEST(OCI, MountMappingsWithOptions)
+{
+    constexpr auto content = R"({
+        "ociVersion": "1.0.2",
+        "mounts": [{
+            "destination": "/a", "source": "/srv", "options": ["rbind", "ridmap"],
+            "uidMappings": [{"hostID": 1000, "containerID": 0, "size": 1}],
+            "gidMappings": [{"hostID": 1000, "containerID": 0, "size": 1}]
+        }, {
+            "destination": "/b", "source": "/srv", "options": ["bind", "idmap=uids=0:2000:1"],
+            "uidMappings": [{"hostID": 1000, "containerID": 0, "size": 1}]
+        }]
+    })";
+    expect_same(content);
+
+    const auto config = config::parse_streaming(content);
+    ASSERT_EQ(config.mounts.size(), 2U);
+    EXPECT_EQ(config.mounts[0].idmap, oci_config::mount_t::idmap_type::RIDMAP);
+    ASSERT_TRUE(config.mounts[0].uid_mappings.has_value());
+    EXPECT_EQ(config.mounts[0].uid_mappings->front().host_id, 1000U);
+    ASSERT_TRUE(config.mounts[0].gid_mappings.has_value());
 
-    EXPECT_EQ(r.linux.seccomp->defaultAction, "SCMP_ACT_ALLOW");
-    EXPECT_EQ(r.linux.seccomp->architectures.size(), 2);
-    EXPECT_EQ(r.linux.seccomp->architectures[0], "SCMP_ARCH_X86");
-    EXPECT_EQ(r.linux.seccomp->architectures[1], "SCMP_ARCH_X32");
-    EXPECT_EQ(r.linux.seccomp->syscalls.size(), 1);
-    EXPECT_EQ(r.linux.seccomp->syscalls[0].names.size(), 2);
-    EXPECT_EQ(r.linux.seccomp->syscalls[0].action, "SCMP_ACT_ERRNO");
+    // inline mappings win
+    ASSERT_TRUE(config.mounts[1].uid_mappings.has_value());
+    EXPECT_EQ(config.mounts[1].uid_mappings->front().host_id, 2000U);
+}
 
-    EXPECT_EQ(r.linux.resources.cpu.shares, 512);
+TEST(OCI, FullLinuxSection)
+{
+    expect_same(R"({
+        "ociVersion": "1.2.0",
+        "hostname": "box",
+        "domainname": "example.org",
+        "process": {
+            "terminal": false,
+            "cwd": "/root",
+            "args": ["/bin/sh", "-c", "echo \"hi\"\tthere\n"],
+            "env": ["A=é中😀", "B=\/\\"],
+            "rlimits": [{"type": "RLIMIT_NOFILE", "hard": 1024, "soft": 512}],
+            "noNewPrivileges": true,
+            "oomScoreAdj": -100,
+            "apparmorProfile": null,
+            "scheduler": {"policy": "SCHED_FIFO", "priority": 10,
+                          "flags": ["SCHED_FLAG_RESET_ON_FORK"]},
+            "ioPriority": {"class": "IOPRIO_CLASS_IDLE"},
+            "execCPUAffinity": {"initial": "0-1", "final": "3"},
+            "user": null
+        },
+        "linux": {
+            "uidMappings": [{"hostID": 1000, "containerID": 0, "size": 1}],
+            "gidMappings": [{"hostID": 1000, "containerID": 0, "size": 1}],
+            "namespaces": [{"type": "mount"}, {"type": "pid"}, {"type": "user"},
+                           {"type": "network", "path": "/proc/1/ns/net"}],
+            "devices": [{"type": "c", "path": "/dev/fuse", "major": 10, "minor": 229,
+                         "fileMode": 438, "uid": 0, "gid": 0}],
+            "netDevices": {"eth0": {"name": "eth1"}},
+            "cgroupsPath": "/ll-box/test",
+            "maskedPaths": ["/proc/kcore"],
+            "readonlyPaths": ["/proc/sys"],
+            "mountLabel": "system_u:object_r:container_file_t:s0",
+            "rootfsPropagation": "rslave",
+            "sysctl": {"net.ipv4.ip_forward": "1", "kernel.shmmax": "4096"},
+            "timeOffsets": {"monotonic": {"secs": 10, "nanosecs": 5}},
+            "personality": {"domain": "LINUX32", "flags": []},
+            "memoryPolicy": {"mode": "MPOL_BIND", "nodes": "0-1",
+                             "flags": ["MPOL_F_STATIC_NODES"]},
+            "intelRdt": {"closID": "guaranteed", "schemata": ["L3:0=ff"],
+                         "unknown": [1.5e10, {"deep": [null, true, false]}]},
+            "resources": {
+                "devices": [{"allow": false, "access": "rwm"}],
+                "memory": {"limit": 536870912, "swappiness": 10, "disableOOMKiller": false},
+                "cpu": {"shares": 1024, "quota": -1, "period": 100000, "cpus": "0-3,6",
+                        "mems": "0", "idle": 1},
+                "pids": {"limit": 32},
+                "blockIO": {"weight": 10,
+                            "weightDevice": [{"major": 8, "minor": 0, "weight": 500}],
+                            "throttleReadBpsDevice": [{"major": 8, "minor": 0, "rate": 600}]},
+                "hugepageLimits": [{"pageSize": "2MB", "limit": 209715200}],
+                "network": {"classID": 1048577, "priorities": [{"name": "eth0", "priority": 5}]},
+                "rdma": {"mlx5_1": {"hcaHandles": 3, "hcaObjects": 10000}},
+                "unified": {"memory.high": "max"}
+            },
+            "seccomp": {
+                "defaultAction": "SCMP_ACT_ERRNO",
+                "defaultErrnoRet": 1,
+                "architectures": ["SCMP_ARCH_X86_64"],
+                "flags": ["SECCOMP_FILTER_FLAG_LOG"],
+                "syscalls": [{"names": ["getcwd", "chmod"], "action": "SCMP_ACT_ALLOW",
+                              "args": [{"index": 0, "value": 1, "valueTwo": 2,
+                                        "op": "SCMP_CMP_EQ"}]}]
+            }
+        },
+        "hooks": {
+            "prestart": [{"path": "/usr/bin/fix-mounts", "args": ["fix-mounts", "arg1"],
+                          "env": ["key1=value1"], "timeout": 5}],
+            "poststop": [{"path": "/usr/sbin/cleanup.sh"}]
+        },
+        "root": {"path": "rootfs", "readonly": true},
+        "annotations": {"com.example.key1": "value1", "com.example.key2": "value2"},
+        "unknownTopLevel": {"ignored": ["entirely"]}
+    })");
 }
 
-TEST(OCI, Util)
+TEST(OCI, NullMeansAbsent)
 {
-    EXPECT_EQ(util::format("%d %d %d\n", 1, 1, 1), "1 1 1\n");
-    EXPECT_EQ(util::format("%d %d %d\n", uint64_t(1), 1u, 1), "1 1 1\n");
+    expect_same(R"({
+        "ociVersion": "1.0.2",
+        "hostname": null,
+        "mounts": null,
+        "hooks": {"prestart": null},
+        "linux": {"rootfsPropagation": null, "namespaces": null, "resources": {"cpu": null}},
+        "root": {"path": "rootfs", "readonly": false}
+    })");
 }
 
-TEST(OCI, JSON)
+TEST(OCI, MalformedInputThrows)
 {
-    Runtime r;
+    const std::string_view cases[] = {
+        "",
+        "[]",
+        R"({"ociVersion": "1.0.2",})",
+        R"({"ociVersion": "1.0.2"} x)",
+        R"({"ociVersion": "1.0.2)",
+        R"({"ociVersion": "1.0.2", "hostname": "a\qb"})",
+        R"({"ociVersion": "1.0.2", "hostname": "\ud800"})",
+        R"({"ociVersion": "1.0.2", "hostname": 1})",
+        R"({"ociVersion": "9.0.0"})",
+        R"({"root": {"path": "rootfs"}})",
+        R"({"ociVersion": "1.0.2", "root": {"readonly": true}})",
+        R"({"ociVersion": "1.0.2", "process": {"cwd": "/", "args": [], "oomScoreAdj": 1.5}})",
+        R"({"ociVersion": "1.0.2", "process": {"cwd": "/", "args": [],
+            "user": {"uid": 4294967296, "gid": 0}}})",
+        R"({"ociVersion": "1.0.2", "process": {"cwd": "/", "args": [],
+            "rlimits": [{"type": "RLIMIT_BOGUS", "soft": 1, "hard": 1}]}})",
+        R"({"ociVersion": "1.0.2", "linux": {"namespaces": [{"type": "pid", "path": "rel"}]}})",
+        R"({"ociVersion": "1.0.2", "linux": {"intelRdt": {"closID": [1,]}}})",
+        R"({"ociVersion": "1.0.2", "linux": {"timeOffsets": {
+            "boottime": {"secs": 1, "nanosecs": 0}, "boottime": {"secs": 2, "nanosecs": 0}}}})",
+    };
 
-    r.hooks = std::nullopt;
+    for (auto content : cases) {
+        EXPECT_ANY_THROW(std::ignore = config::parse_streaming(content)) << content;
+    }
+
+    std::string deep{ minimal };
+    deep.insert(deep.size() - 1, R"(, "x": )" + std::string(1000, '[') + std::string(1000, ']'));
+    EXPECT_ANY_THROW(std::ignore = config::parse_streaming(deep));
+}
+
+TEST(OCI, ParseValidates)
+{
+    EXPECT_NO_THROW(std::ignore = oci_config::parse(std::string_view{ minimal }));
+
+    // well formed, but rejected by validate()
+    EXPECT_ANY_THROW(std::ignore = oci_config::parse(std::string_view{ R"({
+        "ociVersion": "1.0.2",
+        "root": {"path": "rootfs"},
+        "linux": {"namespaces": [{"type": "pid"}, {"type": "pid"}]}
+    })" }));
+}
+
+TEST(OCI, SysctlMustBeNamespaced)
+{
+    const auto parse = [](std::string_view linux) {
+        const auto content =
+          R"({"ociVersion": "1.0.2", "root": {"path": "rootfs"}, "linux": )" + std::string{ linux }
+          + "}";
+        std::ignore = oci_config::parse(std::string_view{ content });
+    };
 
-    nlohmann::json j(r);
+    EXPECT_NO_THROW(parse(R"({"namespaces": [{"type": "network"}, {"type": "ipc"}],
+        "sysctl": {"net.core.somaxconn": "1024", "kernel.shmmax": "4096",
+                   "fs.mqueue.msg_max": "20"}})"));
+    EXPECT_NO_THROW(parse(R"({"namespaces": [{"type": "uts"}],
+        "sysctl": {"kernel.domainname": "example.org"}})"));
 
-    EXPECT_EQ(j.at("hooks").is_null(), true);
+    // host wide keys, or keys of a namespace the container shares with the host
+    EXPECT_ANY_THROW(parse(R"({"sysctl": {"vm.swappiness": "10"}})"));
+    EXPECT_ANY_THROW(parse(R"({"namespaces": [{"type": "ipc"}],
+        "sysctl": {"net.core.somaxconn": "1024"}})"));
+    EXPECT_ANY_THROW(parse(R"({"namespaces": [{"type": "network"}],
+        "sysctl": {"kernel.shmmax": "4096"}})"));
+    EXPECT_ANY_THROW(parse(R"({"namespaces": [{"type": "network"}],
+        "sysctl": {"net..core": "1"}})"));
+    EXPECT_ANY_THROW(parse(R"({"namespaces": [{"type": "network"}],
+        "sysctl": {"net/core/somaxconn": "1"}})"));
 }
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/config.h"
+#include "linyaps_box/container.h"
+#include "linyaps_box/os/fs.h"
+#include "linyaps_box/utils/rusage.h"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+namespace utils = linyaps_box::utils;
+namespace os = linyaps_box::os;
+
+class RusageTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override
+    {
+        dir = std::filesystem::temp_directory_path()
+          / ("ll-box-rusage-" + std::to_string(::getpid()));
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    auto write(const std::string &name, std::string_view content) const -> void
+    {
+        std::ofstream ofs(dir / name);
+        ofs << content;
+    }
+
+    [[nodiscard]] auto open_dir() const -> utils::file_descriptor
+    {
+        return os::throw_if_error(
+          os::open(dir, { os::sys::open_flag::cloexec, os::sys::access_mode::read_only }));
+    }
+};
+
+auto make_rusage(long utime_us, long maxrss, long nvcsw) -> struct rusage
+{
+    struct rusage ru{ };
+    ru.ru_utime.tv_sec = utime_us / 1000000;
+    ru.ru_utime.tv_usec = utime_us % 1000000;
+    ru.ru_maxrss = maxrss;
+    ru.ru_nvcsw = nvcsw;
+    return ru;
+}
+
+} // namespace
+
+TEST_F(RusageTest, AccumulateSumsAndKeepsPeakRss)
+{
+    utils::process_usage usage;
+    utils::accumulate(usage, make_rusage(1500000, 2048, 3));
+    utils::accumulate(usage, make_rusage(700000, 1024, 4));
+
+    EXPECT_EQ(usage.processes, 2U);
+    EXPECT_EQ(usage.user_cpu.count(), 2200000);
+    EXPECT_EQ(usage.max_rss_kib, 2048);
+    EXPECT_EQ(usage.voluntary_switches, 7);
+}
+
+TEST_F(RusageTest, ReadCgroupUsage)
+{
+    write("cpu.stat", "usage_usec 1200\nuser_usec 1000\nsystem_usec 200\n");
+    write("memory.peak", "4096\n");
+
+    const auto usage = utils::read_cgroup_usage(open_dir());
+    EXPECT_EQ(usage.cpu_stat.at("usage_usec"), 1200U);
+    EXPECT_EQ(usage.cpu_stat.at("system_usec"), 200U);
+    ASSERT_TRUE(usage.memory_peak.has_value());
+    EXPECT_EQ(*usage.memory_peak, 4096U);
+}
+
+TEST_F(RusageTest, ReadCgroupUsageWithoutFiles)
+{
+    const auto usage = utils::read_cgroup_usage(open_dir());
+    EXPECT_TRUE(usage.cpu_stat.empty());
+    EXPECT_FALSE(usage.memory_peak.has_value());
+}
+
+TEST_F(RusageTest, WriteReport)
+{
+    utils::usage_report report;
+    report.exit_code = 3;
+    utils::accumulate(report.container, make_rusage(10, 512, 1));
+    report.cgroup = utils::cgroup_usage{ { { "usage_usec", 42 } }, std::nullopt };
+
+    const auto path = dir / "usage.json";
+    utils::write_usage_report(path, report);
+
+    std::ifstream ifs(path);
+    const auto json = nlohmann::json::parse(ifs);
+    EXPECT_EQ(json["exit_code"], 3);
+    EXPECT_EQ(json["container"]["max_rss_kib"], 512);
+    EXPECT_EQ(json["descendants"]["processes"], 0);
+    EXPECT_EQ(json["cgroup"]["cpu_stat"]["usage_usec"], 42);
+    EXPECT_FALSE(json["cgroup"].contains("memory_peak"));
+}
+
+// The monitor of a detached container drops the parsed config once the
+// container started, what is left of the heap must go back to the kernel.
+TEST_F(RusageTest, TrimHeapAfterSheddingConfig)
+{
+    constexpr std::int64_t bound_kib{ 4096 };
+
+    const auto bundle = dir / "bundle";
+    std::filesystem::create_directories(bundle / "rootfs");
+    {
+        auto config = nlohmann::json::parse(R"({
+            "ociVersion": "1.0.2",
+            "process": { "cwd": "/", "args": ["/bin/true"], "user": { "uid": 0, "gid": 0 } },
+            "root": { "path": "rootfs" }
+        })");
+        auto &env = config["process"]["env"];
+        for (auto i = 0; i < 100000; ++i) {
+            env.push_back(fmt::format("VARIABLE_{}=some value of the variable {}", i, i));
+        }
+        std::ofstream{ bundle / "config.json" } << config.dump();
+    }
+
+    auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // what the test runner itself left on the heap is not the monitor's
+        utils::trim_heap();
+        const auto baseline = utils::current_rss_kib();
+        if (!baseline) {
+            _exit(2);
+        }
+
+        linyaps_box::create_container_options_t options{
+            linyaps_box::cgroup_manager_t::disabled, "c", bundle, "config.json", { }
+        };
+        linyaps_box::container container{ linyaps_box::status_directory{ dir / "state" },
+                                           options };
+        // keeps the top of the heap busy, so that only trimming releases the rest
+        auto pin = std::make_unique<int>(0);
+
+        container.shed_config();
+        const auto after = utils::current_rss_kib();
+        _exit(after && *after - *baseline < bound_kib ? 0 : 1);
+    }
+
+    int status{ 0 };
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/config/parser.h"
+#include "linyaps_box/utils/sched.h"
+
+#include <sched.h>
+
+namespace {
+
+auto parse_process(std::string_view process) -> linyaps_box::oci_config::process_t
+{
+    return *linyaps_box::config::parse_streaming(
+              R"({"ociVersion": "1.0.2", "process": )" + std::string{ process } + "}")
+              .process;
+}
+
+} // namespace
+
+TEST(Sched, SchedAttr)
+{
+    const auto process = parse_process(R"({"cwd": "/", "args": ["sh"], "scheduler": {
+        "policy": "SCHED_DEADLINE", "runtime": 1000, "deadline": 2000, "period": 3000,
+        "flags": ["SCHED_FLAG_RESET_ON_FORK", "SCHED_FLAG_DL_OVERRUN"]}})");
+
+    const auto attr = linyaps_box::utils::to_sched_attr(*process.scheduler, { });
+    EXPECT_EQ(attr.size, 56U);
+    EXPECT_EQ(attr.sched_policy, 6U);
+    EXPECT_EQ(attr.sched_flags, 0x05U);
+    EXPECT_EQ(attr.sched_runtime, 1000U);
+    EXPECT_EQ(attr.sched_deadline, 2000U);
+    EXPECT_EQ(attr.sched_period, 3000U);
+}
+
+TEST(Sched, UtilClamp)
+{
+    const auto process = parse_process(R"({"cwd": "/", "args": ["sh"], "scheduler": {
+        "policy": "SCHED_OTHER", "nice": -5, "flags": ["SCHED_FLAG_UTIL_CLAMP_MAX"]}})");
+
+    auto attr = linyaps_box::utils::to_sched_attr(*process.scheduler, { });
+    EXPECT_EQ(attr.sched_policy, static_cast<std::uint32_t>(SCHED_OTHER));
+    EXPECT_EQ(attr.sched_nice, -5);
+    EXPECT_EQ(attr.sched_flags, 0x40U);
+    EXPECT_EQ(attr.sched_util_max, 1024U);
+
+    const auto clamp = linyaps_box::utils::parse_util_clamp(
+      std::unordered_map<std::string, std::string>{ { "cn.org.linyaps.runtime.sched_util_min",
+                                                      "256" },
+                                                    { "cn.org.linyaps.runtime.sched_util_max",
+                                                      "512" } });
+    attr = linyaps_box::utils::to_sched_attr(*process.scheduler, clamp);
+    EXPECT_EQ(attr.sched_flags, 0x60U);
+    EXPECT_EQ(attr.sched_util_min, 256U);
+    EXPECT_EQ(attr.sched_util_max, 512U);
+
+    EXPECT_THROW(std::ignore = linyaps_box::utils::parse_util_clamp(
+                   std::unordered_map<std::string, std::string>{
+                     { "cn.org.linyaps.runtime.sched_util_min", "2048" } }),
+                 std::invalid_argument);
+}
+
+TEST(Sched, IoPriority)
+{
+    auto process = parse_process(R"({"cwd": "/", "args": ["sh"],
+        "ioPriority": {"class": "IOPRIO_CLASS_BE", "priority": 4}})");
+    EXPECT_EQ(linyaps_box::utils::to_ioprio(*process.io_priority), (2 << 13) | 4);
+
+    process = parse_process(R"({"cwd": "/", "args": ["sh"],
+        "ioPriority": {"class": "IOPRIO_CLASS_IDLE"}})");
+    EXPECT_EQ(linyaps_box::utils::to_ioprio(*process.io_priority), 3 << 13);
+}
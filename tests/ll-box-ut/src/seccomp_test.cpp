@@ -1,64 +1,393 @@
-/*
- * SPDX-FileCopyrightText: 2022 UnionTech Software Technology Co., Ltd.
- *
- * SPDX-License-Identifier: LGPL-3.0-or-later
- */
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
 
-#if LINYAPS_BOX_ENABLE_SECCOMP
+#include <gtest/gtest.h>
 
-#  include <gtest/gtest.h>
+#include "linyaps_box/config/parser.h"
+#include "linyaps_box/security/seccomp.h"
 
-#  include "container/seccomp.h"
-#  include "util/oci_runtime.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
 
-#  include <seccomp.h>
-#  include <sys/klog.h>
+#include <fcntl.h>
+#include <linux/audit.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
-#  include <climits>
+namespace {
 
-TEST(OCI, libseccomp)
+namespace security = linyaps_box::security;
+using seccomp_t = linyaps_box::oci_config::linux_t::seccomp_t;
+
+auto parse_seccomp(std::string_view seccomp) -> seccomp_t
 {
-    auto seccompArch = seccomp_arch_resolve_name("x86_64");
-    EXPECT_EQ(seccompArch, SCMP_ARCH_X86_64);
+    return *linyaps_box::config::parse_streaming(
+              R"({"ociVersion": "1.0.2", "linux": {"seccomp": )" + std::string{ seccomp } + "}}")
+              .linux->seccomp;
 }
 
-TEST(OCI, Seccomp)
+// "nr<N>" stands for syscall N on every architecture.
+auto test_resolver(std::size_t *calls = nullptr) -> security::syscall_resolver
 {
-    const size_t bufSize = 1024;
-    char buf[bufSize];
+    return { "test",
+             [calls](std::string_view name, std::uint32_t) -> std::optional<std::uint32_t> {
+                 if (calls != nullptr) {
+                     ++*calls;
+                 }
+                 if (name.rfind("nr", 0) != 0) {
+                     return std::nullopt;
+                 }
+                 return static_cast<std::uint32_t>(std::stoul(std::string{ name.substr(2) }));
+             } };
+}
 
-    auto filepath = "data/demo/config-seccomp.json";
-    auto r = linglong::fromFile(filepath);
+// Just enough of a classic BPF interpreter for the programs of the compiler.
+auto run(const std::vector<sock_filter> &program, const seccomp_data &data) -> std::uint32_t
+{
+    std::uint32_t acc{ 0 };
+    for (std::size_t pc = 0; pc < program.size(); ++pc) {
+        const auto &insn = program[pc];
+        switch (insn.code) {
+        case BPF_LD | BPF_W | BPF_ABS:
+            std::memcpy(&acc, reinterpret_cast<const std::byte *>(&data) + insn.k, sizeof(acc));
+            break;
+        case BPF_ALU | BPF_AND | BPF_K:
+            acc &= insn.k;
+            break;
+        case BPF_JMP | BPF_JA:
+            pc += insn.k;
+            break;
+        case BPF_JMP | BPF_JEQ | BPF_K:
+            pc += acc == insn.k ? insn.jt : insn.jf;
+            break;
+        case BPF_JMP | BPF_JGT | BPF_K:
+            pc += acc > insn.k ? insn.jt : insn.jf;
+            break;
+        case BPF_JMP | BPF_JGE | BPF_K:
+            pc += acc >= insn.k ? insn.jt : insn.jf;
+            break;
+        case BPF_RET | BPF_K:
+            return insn.k;
+        default:
+            ADD_FAILURE() << "unexpected instruction " << insn.code;
+            return 0;
+        }
+    }
 
-    EXPECT_EQ(ConfigSeccomp(r.linux.seccomp), 0);
+    ADD_FAILURE() << "program ran off its end";
+    return 0;
+}
+
+auto call(const std::vector<sock_filter> &program,
+          std::uint32_t arch,
+          std::uint32_t nr,
+          std::uint64_t arg0 = 0,
+          std::uint64_t arg1 = 0) -> std::uint32_t
+{
+    seccomp_data data{ };
+    data.nr = static_cast<int>(nr);
+    data.arch = arch;
+    data.args[0] = arg0;
+    data.args[1] = arg1;
+    return run(program, data);
+}
 
-    getcwd(buf, bufSize);
-    EXPECT_EQ(errno, EPERM);
+// The first instruction after loading seccomp_data.arch checks the native one.
+auto native_arch(const security::seccomp_filter &filter) -> std::uint32_t
+{
+    return filter.program.at(1).k;
+}
 
-    r.linux.seccomp->defaultAction = "INVALID_ACTION";
-    EXPECT_EQ(ConfigSeccomp(r.linux.seccomp), -1);
+constexpr auto errno_ret(std::uint32_t e) -> std::uint32_t
+{
+    return SECCOMP_RET_ERRNO | e;
 }
 
-TEST(OCI, SeccompDefault)
+} // namespace
+
+TEST(Seccomp, TreeMatchesLinear)
 {
-    const size_t bufSize = 1024;
-    char buf[bufSize];
+    const auto seccomp = parse_seccomp(R"({
+        "defaultAction": "SCMP_ACT_ERRNO", "defaultErrnoRet": 38,
+        "architectures": ["SCMP_ARCH_X86"],
+        "syscalls": [
+            {"names": ["nr0", "nr1", "nr2", "nr3", "nr5", "nr6", "nr40", "nr900"],
+             "action": "SCMP_ACT_ALLOW"},
+            {"names": ["nr7"], "action": "SCMP_ACT_ERRNO", "errnoRet": 1},
+            {"names": ["nr8"], "action": "SCMP_ACT_ALLOW",
+             "args": [{"index": 0, "value": 4294967297, "op": "SCMP_CMP_GE"}]},
+            {"names": ["nr8"], "action": "SCMP_ACT_KILL_PROCESS"},
+            {"names": ["nr9"], "action": "SCMP_ACT_ERRNO", "errnoRet": 38},
+            {"names": ["unknown"], "action": "SCMP_ACT_ALLOW"}
+        ]})");
 
-    auto filepath = "data/demo/config-seccomp-default.json";
-    auto r = linglong::fromFile(filepath);
+    const auto tree = security::compile_seccomp(seccomp, test_resolver());
+    const auto linear =
+      security::compile_seccomp(seccomp, test_resolver(), security::seccomp_layout::linear);
+    const auto native = native_arch(tree);
 
-    EXPECT_EQ(ConfigSeccomp(r.linux.seccomp), 0);
+    for (auto arch : { native, static_cast<std::uint32_t>(AUDIT_ARCH_I386), 0U }) {
+        for (std::uint32_t nr = 0; nr < 1000; ++nr) {
+            for (std::uint64_t arg : { 0ULL, 1ULL << 32, ~0ULL }) {
+                ASSERT_EQ(call(tree.program, arch, nr, arg), call(linear.program, arch, nr, arg))
+                  << "arch " << arch << " nr " << nr << " arg " << arg;
+            }
+        }
+    }
 
-    klogctl(2, buf, bufSize);
-    EXPECT_EQ(errno, EPERM);
+    EXPECT_EQ(call(tree.program, native, 0), SECCOMP_RET_ALLOW);
+    EXPECT_EQ(call(tree.program, native, 4), errno_ret(38));
+    EXPECT_EQ(call(tree.program, native, 7), errno_ret(1));
+    EXPECT_EQ(call(tree.program, native, 9), errno_ret(38));
+    EXPECT_EQ(call(tree.program, native, 900), SECCOMP_RET_ALLOW);
+    EXPECT_EQ(call(tree.program, native, 0xffffffffU), errno_ret(38));
+    EXPECT_EQ(call(tree.program, AUDIT_ARCH_I386, 40), SECCOMP_RET_ALLOW);
+    EXPECT_EQ(call(tree.program, 0, 0), SECCOMP_RET_KILL_PROCESS);
 
-    // reset seccomp
-    filepath = "data/demo/config-seccomp.json";
-    r = linglong::fromFile(filepath);
+    // a 64 bit argument on the native arch, only the low word on i386
+    if (native != AUDIT_ARCH_I386) {
+        EXPECT_EQ(call(tree.program, native, 8, 2ULL << 32), SECCOMP_RET_ALLOW);
+        EXPECT_EQ(call(tree.program, native, 8, 0xffffffffULL), SECCOMP_RET_KILL_PROCESS);
+    }
+    EXPECT_EQ(call(tree.program, AUDIT_ARCH_I386, 8, 1ULL << 32), SECCOMP_RET_KILL_PROCESS);
+    EXPECT_EQ(call(tree.program, AUDIT_ARCH_I386, 8, 0xffffffffULL), SECCOMP_RET_ALLOW);
 
-    EXPECT_EQ(ConfigSeccomp(r.linux.seccomp), 0);
+    // a long allow list collapses into a few ranges
+    EXPECT_LT(tree.program.size(), linear.program.size());
+}
+
+TEST(Seccomp, ArgumentComparisons)
+{
+    const std::uint64_t value = 0x100000005ULL;
+    const std::uint64_t args[] = { 0,         4,     5,      6,         1ULL << 32,
+                                   value - 1, value, value + 1, 2ULL << 32, ~0ULL,
+                                   0x5ULL,    0x200000005ULL };
+
+    const std::pair<std::string_view, bool (*)(std::uint64_t)> ops[] = {
+        { "SCMP_CMP_EQ", [](std::uint64_t a) { return a == value; } },
+        { "SCMP_CMP_NE", [](std::uint64_t a) { return a != value; } },
+        { "SCMP_CMP_LT", [](std::uint64_t a) { return a < value; } },
+        { "SCMP_CMP_LE", [](std::uint64_t a) { return a <= value; } },
+        { "SCMP_CMP_GT", [](std::uint64_t a) { return a > value; } },
+        { "SCMP_CMP_GE", [](std::uint64_t a) { return a >= value; } },
+        { "SCMP_CMP_MASKED_EQ", [](std::uint64_t a) { return (a & value) == 5; } },
+    };
+
+    for (const auto &[op, expected] : ops) {
+        const auto seccomp = parse_seccomp(
+          R"({"defaultAction": "SCMP_ACT_ALLOW", "syscalls": [{"names": ["nr1"],
+            "action": "SCMP_ACT_ERRNO", "args": [{"index": 1, "value": )"
+          + std::to_string(value) + R"(, "valueTwo": 5, "op": ")" + std::string{ op }
+          + R"("}]}]})");
+
+        for (auto layout : { security::seccomp_layout::tree, security::seccomp_layout::linear }) {
+            const auto filter = security::compile_seccomp(seccomp, test_resolver(), layout);
+            const auto native = native_arch(filter);
+            if (native == AUDIT_ARCH_I386) {
+                GTEST_SKIP() << "arguments are 32 bit wide";
+            }
+
+            for (auto arg : args) {
+                EXPECT_EQ(call(filter.program, native, 1, 0, arg),
+                          expected(arg) ? errno_ret(EPERM) : SECCOMP_RET_ALLOW)
+                  << op << " " << arg;
+            }
+        }
+    }
+}
+
+TEST(Seccomp, RepeatedArgumentIsOr)
+{
+    const auto seccomp = parse_seccomp(R"({"defaultAction": "SCMP_ACT_ALLOW",
+        "syscalls": [{"names": ["nr1"], "action": "SCMP_ACT_ERRNO", "args": [
+            {"index": 0, "value": 1, "op": "SCMP_CMP_EQ"},
+            {"index": 0, "value": 2, "op": "SCMP_CMP_EQ"}]},
+        {"names": ["nr2"], "action": "SCMP_ACT_ERRNO", "args": [
+            {"index": 0, "value": 1, "op": "SCMP_CMP_EQ"},
+            {"index": 1, "value": 2, "op": "SCMP_CMP_EQ"}]}]})");
+
+    const auto filter = security::compile_seccomp(seccomp, test_resolver());
+    const auto native = native_arch(filter);
+
+    EXPECT_EQ(call(filter.program, native, 1, 1), errno_ret(EPERM));
+    EXPECT_EQ(call(filter.program, native, 1, 2), errno_ret(EPERM));
+    EXPECT_EQ(call(filter.program, native, 1, 3), SECCOMP_RET_ALLOW);
+
+    EXPECT_EQ(call(filter.program, native, 2, 1, 2), errno_ret(EPERM));
+    EXPECT_EQ(call(filter.program, native, 2, 1, 1), SECCOMP_RET_ALLOW);
+    EXPECT_EQ(call(filter.program, native, 2, 2, 2), SECCOMP_RET_ALLOW);
+}
+
+#ifdef __x86_64__
+TEST(Seccomp, X32SharesTheX8664Block)
+{
+    const auto native_only = security::compile_seccomp(
+      parse_seccomp(R"({"defaultAction": "SCMP_ACT_ALLOW"})"), test_resolver());
+    EXPECT_EQ(call(native_only.program, AUDIT_ARCH_X86_64, 0x40000000U), SECCOMP_RET_KILL_PROCESS);
+    EXPECT_EQ(call(native_only.program, AUDIT_ARCH_X86_64, 1), SECCOMP_RET_ALLOW);
 
-    klogctl(2, buf, bufSize);
-    EXPECT_EQ(errno, EPERM);
+    const auto with_x32 = security::compile_seccomp(
+      parse_seccomp(R"({"defaultAction": "SCMP_ACT_ALLOW", "architectures": ["SCMP_ARCH_X32"],
+        "syscalls": [{"names": ["nr1"], "action": "SCMP_ACT_ERRNO"}]})"),
+      test_resolver());
+    EXPECT_EQ(call(with_x32.program, AUDIT_ARCH_X86_64, 1), errno_ret(EPERM));
+    EXPECT_EQ(call(with_x32.program, AUDIT_ARCH_X86_64, 0x40000001U), errno_ret(EPERM));
+    EXPECT_EQ(call(with_x32.program, AUDIT_ARCH_X86_64, 0x40000002U), SECCOMP_RET_ALLOW);
 }
 #endif
+
+TEST(Seccomp, CacheSkipsCompilation)
+{
+    const auto dir = std::filesystem::temp_directory_path()
+      / ("ll-box-seccomp-cache-" + std::to_string(::getpid()));
+    std::filesystem::remove_all(dir);
+
+    const auto seccomp = parse_seccomp(R"({"defaultAction": "SCMP_ACT_ALLOW",
+        "flags": ["SECCOMP_FILTER_FLAG_LOG"],
+        "syscalls": [{"names": ["nr1", "nr2"], "action": "SCMP_ACT_ERRNO"}]})");
+
+    std::size_t calls{ 0 };
+    const auto first = security::load_or_compile_seccomp(seccomp, test_resolver(&calls), dir);
+    EXPECT_GT(calls, 0U);
+
+    calls = 0;
+    const auto second = security::load_or_compile_seccomp(seccomp, test_resolver(&calls), dir);
+    EXPECT_EQ(calls, 0U);
+    EXPECT_EQ(second.flags, first.flags);
+    ASSERT_EQ(second.program.size(), first.program.size());
+    EXPECT_EQ(std::memcmp(second.program.data(),
+                          first.program.data(),
+                          first.program.size() * sizeof(sock_filter)),
+              0);
+
+    // a different section must not hit the cached program
+    auto changed = seccomp;
+    changed.syscalls->front().names.pop_back();
+    const auto third = security::load_or_compile_seccomp(changed, test_resolver(&calls), dir);
+    EXPECT_GT(calls, 0U);
+    EXPECT_EQ(call(third.program, native_arch(third), 2), SECCOMP_RET_ALLOW);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(Seccomp, InstallFilter)
+{
+    const auto seccomp = parse_seccomp(R"({"defaultAction": "SCMP_ACT_ALLOW", "syscalls": [
+        {"names": ["nr)" + std::to_string(SYS_getppid)
+                                       + R"("], "action": "SCMP_ACT_ERRNO", "errnoRet": 42}]})");
+    const auto filter = security::compile_seccomp(seccomp, test_resolver());
+
+    const auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        if (::prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0) {
+            _exit(2);
+        }
+        try {
+            security::install_seccomp(filter);
+        } catch (...) {
+            _exit(3);
+        }
+
+        const auto ret = ::syscall(SYS_getppid);
+        _exit(ret == -1 && errno == 42 && ::syscall(SYS_getpid) == ::getpid() ? 0 : 1);
+    }
+
+    int status{ 0 };
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+// Run with --gtest_also_run_disabled_tests. Compares the cost of a syscall heavy
+// loop under no filter, the linear filter and the tree, with an allow list
+// shaped like the default profile of container engines.
+TEST(Seccomp, DISABLED_BenchmarkTreeVsLinear)
+{
+    constexpr long denied[] = {
+        SYS_acct,         SYS_add_key,       SYS_bpf,          SYS_delete_module,
+        SYS_init_module,  SYS_kexec_load,    SYS_keyctl,       SYS_mount,
+        SYS_name_to_handle_at, SYS_open_by_handle_at, SYS_perf_event_open,
+        SYS_pivot_root,   SYS_ptrace,        SYS_quotactl,     SYS_reboot,
+        SYS_request_key,  SYS_setns,         SYS_swapoff,      SYS_swapon,
+        SYS_syslog,       SYS_umount2,       SYS_unshare,      SYS_userfaultfd,
+        SYS_vhangup,
+    };
+
+    std::string names;
+    for (long nr = 0; nr < 460; ++nr) {
+        if (std::find(std::begin(denied), std::end(denied), nr) != std::end(denied)) {
+            continue;
+        }
+        names += (names.empty() ? "\"nr" : ", \"nr") + std::to_string(nr) + "\"";
+    }
+    const auto seccomp = parse_seccomp(R"({"defaultAction": "SCMP_ACT_ERRNO", "syscalls": [
+        {"names": [)" + names + R"(], "action": "SCMP_ACT_ALLOW"}]})");
+
+    const auto measure = [](const security::seccomp_filter *filter) -> double {
+        constexpr int rounds = 1000000;
+
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return -1;
+        }
+
+        const auto pid = ::fork();
+        if (pid == 0) {
+            ::close(fds[0]);
+            if (filter != nullptr) {
+                ::prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0);
+                security::install_seccomp(*filter);
+            }
+
+            const auto zero = ::open("/dev/zero", O_RDONLY | O_CLOEXEC);
+            char byte{ };
+            struct stat st{ };
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < rounds; ++i) {
+                ::syscall(SYS_getppid);
+                std::ignore = ::read(zero, &byte, 1);
+                ::fstat(zero, &st);
+            }
+            const auto ns = std::chrono::duration<double, std::nano>(
+                              std::chrono::steady_clock::now() - start)
+                              .count()
+              / (rounds * 3.0);
+            std::ignore = ::write(fds[1], &ns, sizeof(ns));
+            _exit(0);
+        }
+
+        ::close(fds[1]);
+        double ns{ -1 };
+        std::ignore = ::read(fds[0], &ns, sizeof(ns));
+        ::close(fds[0]);
+        ::waitpid(pid, nullptr, 0);
+        return ns;
+    };
+
+    const auto tree = security::compile_seccomp(seccomp, test_resolver());
+    const auto linear =
+      security::compile_seccomp(seccomp, test_resolver(), security::seccomp_layout::linear);
+
+    const auto none_ns = measure(nullptr);
+    const auto linear_ns = measure(&linear);
+    const auto tree_ns = measure(&tree);
+
+    std::cout << "no filter: " << none_ns << " ns/syscall\n"
+              << "linear (" << linear.program.size() << " insns): " << linear_ns
+              << " ns/syscall\n"
+              << "tree (" << tree.program.size() << " insns): " << tree_ns << " ns/syscall\n";
+
+    EXPECT_GT(none_ns, 0);
+    EXPECT_LT(tree_ns, linear_ns);
+}
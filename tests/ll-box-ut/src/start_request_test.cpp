@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/container_ref.h"
+
+#include <array>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+using linyaps_box::start_container_option;
+using linyaps_box::utils::file_descriptor;
+
+auto make_pipe() -> std::pair<file_descriptor, file_descriptor>
+{
+    std::array<int, 2> fds{ };
+    EXPECT_EQ(::pipe2(fds.data(), O_CLOEXEC), 0);
+    return { file_descriptor{ fds[0] }, file_descriptor{ fds[1] } };
+}
+
+} // namespace
+
+TEST(StartRequest, RoundTrip)
+{
+    auto [reader, writer] = make_pipe();
+
+    start_container_option option;
+    option.args = { "/usr/bin/app", "--flag" };
+    option.env = std::vector<std::string>{ "PATH=/usr/bin", "LANG=C" };
+    option.cwd = "/home/user";
+    linyaps_box::write_start_request(writer.ref(), option);
+    linyaps_box::write_start_request(writer.ref(), { });
+
+    const auto actual = linyaps_box::read_start_request(reader.ref());
+    EXPECT_EQ(actual.args, option.args);
+    EXPECT_EQ(actual.env, option.env);
+    EXPECT_EQ(actual.cwd, option.cwd);
+
+    const auto empty = linyaps_box::read_start_request(reader.ref());
+    EXPECT_TRUE(empty.args.empty());
+    EXPECT_FALSE(empty.env.has_value());
+    EXPECT_FALSE(empty.cwd.has_value());
+}
+
+TEST(StartRequest, TruncatedRequestThrows)
+{
+    auto [reader, writer] = make_pipe();
+
+    const std::uint32_t size{ 16 };
+    ASSERT_EQ(::write(writer.get(), &size, sizeof(size)), sizeof(size));
+    ASSERT_EQ(::write(writer.get(), "{}", 2), 2);
+    writer = file_descriptor{ };
+
+    EXPECT_THROW(std::ignore = linyaps_box::read_start_request(reader.ref()), std::runtime_error);
+}
+
+TEST(StartRequest, OversizedRequestThrows)
+{
+    auto [reader, writer] = make_pipe();
+
+    const std::uint32_t size{ 1U << 30U };
+    ASSERT_EQ(::write(writer.get(), &size, sizeof(size)), sizeof(size));
+
+    EXPECT_THROW(std::ignore = linyaps_box::read_start_request(reader.ref()), std::runtime_error);
+}
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/supervisor.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using linyaps_box::child_exit;
+using linyaps_box::supervised_run_request;
+using linyaps_box::infra::unix_socket;
+
+auto make_pair() -> std::pair<unix_socket, unix_socket>
+{
+    return unix_socket::create_pair(linyaps_box::os::sys::socket_type::seqpacket,
+                                    linyaps_box::os::sys::socket_flag::cloexec);
+}
+
+auto pids(const std::vector<child_exit> &exits) -> std::vector<pid_t>
+{
+    std::vector<pid_t> ret;
+    for (const auto &e : exits) {
+        ret.push_back(e.pid);
+    }
+    return ret;
+}
+
+} // namespace
+
+TEST(SupervisedRunRequest, RoundTrip)
+{
+    supervised_run_request request;
+    request.id = "c1";
+    request.bundle = "/run/bundle";
+    request.config = "/run/bundle/config.json";
+    request.console_socket = "/run/console.sock";
+    request.startup_timing = "/run/timing.json";
+    request.preserve_fds = 2;
+    request.detach = true;
+
+    auto parsed = nlohmann::json::parse(nlohmann::json(request).dump())
+                    .get<supervised_run_request>();
+    EXPECT_EQ(parsed.id, request.id);
+    EXPECT_EQ(parsed.bundle, request.bundle);
+    EXPECT_EQ(parsed.config, request.config);
+    EXPECT_EQ(parsed.console_socket, request.console_socket);
+    EXPECT_EQ(parsed.startup_timing, request.startup_timing);
+    EXPECT_EQ(parsed.preserve_fds, 2);
+    EXPECT_TRUE(parsed.detach);
+}
+
+TEST(SupervisedRunRequest, OptionalPathsStayUnset)
+{
+    supervised_run_request request;
+    request.id = "c1";
+    request.bundle = "/run/bundle";
+    request.config = "/run/bundle/config.json";
+
+    const nlohmann::json j = request;
+    EXPECT_FALSE(j.contains("console_socket"));
+    EXPECT_FALSE(j.contains("startup_timing"));
+
+    auto parsed = j.get<supervised_run_request>();
+    EXPECT_FALSE(parsed.console_socket);
+    EXPECT_FALSE(parsed.startup_timing);
+    EXPECT_FALSE(parsed.detach);
+
+    EXPECT_THROW(nlohmann::json({ { "id", "c1" } }).get<supervised_run_request>(),
+                 nlohmann::json::exception);
+}
+
+TEST(SupervisorMessage, WithFds)
+{
+    auto [a, b] = make_pair();
+
+    std::array<int, 2> pipe_fds{ };
+    ASSERT_EQ(::pipe(pipe_fds.data()), 0);
+    linyaps_box::utils::file_descriptor read_end{ pipe_fds[0] };
+    linyaps_box::utils::file_descriptor write_end{ pipe_fds[1] };
+
+    const std::array<linyaps_box::utils::file_descriptor_ref, 1> fds{ write_end.ref() };
+    ASSERT_TRUE(linyaps_box::send_supervisor_message(a, { { "pid", 42 } }, fds));
+    write_end.close();
+
+    std::vector<std::byte> buffer;
+    auto msg = linyaps_box::recv_supervisor_message(b, buffer);
+    ASSERT_TRUE(msg);
+    EXPECT_EQ(msg->body.at("pid"), 42);
+    ASSERT_EQ(msg->fds.size(), 1U);
+
+    // the received fd is the write end of the same pipe
+    const char ch{ 'x' };
+    ASSERT_EQ(::write(msg->fds.front().get(), &ch, 1), 1);
+    char got{ };
+    ASSERT_EQ(::read(read_end.get(), &got, 1), 1);
+    EXPECT_EQ(got, 'x');
+}
+
+TEST(SupervisorMessage, HangUp)
+{
+    auto [a, b] = make_pair();
+    ASSERT_TRUE(linyaps_box::send_supervisor_message(a, { { "event", "started" } }));
+    a.close();
+
+    std::vector<std::byte> buffer;
+    auto msg = linyaps_box::recv_supervisor_message(b, buffer);
+    ASSERT_TRUE(msg);
+    EXPECT_EQ(msg->body.at("event"), "started");
+    EXPECT_TRUE(msg->fds.empty());
+
+    msg = linyaps_box::recv_supervisor_message(b, buffer);
+    ASSERT_TRUE(msg);
+    EXPECT_TRUE(msg->body.is_null());
+}
+
+TEST(SupervisorMessage, PeerOfSameUserIsTrusted)
+{
+    auto [a, b] = make_pair();
+    EXPECT_TRUE(a.peer_is_trusted());
+    EXPECT_TRUE(b.peer_is_trusted());
+}
+
+TEST(SupervisorReap, WorkersFirst)
+{
+    // a container, a process it left behind, then the worker that handed it over
+    std::vector<child_exit> exits{ { 200, 0 }, { 300, 0 }, { 100, 0 }, { 400, 0 } };
+    auto is_worker = [](pid_t pid) {
+        return pid == 100 || pid == 400;
+    };
+
+    EXPECT_EQ(pids(linyaps_box::workers_first(exits, is_worker)),
+              (std::vector<pid_t>{ 100, 400, 200, 300 }));
+    EXPECT_EQ(pids(linyaps_box::workers_first({ }, is_worker)), std::vector<pid_t>{ });
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "linyaps_box/utils/timing.h"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+namespace {
+
+namespace utils = linyaps_box::utils;
+
+class TimingTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path out;
+
+    void SetUp() override
+    {
+        auto &recorder = utils::phase_recorder::instance();
+        recorder.enable();
+        recorder.rebind(utils::phase_origin::runtime);
+
+        out = std::filesystem::temp_directory_path()
+          / ("ll-box-timing-" + std::to_string(::getpid()) + ".json");
+    }
+
+    void TearDown() override
+    {
+        auto &recorder = utils::phase_recorder::instance();
+        recorder.rebind(utils::phase_origin::runtime);
+
+        std::error_code ec;
+        std::filesystem::remove(out, ec);
+    }
+
+    [[nodiscard]] auto load() const -> nlohmann::json
+    {
+        std::ifstream ifs(out);
+        return nlohmann::json::parse(ifs);
+    }
+};
+
+} // namespace
+
+TEST_F(TimingTest, ScopeRecordsNestedPhases)
+{
+    {
+        const utils::phase_scope outer{ "outer" };
+        const utils::phase_scope inner{ "inner", "detail" };
+    }
+
+    auto records = utils::phase_recorder::instance().records();
+    ASSERT_EQ(records.size(), 2U);
+
+    // inner is destroyed first
+    EXPECT_EQ(records[0].name, "inner");
+    EXPECT_EQ(records[0].detail, "detail");
+    EXPECT_EQ(records[1].name, "outer");
+    EXPECT_LE(records[1].begin, records[0].begin);
+    EXPECT_GE(records[1].end, records[0].end);
+    EXPECT_EQ(records[1].origin, utils::phase_origin::runtime);
+}
+
+TEST_F(TimingTest, MergeAndTake)
+{
+    auto &recorder = utils::phase_recorder::instance();
+    recorder.merge({ { "mount",
+                       "/proc",
+                       std::chrono::nanoseconds{ 1 },
+                       std::chrono::nanoseconds{ 2 },
+                       utils::phase_origin::container } });
+    ASSERT_EQ(recorder.records().size(), 1U);
+    EXPECT_EQ(recorder.records()[0].origin, utils::phase_origin::container);
+
+    auto taken = recorder.take();
+    EXPECT_EQ(taken.size(), 1U);
+    EXPECT_TRUE(recorder.records().empty());
+}
+
+TEST_F(TimingTest, PhaseReport)
+{
+    auto &recorder = utils::phase_recorder::instance();
+    const auto epoch = recorder.epoch();
+    recorder.record("clone",
+                    "",
+                    epoch + std::chrono::nanoseconds{ 10 },
+                    epoch + std::chrono::nanoseconds{ 30 });
+    recorder.record("parse_config", "", epoch, epoch + std::chrono::nanoseconds{ 10 });
+
+    utils::write_phase_report(out, recorder);
+    auto report = load();
+
+    EXPECT_EQ(report["total_ns"], 30);
+    ASSERT_EQ(report["phases"].size(), 2U);
+    EXPECT_EQ(report["phases"][0]["name"], "parse_config");
+    EXPECT_EQ(report["phases"][1]["name"], "clone");
+    EXPECT_EQ(report["phases"][1]["start_ns"], 10);
+    EXPECT_EQ(report["phases"][1]["duration_ns"], 20);
+    EXPECT_EQ(report["phases"][1]["process"], "runtime");
+}
+
+TEST_F(TimingTest, TraceEvents)
+{
+    auto &recorder = utils::phase_recorder::instance();
+    const auto epoch = recorder.epoch();
+    recorder.record("do_mounts", "", epoch, epoch + std::chrono::microseconds{ 5 });
+    recorder.merge({ { "mount",
+                       "/proc",
+                       epoch + std::chrono::microseconds{ 1 },
+                       epoch + std::chrono::microseconds{ 2 },
+                       utils::phase_origin::container } });
+
+    utils::write_trace_events(out, recorder);
+    auto trace = load();
+
+    const auto &events = trace["traceEvents"];
+    // two process_name metadata events followed by the spans
+    ASSERT_EQ(events.size(), 4U);
+    EXPECT_EQ(events[0]["ph"], "M");
+    EXPECT_EQ(events[1]["ph"], "M");
+
+    EXPECT_EQ(events[2]["name"], "do_mounts");
+    EXPECT_EQ(events[2]["ph"], "X");
+    EXPECT_DOUBLE_EQ(events[2]["dur"].get<double>(), 5.0);
+
+    EXPECT_EQ(events[3]["name"], "mount");
+    EXPECT_EQ(events[3]["args"]["detail"], "/proc");
+    EXPECT_DOUBLE_EQ(events[3]["ts"].get<double>(), 1.0);
+    EXPECT_NE(events[3]["pid"], events[2]["pid"]);
+}